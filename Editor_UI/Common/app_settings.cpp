@@ -30,10 +30,20 @@ void ApplicationLoadSettings(AppSettings &settings)
                 settings.useVSync = j["use_vsync"].get<bool>();
             if (j.contains("show_fps"))
                 settings.showFPS = j["show_fps"].get<bool>();
+            if (j.contains("show_node_cost"))
+                settings.showNodeCost = j["show_node_cost"].get<bool>();
             if (j.contains("log_level"))
                 settings.logLevel = j["log_level"].get<int>();
             if (j.contains("buffer_count"))
                 settings.flowBufferCount = j["buffer_count"].get<int>();
+            if (j.contains("buffer_auto_tune"))
+                settings.flowBufferAutoTune = j["buffer_auto_tune"].get<bool>();
+            if (j.contains("target_fps"))
+                settings.flowTargetFps = j["target_fps"].get<float>();
+            if (j.contains("tick_mode"))
+                settings.flowTickMode = j["tick_mode"].get<int>();
+            if (j.contains("tick_rate"))
+                settings.flowTickRate = j["tick_rate"].get<float>();
         }
         catch (const std::exception &e) {
             LOG_ERROR("Error Loading Application Settings");
@@ -62,6 +72,9 @@ void ApplicationSaveSettings(const AppSettings &settings)
     if (settings.showFPS)
         j["show_fps"] = settings.showFPS;
 
+    if (settings.showNodeCost)
+        j["show_node_cost"] = settings.showNodeCost;
+
     if (settings.logLevel)
         j["log_level"] = settings.logLevel;
 
@@ -71,6 +84,16 @@ void ApplicationSaveSettings(const AppSettings &settings)
     if (settings.flowBufferCount > 1)
         j["buffer_count"] = settings.flowBufferCount;
 
+    if (settings.flowBufferAutoTune) {
+        j["buffer_auto_tune"] = settings.flowBufferAutoTune;
+        j["target_fps"] = settings.flowTargetFps;
+    }
+
+    if (settings.flowTickMode) {
+        j["tick_mode"] = settings.flowTickMode;
+        j["tick_rate"] = settings.flowTickRate;
+    }
+
     if (!j.empty()) {
         std::ofstream o(settings.configPath);
         o << std::setw(4) << j << std::endl;
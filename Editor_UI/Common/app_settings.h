@@ -18,8 +18,13 @@ struct AppSettings
     int recentListSize;
     std::deque<std::string> recentFiles;
     bool showFPS;
+    bool showNodeCost;
     bool useVSync;
     int flowBufferCount;
+    bool flowBufferAutoTune;
+    float flowTargetFps;
+    int flowTickMode;
+    float flowTickRate;
     int logLevel;
 };
 
@@ -13,6 +13,7 @@
 #endif
 
 #include "FlowLogger.hpp"
+#include "Frame_Pool.hpp"
 
 using namespace TCLAP;
 
@@ -69,6 +70,23 @@ void ApplicationSettingsDialog(AppSettings &settings, bool &windowState)
         if (settings.flowBufferCount < 1)
             settings.flowBufferCount = 1;
     }
+    ImGui::Checkbox("Auto-Tune Buffer Count", &settings.flowBufferAutoTune);
+    if (settings.flowBufferAutoTune) {
+        ImGui::SetNextItemWidth(80);
+        if (ImGui::InputFloat("Target FPS", &settings.flowTargetFps, 0.0f, 0.0f, "%.1f")) {
+            if (settings.flowTargetFps < 1.0f)
+                settings.flowTargetFps = 1.0f;
+        }
+    }
+    ImGui::SetNextItemWidth(160);
+    ImGui::Combo("Flow Tick Mode", &settings.flowTickMode, "Free Running\0Clocked\0Source Driven\0\0");
+    if (settings.flowTickMode == (int)DSPatch::Circuit::AutoTickMode::Clocked) {
+        ImGui::SetNextItemWidth(80);
+        if (ImGui::InputFloat("Flow Tick Rate (Hz)", &settings.flowTickRate, 0.0f, 0.0f, "%.1f")) {
+            if (settings.flowTickRate < 1.0f)
+                settings.flowTickRate = 1.0f;
+        }
+    }
     if (ImGui::Checkbox("Use VSync", &settings.useVSync)) {
         if (settings.useVSync)
             glfwSwapInterval(1);
@@ -76,6 +94,7 @@ void ApplicationSettingsDialog(AppSettings &settings, bool &windowState)
             glfwSwapInterval(0);
     }
     ImGui::Checkbox("Show FPS", &settings.showFPS);
+    ImGui::Checkbox("Show Node Cost Overlay", &settings.showNodeCost);
     ImGui::Separator();
     ImGui::Combo("Log Level",&settings.logLevel,"debug\0info\0warnning\0off\0\0");
     if (FlowCV::FlowLogger::getLevel() != settings.logLevel) {
@@ -164,7 +183,10 @@ std::string SaveFlowFile(ImGuiWrapper &imgui, FlowCV::FlowCV_Manager &flowMan, s
 int main(int argc, char *argv[])
 {
     LOGGER_INIT;
-    
+
+    // Recycle frame buffers across ticks rather than allocate every node's outputs anew
+    FlowCV::FramePool::Install();
+
     FlowCV::FlowCV_Manager flowMan;
     ImGuiWrapper imgui;
     std::string pluginDir;
@@ -175,7 +197,12 @@ int main(int argc, char *argv[])
     AppSettings appSettings;
     appSettings.recentListSize = 8;
     appSettings.flowBufferCount = 1;
+    appSettings.flowBufferAutoTune = false;
+    appSettings.flowTargetFps = 30.0f;
+    appSettings.flowTickMode = (int)DSPatch::Circuit::AutoTickMode::FreeRunning;
+    appSettings.flowTickRate = 30.0f;
     appSettings.showFPS = false;
+    appSettings.showNodeCost = false;
     appSettings.useVSync = false;
     appSettings.logLevel = FlowCV::FlowLogger::getLevel();
 
@@ -279,6 +306,7 @@ int main(int argc, char *argv[])
 
     if (appSettings.flowBufferCount > 1)
         flowMan.SetBufferCount(appSettings.flowBufferCount);
+    flowMan.SetAutoTickMode((DSPatch::Circuit::AutoTickMode)appSettings.flowTickMode, appSettings.flowTickRate);
     flowMan.StartAutoTick();
 
     appGlobals->selectedId = 0;
@@ -365,12 +393,9 @@ int main(int argc, char *argv[])
                         if (ImGui::MenuItem(path->c_str())) {
                             flowMan.StopAutoTick();
                             appGlobals->firstLoad = true;
-                            std::fstream i(*path);
                             currently_opened_flow_file = *path;
                             nlohmann::json state;
-                            i >> state;
-                            i.close();
-                            bool res = Application_SetState(flowMan, state);
+                            bool res = FlowCV::FlowCV_Manager::ReadFlowFile(path->c_str(), state) && Application_SetState(flowMan, state);
                             appTitle = Application_GetName();
                             appTitle += " - ";
                             appTitle += currently_opened_flow_file;
@@ -483,18 +508,18 @@ int main(int argc, char *argv[])
         if (showAppSettings)
             ApplicationSettingsDialog(appSettings, showAppSettings);
 
+        flowMan.SetBufferAutoTune(appSettings.flowBufferAutoTune, appSettings.flowTargetFps);
+        flowMan.UpdateBufferAutoTune();
+
         if(file_dialog.showFileDialog("Open File", imgui_addons::ImGuiFileBrowser::DialogMode::OPEN, ImVec2(700, 310), ".flow", &appGlobals->showLoadDialog))
         {
             flowMan.StopAutoTick();
             appGlobals->firstLoad = true;
             printf("OPEN[%s]\n", file_dialog.selected_path.c_str());
             AddFileToRecent(appSettings, file_dialog.selected_path);
-            std::fstream i(file_dialog.selected_path);
             currently_opened_flow_file = file_dialog.selected_path;
             nlohmann::json state;
-            i >> state;
-            i.close();
-            bool res = Application_SetState(flowMan, state);
+            bool res = FlowCV::FlowCV_Manager::ReadFlowFile(file_dialog.selected_path.c_str(), state) && Application_SetState(flowMan, state);
             appGlobals->showLoadDialog = false;
             if (!res) {
                 LOG_ERROR("Error!");
@@ -511,7 +536,6 @@ int main(int argc, char *argv[])
         }
 
         if (file_dialog.showFileDialog("Save As...", imgui_addons::ImGuiFileBrowser::DialogMode::SAVE, ImVec2(700, 310), ".flow", &appGlobals->showSaveDialog)) {
-            flowMan.StopAutoTick();
             if (file_dialog.selected_path.find(".flow") == std::string::npos)
                 file_dialog.selected_path += ".flow";
             printf("SAVE[%s]\n", file_dialog.selected_path.c_str());
@@ -519,7 +543,6 @@ int main(int argc, char *argv[])
             AddFileToRecent(appSettings, file_dialog.selected_path);
             appTitle = SaveFlowFile(imgui, flowMan, currently_opened_flow_file);
             appGlobals->allowEditorKeys = true;
-            flowMan.StartAutoTick();
         }
 
         if (!appGlobals->showSaveDialog && !appGlobals->showLoadDialog)
@@ -5,8 +5,10 @@
 #include <iostream>
 #include <vector>
 #include <chrono>
+#include <unordered_map>
 
 #include "FlowLogger.hpp"
+#include "Frame_Pool.hpp"
 
 #define IN_OFFSET 99
 #define OUT_OFFSET 199
@@ -167,13 +169,11 @@ void CutSelectedNodes(FlowCV::FlowCV_Manager &flowMan)
     selectedNodes.resize(ed::GetSelectedObjectCount());
     int nodeCount = ed::GetSelectedNodes(selectedNodes.data(), static_cast<int>(selectedNodes.size()));
     ed::Suspend();
-    flowMan.StopAutoTick();
     for (const auto &node : selectedNodes) {
         ed::NodeId id = node.Get();
         flowMan.RemoveNodeInstance((uint64_t)id.Get());
     }
     ed::Resume();
-    flowMan.StartAutoTick();
 }
 
 void PasteNodes(FlowCV::FlowCV_Manager &flowMan)
@@ -190,7 +190,6 @@ void PasteNodes(FlowCV::FlowCV_Manager &flowMan)
             curMousePos.y += (scrSize.y / 2);
         }
 
-        flowMan.StopAutoTick();
         std::unordered_map<uint64_t, uint64_t> nodeRemap;
         ed::ClearSelection();
         if (state.contains("nodes")) {
@@ -202,7 +201,7 @@ void PasteNodes(FlowCV::FlowCV_Manager &flowMan)
                 FlowCV::NodeInfo ni;
                 flowMan.GetNodeInfoById(new_node_id, ni);
                 if (node.contains("params")) {
-                    ni.node_ptr->SetState(node["params"].dump());
+                    FlowCV::FlowCV_Manager::SetNodeState(*ni.node_ptr, std::move(node["params"]));
                 }
                 ed::SetNodePosition((ed::NodeId)new_node_id, ImVec2(curMousePos.x, curMousePos.y));
                 ed::SelectNode((ed::NodeId)new_node_id, true);
@@ -246,20 +245,19 @@ void PasteNodes(FlowCV::FlowCV_Manager &flowMan)
                 }
             }
         }
-        flowMan.StartAutoTick();
     }
     catch (const std::exception &e) {
         LOG_ERROR("{}", e.what());
     }
 }
 
-static bool IsPinLinked(uint64_t pinId, FlowCV::FlowCV_Manager &flowMan)
+static bool IsPinLinked(uint64_t nodeId, uint64_t pinId, FlowCV::FlowCV_Manager &flowMan)
 {
     if (pinId == 0)
         return false;
 
-    for (int i = 0; i < flowMan.GetWireCount(); i++) {
-        FlowCV::Wire w = flowMan.GetWireInfoFromIndex(i);
+    // Only wires to or from the pin's node can link it
+    for (const auto &w : flowMan.GetNodeConnectionsFromId(nodeId)) {
         if ((w.to.id + IN_OFFSET + w.to.index) == pinId || (w.from.id + OUT_OFFSET + w.from.index) == pinId) {
             return true;
         }
@@ -328,6 +326,65 @@ nlohmann::json Application_GetState(FlowCV::FlowCV_Manager &flowMan)
     return nodes;
 }
 
+struct NodeCost
+{
+    DSPatch::Component::Metrics total;   // as at the last update
+    DSPatch::Component::Metrics recent;  // since the update before
+};
+
+// Sample each node's metrics once a second, so that the cost overlay shows what the nodes cost lately
+void UpdateNodeCosts(FlowCV::FlowCV_Manager &flowMan, std::unordered_map<uint64_t, NodeCost> &nodeCosts, double &maxCostMs)
+{
+    static std::chrono::steady_clock::time_point lastUpdate;
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastUpdate < std::chrono::seconds(1))
+        return;
+    lastUpdate = now;
+
+    std::unordered_map<uint64_t, NodeCost> newCosts;
+    maxCostMs = 0.0;
+    for (int i = 0; i < flowMan.GetNodeCount(); i++) {
+        uint64_t id = flowMan.GetNodeIdFromIndex(i);
+        NodeCost cost;
+        if (!flowMan.GetNodeMetrics(id, cost.total))
+            continue;
+        cost.recent = cost.total;
+        auto last = nodeCosts.find(id);
+        if (last != nodeCosts.end()) {
+            cost.recent.Subtract(last->second.total);
+            // Metrics start over when a node is fused or the buffer count changes
+            if (cost.recent.tickCount < 0 || cost.recent.processTime.count < 0)
+                cost.recent = cost.total;
+        }
+        maxCostMs = std::max(maxCostMs, (double)cost.recent.processTime.Mean().count() / 1.0e6);
+        newCosts[id] = cost;
+    }
+    nodeCosts.swap(newCosts);
+}
+
+void DrawNodeCost(ImDrawList *drawList, const ImRect &nodeRect, const DSPatch::Component::Metrics &metrics, double maxCostMs)
+{
+    auto toMs = [](std::chrono::nanoseconds ns) { return (double)ns.count() / 1.0e6; };
+    double meanMs = toMs(metrics.processTime.Mean());
+
+    // Green for the cheapest nodes through to red for the most costly
+    float heat = maxCostMs > 0.0 ? (float)(meanMs / maxCostMs) : 0.0f;
+    ImU32 color = IM_COL32((int)(80.0f + 175.0f * heat), (int)(80.0f + 175.0f * (1.0f - heat)), 80, 255);
+
+    ImRect bar = nodeRect;
+    bar.Min.y = nodeRect.Max.y + 2;
+    bar.Max.y = bar.Min.y + 4;
+    bar.Max.x = bar.Min.x + nodeRect.GetWidth() * heat;
+    drawList->AddRectFilled(bar.Min, bar.Max, color, 1.0f);
+
+    std::string text = fmt::format("{:.2f} ms (p99 {:.2f} ms)", meanMs, toMs(metrics.processTime.Percentile(99.0)));
+    if (metrics.waitTime.count > 0)
+        text += fmt::format(" wait {:.2f} ms", toMs(metrics.waitTime.Mean()));
+    if (metrics.dropCount > 0)
+        text += fmt::format(" dropped {}", metrics.dropCount);
+    drawList->AddText(ImVec2(nodeRect.Min.x, bar.Max.y + 2), color, text.c_str());
+}
+
 ImU32 GetNodeColor(DSPatch::Category cat)
 {
     switch (cat) {
@@ -433,12 +490,19 @@ void Application_Frame(FlowCV::FlowCV_Manager &flowMan, const AppSettings &setti
     static char nodeSearch[64] = "";
     static std::chrono::steady_clock::time_point currentTime;
     static std::chrono::steady_clock::time_point lastTime;
+    static std::unordered_map<uint64_t, NodeCost> nodeCosts;
+    static double maxCostMs = 0.0;
     auto edGlobals = GetEditorGlobals();
     auto appGlobals = GetApplicationGlobals();
 
     auto &io = ImGui::GetIO();
     if (settings.showFPS)
         ImGui::Text("FPS: %.2f (%.2gms)", io.Framerate, io.Framerate ? 1000.0f / io.Framerate : 0.0f);
+    if (settings.showNodeCost) {
+        auto poolStats = FlowCV::FramePool::Get().GetStats();
+        ImGui::Text("Frame Pool: %.1f MB in use, %.1f MB idle, %lld allocations, %lld reuses", (double)poolStats.in_use_bytes / 1048576.0,
+            (double)poolStats.idle_bytes / 1048576.0, (long long)poolStats.allocations, (long long)poolStats.reuses);
+    }
 
     ed::SetCurrentEditor(edGlobals->g_Context);
 
@@ -489,10 +553,12 @@ void Application_Frame(FlowCV::FlowCV_Manager &flowMan, const AppSettings &setti
         }
     }
 
+    if (settings.showNodeCost)
+        UpdateNodeCosts(flowMan, nodeCosts, maxCostMs);
+
     // Draw Nodes
     for (int i = 0; i < flowMan.GetNodeCount(); i++) {
-        FlowCV::NodeInfo ni;
-        flowMan.GetNodeInfoByIndex(i, ni);
+        const FlowCV::NodeInfo &ni = *flowMan.GetNodeInfoPtrByIndex(i);
         // Set Style
         ed::PushStyleVar(ed::StyleVar_NodeRounding, 1.0f);
         ed::PushStyleVar(ed::StyleVar_LinkStrength, 145.0f);
@@ -512,7 +578,7 @@ void Application_Frame(FlowCV::FlowCV_Manager &flowMan, const AppSettings &setti
             ed::BeginPin((ed::PinId)(ni.id + IN_OFFSET + j), ed::PinKind::Input);
             auto alpha = ImGui::GetStyle().Alpha;
             DSPatch::IoType pinType = ni.node_ptr->GetInputType(j);
-            DrawPinIcon((ni.id + IN_OFFSET + j), pinType, IsPinLinked((ni.id + IN_OFFSET + j), flowMan), (int)(alpha * 255));
+            DrawPinIcon((ni.id + IN_OFFSET + j), pinType, IsPinLinked(ni.id, (ni.id + IN_OFFSET + j), flowMan), (int)(alpha * 255));
             ImGui::SameLine();
             ImGui::Text("%s", ni.node_ptr->GetInputName(j).c_str());
             ed::EndPin();
@@ -543,7 +609,7 @@ void Application_Frame(FlowCV::FlowCV_Manager &flowMan, const AppSettings &setti
             ImGui::Text("%s", outLabel.c_str());
             ImGui::SameLine();
             DSPatch::IoType pinType = ni.node_ptr->GetOutputType(j);
-            DrawPinIcon((ni.id + OUT_OFFSET + j), pinType, IsPinLinked((ni.id + OUT_OFFSET + j), flowMan), (int)(alpha * 255));
+            DrawPinIcon((ni.id + OUT_OFFSET + j), pinType, IsPinLinked(ni.id, (ni.id + OUT_OFFSET + j), flowMan), (int)(alpha * 255));
             ed::EndPin();
         }
         ImGuiEx_EndColumn();
@@ -564,6 +630,13 @@ void Application_Frame(FlowCV::FlowCV_Manager &flowMan, const AppSettings &setti
             drawList->AddLine(ImVec2(baseRect.Min.x, baseRect.Max.y), ImVec2(baseRect.Max.x, baseRect.Min.y), IM_COL32(227, 126, 18, 255), 1.0f);
         }
 
+        // Cost overlay beneath the node
+        if (settings.showNodeCost) {
+            auto cost = nodeCosts.find(ni.id);
+            if (cost != nodeCosts.end())
+                DrawNodeCost(drawList, baseRect, cost->second.recent, maxCostMs);
+        }
+
         ed::PopStyleVar(3);
         ed::PopStyleColor(2);
     }
@@ -571,10 +644,9 @@ void Application_Frame(FlowCV::FlowCV_Manager &flowMan, const AppSettings &setti
     // Submit Links
     for (int i = 0; i < flowMan.GetWireCount(); i++) {
         FlowCV::Wire w = flowMan.GetWireInfoFromIndex(i);
-        FlowCV::NodeInfo ni;
-        if (flowMan.GetNodeInfoById(w.from.id, ni)) {
+        if (const FlowCV::NodeInfo *ni = flowMan.GetNodeInfoPtrById(w.from.id)) {
             ed::Link((ed::LinkId)w.id, (ed::PinId)(w.from.id + OUT_OFFSET + w.from.index), (ed::PinId)(w.to.id + IN_OFFSET + w.to.index),
-                GetIconColor(ni.node_ptr->GetOutputType((int)w.from.index)));
+                GetIconColor(ni->node_ptr->GetOutputType((int)w.from.index)));
         }
     }
     //
@@ -0,0 +1,207 @@
+//
+// FlowCV Flow Load Benchmark
+//
+// Measures the time to load, reload, look up and partly remove synthetic flows of 10 to 10,000
+// nodes through FlowCV_Manager, to show how each operation scales with the size of the flow,
+// and the time to load the flow (with every node's params) from a JSON and a CBOR flow file.
+// Nodes form a chain, with every 5th node (an Add) also wired to an earlier node. Last, it compares a flow of many
+// instances of one subgraph with the same flow written out node by node.
+//
+
+#include "FlowCV_Manager.hpp"
+#include "json.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace FlowCV;
+
+static uint64_t NodeId(size_t index)
+{
+    return 1001 + index * 1000;
+}
+
+static nlohmann::json MakeFlow(size_t node_count)
+{
+    std::mt19937 rng(42);
+    nlohmann::json nodes = nlohmann::json::array();
+    nlohmann::json connections = nlohmann::json::array();
+
+    auto connect = [&connections](size_t from, size_t to, uint32_t to_idx) {
+        nlohmann::json w;
+        w["from_id"] = NodeId(from);
+        w["from_idx"] = 0;
+        w["to_id"] = NodeId(to);
+        w["to_idx"] = to_idx;
+        connections.emplace_back(w);
+    };
+
+    for (size_t i = 0; i < node_count; i++) {
+        nlohmann::json n;
+        n["id"] = NodeId(i);
+        n["num"] = i;
+        if (i == 0)
+            n["name"] = "Solid";
+        else if (i % 5 == 0)
+            n["name"] = "Add";
+        else
+            n["name"] = i % 2 == 0 ? "Blur" : "Threshold";
+        nodes.emplace_back(n);
+
+        if (i > 0) {
+            connect(i - 1, i, 0);
+            if (i % 5 == 0)
+                connect(std::uniform_int_distribution<size_t>(0, i - 1)(rng), i, 1);
+        }
+    }
+
+    nlohmann::json state;
+    state["nodes"] = nodes;
+    state["connections"] = connections;
+
+    return state;
+}
+
+// A small per stream subgraph, instanced once per stream, or written out once per stream when flat
+static nlohmann::json MakeInstancedFlow(size_t instance_count, bool flat)
+{
+    nlohmann::json subgraph;
+    subgraph["nodes"] = nlohmann::json::array();
+    subgraph["connections"] = nlohmann::json::array();
+    const char *names[] = {"Solid", "Blur", "Threshold", "Blur", "Add"};
+    for (size_t i = 0; i < 5; i++) {
+        nlohmann::json n;
+        n["id"] = NodeId(i);
+        n["name"] = names[i];
+        subgraph["nodes"].emplace_back(n);
+        if (i > 0) {
+            nlohmann::json w;
+            w["from_id"] = NodeId(i - 1);
+            w["from_idx"] = 0;
+            w["to_id"] = NodeId(i);
+            w["to_idx"] = 0;
+            subgraph["connections"].emplace_back(w);
+        }
+    }
+
+    nlohmann::json state;
+    state["nodes"] = nlohmann::json::array();
+    state["connections"] = nlohmann::json::array();
+    if (!flat) {
+        state["subgraphs"]["stream"] = subgraph;
+        for (size_t i = 0; i < instance_count; i++) {
+            nlohmann::json inst;
+            inst["subgraph"] = "stream";
+            inst["name"] = "stream " + std::to_string(i);
+            state["instances"].emplace_back(inst);
+        }
+        return state;
+    }
+
+    for (size_t i = 0; i < instance_count; i++) {
+        uint64_t idOffset = (i + 1) * 1000000;
+        for (auto n : subgraph["nodes"]) {
+            n["id"] = n["id"].get<uint64_t>() + idOffset;
+            state["nodes"].emplace_back(n);
+        }
+        for (auto w : subgraph["connections"]) {
+            w["from_id"] = w["from_id"].get<uint64_t>() + idOffset;
+            w["to_id"] = w["to_id"].get<uint64_t>() + idOffset;
+            state["connections"].emplace_back(w);
+        }
+    }
+    return state;
+}
+
+template <typename Func>
+static double TimeMs(Func &&func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void RunBenchmark(size_t node_count)
+{
+    nlohmann::json state = MakeFlow(node_count);
+    FlowCV_Manager flowMan;
+
+    bool loaded = true;
+    double loadMs = TimeMs([&] { loaded = flowMan.SetState(state); });
+    double reloadMs = TimeMs([&] {
+        flowMan.NewState();
+        loaded &= flowMan.SetState(state);
+    });
+
+    uint64_t wireCount = 0;
+    double lookupMs = TimeMs([&] {
+        for (size_t i = 0; i < node_count; i++) {
+            if (flowMan.GetNodeInfoPtrById(NodeId(i)) != nullptr)
+                wireCount += flowMan.GetNodeConnectionsFromId(NodeId(i)).size();
+        }
+    });
+
+    std::filesystem::path tmpDir = std::filesystem::temp_directory_path();
+    std::string jsonFile = (tmpDir / "flowcv_load_benchmark.flow").string();
+    std::string cborFile = (tmpDir / "flowcv_load_benchmark.cbor.flow").string();
+    flowMan.SaveState(jsonFile.c_str(), FlowFileFormat::Json);
+    flowMan.SaveState(cborFile.c_str(), FlowFileFormat::Cbor);
+    double jsonFileMs = TimeMs([&] { loaded &= flowMan.LoadState(jsonFile.c_str()); });
+    double cborFileMs = TimeMs([&] { loaded &= flowMan.LoadState(cborFile.c_str()); });
+    auto jsonBytes = std::filesystem::file_size(jsonFile);
+    auto cborBytes = std::filesystem::file_size(cborFile);
+    std::filesystem::remove(jsonFile);
+    std::filesystem::remove(cborFile);
+
+    size_t removeCount = std::max<size_t>(node_count / 10, 1);
+    size_t removed = 0;
+    double removeMs = TimeMs([&] {
+        for (size_t i = 0; i < removeCount; i++)
+            removed += flowMan.RemoveNodeInstance(NodeId(node_count - 1 - i * 10 % node_count)) ? 1 : 0;
+    });
+
+    auto perNode = [node_count](double ms) { return ms * 1000.0 / (double)node_count; };
+
+    std::cout << std::setw(6) << node_count << " nodes" << (loaded ? "" : " (load failed)") << std::fixed << std::setprecision(2)
+              << ": load " << loadMs << " ms (" << perNode(loadMs) << " us/node)"
+              << ", reload " << reloadMs << " ms (" << perNode(reloadMs) << " us/node)"
+              << ", lookup " << lookupMs << " ms (" << wireCount / 2 << " wires)"
+              << ", JSON file " << jsonFileMs << " ms (" << jsonBytes / 1024 << " KiB)"
+              << ", CBOR file " << cborFileMs << " ms (" << cborBytes / 1024 << " KiB)"
+              << ", remove " << removed << " in " << removeMs << " ms (" << removeMs * 1000.0 / (double)removeCount << " us/node)" << std::endl;
+}
+
+static void RunInstanceBenchmark(size_t instance_count)
+{
+    std::filesystem::path flowFile = std::filesystem::temp_directory_path() / "flowcv_instance_benchmark.flow";
+
+    for (bool flat : {true, false}) {
+        nlohmann::json state = MakeInstancedFlow(instance_count, flat);
+        FlowCV_Manager flowMan;
+        bool loaded = flowMan.SetState(state);
+        // Saved and reloaded, so that the instanced flow's params are those of a saved flow
+        flowMan.SaveState(flowFile.string().c_str());
+        double loadMs = TimeMs([&] { loaded &= flowMan.LoadState(flowFile.string().c_str()); });
+        auto fileBytes = std::filesystem::file_size(flowFile);
+        std::filesystem::remove(flowFile);
+
+        std::cout << std::setw(6) << instance_count << (flat ? " flat streams" : " instances") << (loaded ? "" : " (load failed)") << std::fixed
+                  << std::setprecision(2) << ": " << flowMan.GetNodeCount() << " nodes, " << flowMan.GetSubgraphInstanceCount()
+                  << " instances, file load " << loadMs << " ms (" << fileBytes / 1024 << " KiB)" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    for (size_t nodeCount : {10, 100, 1000, 10000})
+        RunBenchmark(nodeCount);
+
+    for (size_t instanceCount : {16, 256})
+        RunInstanceBenchmark(instanceCount);
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+//
+// FlowCV Signal Benchmark
+//
+// Measures heap allocations and time per circuit tick for the FlowCV IO types (cv::Mat, bool,
+// int, float, string, JSON and arrays) fanned out from a source to several consumers, plus a
+// component whose output changes type every tick.
+//
+
+#include <DSPatch.h>
+#include <opencv2/core.hpp>
+#include "json.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+static std::atomic<uint64_t> alloc_count{0};
+
+void *operator new(std::size_t size)
+{
+    ++alloc_count;
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+using namespace DSPatch;
+
+class BenchComponent : public Component
+{
+  public:
+    explicit BenchComponent(ProcessOrder order = ProcessOrder::OutOfOrder) : Component(order) {}
+    bool HasGui(int interface) override { return false; }
+    void UpdateGui(void *context, int interface) override {}
+    std::string GetState() override { return {}; }
+    void SetState(std::string &&json_serialized) override {}
+};
+
+class Source final : public BenchComponent
+{
+  public:
+    Source()
+    {
+        SetOutputCount_(8);
+        frame_ = cv::Mat(480, 640, CV_8UC3, cv::Scalar(0));
+        json_ = 0.5;  // copying a JSON object/array allocates by design, a scalar isolates the signal path
+        floats_.resize(64, 1.0f);
+        strings_.resize(8, "value");
+        string_ = "steady string value";
+    }
+
+  protected:
+    void Process_(SignalBus const &inputs, SignalBus &outputs) override
+    {
+        ++count_;
+        outputs.SetValue(0, frame_);
+        outputs.SetValue(1, (count_ & 1) == 0);
+        outputs.SetValue(2, count_);
+        outputs.SetValue(3, (float)count_);
+        outputs.SetValue(4, string_);
+        outputs.SetValue(5, json_);
+        outputs.SetValue(6, floats_);
+        outputs.SetValue(7, strings_);
+    }
+
+  private:
+    int count_ = 0;
+    cv::Mat frame_;
+    nlohmann::json json_;
+    std::vector<float> floats_;
+    std::vector<std::string> strings_;
+    std::string string_;
+};
+
+class Consumer final : public BenchComponent
+{
+  public:
+    Consumer() { SetInputCount_(8); }
+    uint64_t checksum = 0;
+
+  protected:
+    void Process_(SignalBus const &inputs, SignalBus &outputs) override
+    {
+        if (auto frame = inputs.GetValue<cv::Mat>(0))
+            checksum += frame->cols;
+        if (auto b = inputs.GetValue<bool>(1))
+            checksum += *b;
+        if (auto i = inputs.GetValue<int>(2))
+            checksum += *i;
+        if (auto f = inputs.GetValue<float>(3))
+            checksum += (uint64_t)*f;
+        if (auto s = inputs.GetValue<std::string>(4))
+            checksum += s->size();
+        if (auto j = inputs.GetValue<nlohmann::json>(5))
+            checksum += j->size();
+        if (auto fa = inputs.GetValue<std::vector<float>>(6))
+            checksum += fa->size();
+        if (auto sa = inputs.GetValue<std::vector<std::string>>(7))
+            checksum += sa->size();
+    }
+};
+
+class TypeChanger final : public BenchComponent
+{
+  public:
+    TypeChanger()
+    {
+        SetInputCount_(1);
+        SetOutputCount_(1);
+    }
+
+  protected:
+    void Process_(SignalBus const &inputs, SignalBus &outputs) override
+    {
+        auto in = inputs.GetValue<int>(0);
+        if (!in)
+            return;
+        if ((*in & 1) == 0)
+            outputs.SetValue(0, *in);
+        else
+            outputs.SetValue(0, (float)*in);
+    }
+};
+
+static void RunBenchmark(Component::TickMode mode, int buffer_count, int fan_out)
+{
+    const int warmup_ticks = 100;
+    const int ticks = 10000;
+
+    auto circuit = std::make_shared<Circuit>();
+    auto source = std::make_shared<Source>();
+    auto changer = std::make_shared<TypeChanger>();
+    circuit->AddComponent(source);
+    circuit->AddComponent(changer);
+    circuit->ConnectOutToIn(source, 2, changer, 0);
+    std::vector<std::shared_ptr<Consumer>> consumers;
+    for (int i = 0; i < fan_out; i++) {
+        auto consumer = std::make_shared<Consumer>();
+        circuit->AddComponent(consumer);
+        for (int j = 0; j < 8; j++)
+            circuit->ConnectOutToIn(source, j, consumer, j);
+        consumers.emplace_back(consumer);
+    }
+    auto changed = std::make_shared<Consumer>();
+    circuit->AddComponent(changed);
+    circuit->ConnectOutToIn(changer, 0, changed, 2);
+    circuit->SetBufferCount(buffer_count);
+
+    for (int i = 0; i < warmup_ticks; i++)
+        circuit->Tick(mode);
+
+    uint64_t allocs_start = alloc_count;
+    auto time_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ticks; i++)
+        circuit->Tick(mode);
+    circuit->SetBufferCount(buffer_count == 0 ? 1 : 0);  // syncs any in-flight ticks
+    auto time_end = std::chrono::steady_clock::now();
+    uint64_t allocs = alloc_count - allocs_start;
+
+    double ns_per_tick = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count() / ticks;
+    std::cout << (mode == Component::TickMode::Series ? "Series  " : "Parallel") << "  buffers: " << buffer_count << "  fan-out: " << fan_out
+              << "  allocations/tick: " << (double)allocs / ticks << "  ns/tick: " << ns_per_tick << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    for (auto mode : {Component::TickMode::Series, Component::TickMode::Parallel}) {
+        for (int buffers : {0, 3}) {
+            for (int fan_out : {1, 6}) {
+                RunBenchmark(mode, buffers, fan_out);
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
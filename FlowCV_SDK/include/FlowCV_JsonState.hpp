@@ -0,0 +1,37 @@
+//
+// FlowCV Node JSON State
+//
+
+#ifndef FLOWCV_JSON_STATE_HPP_
+#define FLOWCV_JSON_STATE_HPP_
+
+#include <string>
+#include <DSPatch.h>
+#include "json.hpp"
+
+namespace FlowCV
+{
+
+// Base for nodes that keep their state as JSON, so that a flow can hand each node its state as parsed JSON rather than
+// serialise it only for the node to parse it again. GetState()/SetState() serialise the same state for everything else.
+class JsonState : public DSPatch::Component
+{
+  public:
+    using DSPatch::Component::Component;
+
+    virtual nlohmann::json GetStateJson() = 0;
+    virtual void SetStateJson(nlohmann::json &&state) = 0;
+
+    std::string GetState() override
+    {
+        return GetStateJson().dump(4);
+    }
+
+    void SetState(std::string &&json_serialized) override
+    {
+        SetStateJson(nlohmann::json::parse(json_serialized));
+    }
+};
+}  // End Namespace FlowCV
+
+#endif  // FLOWCV_JSON_STATE_HPP_
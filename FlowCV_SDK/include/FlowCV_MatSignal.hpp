@@ -0,0 +1,32 @@
+//
+// FlowCV Mat Signals
+//
+
+#ifndef FLOWCV_MAT_SIGNAL_HPP_
+#define FLOWCV_MAT_SIGNAL_HPP_
+
+#include <opencv2/core.hpp>
+#include <DSPatch.h>
+
+namespace DSPatch
+{
+
+// A cv::Mat is a handle to a reference counted frame, so TakeMutable<cv::Mat>() only hands the frame over for modifying
+// in place when nothing else holds it (and it isn't user data), otherwise it hands over a clone. Include this wherever
+// TakeMutable<cv::Mat>() is called, without it every frame is taken as exclusive.
+template <>
+struct MutableValue<cv::Mat>
+{
+    static bool IsExclusive(cv::Mat const &value)
+    {
+        return value.u != nullptr && value.u->refcount == 1;
+    }
+
+    static cv::Mat Copy(cv::Mat const &value)
+    {
+        return value.clone();
+    }
+};
+}  // namespace DSPatch
+
+#endif  // FLOWCV_MAT_SIGNAL_HPP_
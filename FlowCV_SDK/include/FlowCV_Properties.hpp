@@ -4,11 +4,13 @@
 
 #ifndef FLOWCV_PROPERTY_MANAGER_HPP_
 #define FLOWCV_PROPERTY_MANAGER_HPP_
+#include <atomic>
 #include <vector>
 #include <string>
 #include <memory>
 #include <mutex>
 #include <map>
+#include <unordered_map>
 #include <json.hpp>
 
 namespace FlowCV
@@ -45,6 +47,18 @@ struct DataStruct
     bool changed;
 };
 
+// The read values of a FlowCV_Properties as they were when the snapshot was taken. A snapshot never changes, so any number of
+// threads can read one while the GUI keeps editing the properties it was taken from.
+class PropertySnapshot
+{
+  public:
+    template<typename T> T Get(const std::string &key) const;
+
+  private:
+    friend class FlowCV_Properties;
+    std::unordered_map<std::string, std::vector<uint8_t>> values_;
+};
+
 class FlowCV_Properties
 {
   public:
@@ -69,6 +83,7 @@ class FlowCV_Properties
     void SetAllToDefault();
     bool Exists(const std::string &key);
     bool Changed(const std::string &key);
+    bool HasChanges() const;
     std::shared_ptr<std::vector<DataStruct>> GetAll();
     template<typename T> T *GetPointer(const std::string &key);
     template<typename T> T Get(const std::string &key);
@@ -81,12 +96,20 @@ class FlowCV_Properties
     void FromJson(nlohmann::json &j);
     const std::vector<std::string> &GetOptions(std::string &&key);
     void Sync();
+    // Syncs any changes and returns the current read values. Nodes processing more than one buffer at a time should read
+    // their properties from a snapshot taken at the start of Process_() rather than Sync() and Get().
+    std::shared_ptr<const PropertySnapshot> Snapshot();
 
   private:
-    bool has_changes_;
+    void SyncValues_();
+
+
+    // Set as the GUI edits values, read unlocked by the processing threads (HasChanges(), Sync())
+    std::atomic<bool> has_changes_{false};
     std::shared_ptr<std::vector<DataStruct>> props_;
     std::unordered_map<std::string, int> prop_idx;
     std::mutex mutex_lock_;
+    std::shared_ptr<const PropertySnapshot> snapshot_;
 
 };  // End Class Node_Properties
 }  // End Namespace FlowCV
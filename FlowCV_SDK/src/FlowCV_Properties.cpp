@@ -12,7 +12,6 @@ namespace FlowCV
 FlowCV_Properties::FlowCV_Properties()
 {
     props_ = std::make_shared<std::vector<DataStruct>>();
-    has_changes_ = false;
 }
 
 void FlowCV_Properties::AddBool(std::string &&key, std::string &&desc, bool value, bool visible)
@@ -29,8 +28,10 @@ void FlowCV_Properties::AddBool(std::string &&key, std::string &&desc, bool valu
     d.visibility = visible;
     d.desc = desc;
     d.key = key;
+    std::lock_guard<std::mutex> lk(mutex_lock_);
     props_->emplace_back(std::move(d));
     prop_idx[key] = (int)props_->size() - 1;
+    snapshot_.reset();
 }
 
 void FlowCV_Properties::AddInt(std::string &&key, std::string &&desc, int value, int min, int max, float step, bool visible)
@@ -53,8 +54,10 @@ void FlowCV_Properties::AddInt(std::string &&key, std::string &&desc, int value,
     d.visibility = visible;
     d.desc = desc;
     d.key = key;
+    std::lock_guard<std::mutex> lk(mutex_lock_);
     props_->emplace_back(std::move(d));
     prop_idx[key] = (int)props_->size() - 1;
+    snapshot_.reset();
 }
 
 void FlowCV_Properties::AddFloat(std::string &&key, std::string &&desc, float value, float min, float max, float step, bool visible)
@@ -77,8 +80,10 @@ void FlowCV_Properties::AddFloat(std::string &&key, std::string &&desc, float va
     d.visibility = visible;
     d.desc = desc;
     d.key = key;
+    std::lock_guard<std::mutex> lk(mutex_lock_);
     props_->emplace_back(std::move(d));
     prop_idx[key] = (int)props_->size() - 1;
+    snapshot_.reset();
 }
 
 void FlowCV_Properties::AddOption(std::string &&key, std::string &&desc, int value, std::vector<std::string> options, bool visible)
@@ -101,8 +106,10 @@ void FlowCV_Properties::AddOption(std::string &&key, std::string &&desc, int val
     d.visibility = visible;
     d.desc = desc;
     d.key = key;
+    std::lock_guard<std::mutex> lk(mutex_lock_);
     props_->emplace_back(std::move(d));
     prop_idx[key] = (int)props_->size() - 1;
+    snapshot_.reset();
 }
 
 void FlowCV_Properties::Remove(std::string &&key)
@@ -112,6 +119,7 @@ void FlowCV_Properties::Remove(std::string &&key)
         int idx = prop_idx.at(key);
         props_->erase(props_->begin() + idx);
         prop_idx.erase(key);
+        snapshot_.reset();
     }
 }
 
@@ -120,6 +128,7 @@ void FlowCV_Properties::RemoveAll()
     std::lock_guard<std::mutex> lk(mutex_lock_);
     props_->clear();
     prop_idx.clear();
+    snapshot_.reset();
 }
 
 template<typename T> T FlowCV_Properties::Get(const std::string &key)
@@ -132,6 +141,17 @@ template<typename T> T FlowCV_Properties::Get(const std::string &key)
     return ret;
 }
 
+template<typename T> T PropertySnapshot::Get(const std::string &key) const
+{
+    T ret{};
+
+    auto value = values_.find(key);
+    if (value != values_.end())
+        ret = *(const T *)value->second.data();
+
+    return ret;
+}
+
 template<typename T> T FlowCV_Properties::GetW(const std::string &key)
 {
     T ret{};
@@ -167,29 +187,54 @@ bool FlowCV_Properties::Changed(const std::string &key)
     return false;
 }
 
+bool FlowCV_Properties::HasChanges() const
+{
+    return has_changes_.load(std::memory_order_acquire);
+}
+
 void FlowCV_Properties::Sync()
 {
-    if (has_changes_) {
+    if (has_changes_.load(std::memory_order_acquire)) {
         std::lock_guard<std::mutex> lk(mutex_lock_);
-        for (auto &prop : *props_) {
-            if (prop.changed) {
-                if (prop.data_type == PropertyDataTypes::kDataTypeBool) {
-                    *(bool *)prop.r_val.data() = *(bool *)prop.w_val.data();
-                }
-                else if (prop.data_type == PropertyDataTypes::kDataTypeInt) {
-                    *(int *)prop.r_val.data() = *(int *)prop.w_val.data();
-                }
-                else if (prop.data_type == PropertyDataTypes::kDataTypeFloat) {
-                    *(float *)prop.r_val.data() = *(float *)prop.w_val.data();
-                }
-                else if (prop.data_type == PropertyDataTypes::kDataTypeOption) {
-                    *(int *)prop.r_val.data() = *(int *)prop.w_val.data();
-                }
-                prop.changed = false;
+        SyncValues_();
+    }
+}
+
+std::shared_ptr<const PropertySnapshot> FlowCV_Properties::Snapshot()
+{
+    std::lock_guard<std::mutex> lk(mutex_lock_);
+    if (has_changes_.load(std::memory_order_acquire) || !snapshot_) {
+        SyncValues_();
+        // Published as a new snapshot, those still being read by other buffers keep their values
+        auto snapshot = std::make_shared<PropertySnapshot>();
+        for (const auto &prop : *props_)
+            snapshot->values_[prop.key] = prop.r_val;
+        snapshot_ = std::move(snapshot);
+    }
+
+    return snapshot_;
+}
+
+void FlowCV_Properties::SyncValues_()
+{
+    for (auto &prop : *props_) {
+        if (prop.changed) {
+            if (prop.data_type == PropertyDataTypes::kDataTypeBool) {
+                *(bool *)prop.r_val.data() = *(bool *)prop.w_val.data();
+            }
+            else if (prop.data_type == PropertyDataTypes::kDataTypeInt) {
+                *(int *)prop.r_val.data() = *(int *)prop.w_val.data();
             }
+            else if (prop.data_type == PropertyDataTypes::kDataTypeFloat) {
+                *(float *)prop.r_val.data() = *(float *)prop.w_val.data();
+            }
+            else if (prop.data_type == PropertyDataTypes::kDataTypeOption) {
+                *(int *)prop.r_val.data() = *(int *)prop.w_val.data();
+            }
+            prop.changed = false;
         }
-        has_changes_ = false;
     }
+    has_changes_.store(false, std::memory_order_release);
 }
 
 std::shared_ptr<std::vector<DataStruct>> FlowCV_Properties::GetAll()
@@ -202,9 +247,11 @@ void FlowCV_Properties::Set(std::string &&key, bool value)
     if (prop_idx.find(key) != prop_idx.end()) {
         std::lock_guard<std::mutex> lk(mutex_lock_);
         auto &prop = props_->at(prop_idx.at(key));
-        *(bool *)prop.w_val.data() = value;
-        prop.changed = true;
-        has_changes_ = true;
+        if (*(bool *)prop.w_val.data() != value) {
+            *(bool *)prop.w_val.data() = value;
+            prop.changed = true;
+            has_changes_.store(true, std::memory_order_release);
+        }
     }
 }
 
@@ -213,9 +260,11 @@ void FlowCV_Properties::Set(std::string &&key, int value)
     if (prop_idx.find(key) != prop_idx.end()) {
         std::lock_guard<std::mutex> lk(mutex_lock_);
         auto &prop = props_->at(prop_idx.at(key));
-        *(int *)prop.w_val.data() = value;
-        prop.changed = true;
-        has_changes_ = true;
+        if (*(int *)prop.w_val.data() != value) {
+            *(int *)prop.w_val.data() = value;
+            prop.changed = true;
+            has_changes_.store(true, std::memory_order_release);
+        }
     }
 }
 
@@ -224,9 +273,11 @@ void FlowCV_Properties::Set(std::string &&key, float value)
     if (prop_idx.find(key) != prop_idx.end()) {
         std::lock_guard<std::mutex> lk(mutex_lock_);
         auto &prop = props_->at(prop_idx.at(key));
-        *(float *)prop.w_val.data() = value;
-        prop.changed = true;
-        has_changes_ = true;
+        if (*(float *)prop.w_val.data() != value) {
+            *(float *)prop.w_val.data() = value;
+            prop.changed = true;
+            has_changes_.store(true, std::memory_order_release);
+        }
     }
 }
 
@@ -310,7 +361,7 @@ void FlowCV_Properties::SetToDefault(std::string &&key)
             *(int *)props_->at(prop_idx.at(key)).w_val.data() = *(int *)props_->at(prop_idx.at(key)).d_val.data();
             props_->at(prop_idx.at(key)).changed = true;
         }
-        has_changes_ = true;
+        has_changes_.store(true, std::memory_order_release);
     }
 }
 
@@ -335,7 +386,7 @@ void FlowCV_Properties::SetAllToDefault()
             prop.changed = true;
         }
     }
-    has_changes_ = true;
+    has_changes_.store(true, std::memory_order_release);
 }
 
 template<typename T> T FlowCV_Properties::GetMin(const std::string &key)
@@ -421,6 +472,7 @@ void FlowCV_Properties::FromJson(nlohmann::json &j)
             }
         }
     }
+    has_changes_.store(true, std::memory_order_release);
 }
 
 void FlowCV_Properties::DrawUi(const char *inst_id)
@@ -432,7 +484,7 @@ void FlowCV_Properties::DrawUi(const char *inst_id)
                 if (ImGui::Checkbox(CreateControlString(prop.desc.c_str(), inst_id).c_str(), &val)) {
                     *(bool *)prop.w_val.data() = val;
                     prop.changed = true;
-                    has_changes_ = true;
+                    has_changes_.store(true, std::memory_order_release);
                 }
             }
             else if (prop.data_type == PropertyDataTypes::kDataTypeInt) {
@@ -446,7 +498,7 @@ void FlowCV_Properties::DrawUi(const char *inst_id)
                         val = *(int *)prop.range.max.data();
                     *(int *)prop.w_val.data() = val;
                     prop.changed = true;
-                    has_changes_ = true;
+                    has_changes_.store(true, std::memory_order_release);
                 }
             }
             else if (prop.data_type == PropertyDataTypes::kDataTypeFloat) {
@@ -460,7 +512,7 @@ void FlowCV_Properties::DrawUi(const char *inst_id)
                         val = *(float *)prop.range.max.data();
                     *(float *)prop.w_val.data() = val;
                     prop.changed = true;
-                    has_changes_ = true;
+                    has_changes_.store(true, std::memory_order_release);
                 }
             }
             else if (prop.data_type == PropertyDataTypes::kDataTypeOption) {
@@ -475,7 +527,7 @@ void FlowCV_Properties::DrawUi(const char *inst_id)
                         (void *)&prop.options, (int)prop.options.size())) {
                     *(int *)prop.w_val.data() = val;
                     prop.changed = true;
-                    has_changes_ = true;
+                    has_changes_.store(true, std::memory_order_release);
                 }
             }
         }
@@ -486,6 +538,9 @@ void FlowCV_Properties::DrawUi(const char *inst_id)
 template bool FlowCV_Properties::Get<bool>(const std::string &key);
 template int FlowCV_Properties::Get<int>(const std::string &key);
 template float FlowCV_Properties::Get<float>(const std::string &key);
+template bool PropertySnapshot::Get<bool>(const std::string &key) const;
+template int PropertySnapshot::Get<int>(const std::string &key) const;
+template float PropertySnapshot::Get<float>(const std::string &key) const;
 template bool FlowCV_Properties::GetW<bool>(const std::string &key);
 template int FlowCV_Properties::GetW<int>(const std::string &key);
 template float FlowCV_Properties::GetW<float>(const std::string &key);
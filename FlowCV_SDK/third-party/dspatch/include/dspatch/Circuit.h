@@ -30,14 +30,65 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <dspatch/Component.h>
 
+#include <ostream>
+#include <string>
+
 namespace DSPatch
 {
 
 namespace internal
 {
 class Circuit;
+class CircuitTransaction;
 }
 
+/// Batch of component and wiring changes to apply to a Circuit in one step
+
+/**
+A CircuitTransaction records calls to its AddComponent(), RemoveComponent(), RemoveAllComponents(),
+ConnectOutToIn() and DisconnectInput() methods, which mirror those of Circuit, without changing any
+circuit. Circuit::Commit() then validates the changes against the circuit and, only if they are all
+valid, applies them in the order they were recorded, as one change to the circuit's wiring.
+
+A running circuit hence never ticks a partly built (or partly torn down) set of components, and
+its execution plan is recompiled once for the whole transaction, rather than once per edit.
+
+Each change is validated against the circuit as it would be at that point in the transaction:
+wired components must be in the circuit (or added earlier in the transaction), wired outputs and
+inputs must exist, and an output may only be wired to an input of the same IoType
+(Io_Type_Unspecified matches any type). As in a Circuit, removing a component also removes its
+wires, and wires that close a loop (feedback wires) are allowed, unless SetAllowFeedback( false )
+is called. Circuit::Validate() validates a transaction without applying it, and
+Circuit::CanConnectOutToIn() checks a single wire's outputs, inputs and types as Validate() does.
+*/
+
+class DLLEXPORT CircuitTransaction final
+{
+public:
+    NONCOPYABLE( CircuitTransaction );
+
+    CircuitTransaction();
+    ~CircuitTransaction();
+
+    void AddComponent( Component::SPtr const& component );
+
+    void RemoveComponent( Component::SCPtr const& component );
+    void RemoveAllComponents();
+
+    void ConnectOutToIn( Component::SCPtr const& fromComponent, int fromOutput, Component::SCPtr const& toComponent, int toInput );
+
+    void DisconnectInput( Component::SCPtr const& component, int inputNo );
+
+    void SetAllowFeedback( bool allowFeedback );
+
+    [[nodiscard]] bool IsEmpty() const;
+
+private:
+    friend class Circuit;
+
+    std::unique_ptr<internal::CircuitTransaction> p;
+};
+
 /// Workspace for adding and routing components
 
 /**
@@ -49,17 +100,66 @@ connected to an input that already has a connected wire, that wire is replaced w
 One output, on the other hand, can be distributed to multiple inputs.
 
 To boost performance in stream processing circuits, multi-buffering can be enabled via the
-SetBufferCount() method. A circuit's buffer count can be adjusted at runtime.
+SetBufferCount() method. A circuit's buffer count can be adjusted at runtime. GetTotalTicks() returns
+how many times Tick() has been called, hence sampling it periodically gives the circuit's tick rate.
 
 The Circuit Tick() method runs through it's internal array of components and calls each component's
 Tick() and Reset() methods once. A circuit's Tick() method can be called in a loop from the main
 application thread, or alternatively, by calling StartAutoTick(), a separate thread will spawn,
 automatically calling Tick() continuously until PauseAutoTick() or StopAutoTick() is called.
 
-TickMode::Parallel (default) will spawn a thread per component in a circuit. The aim of this mode
-is to improve the performance of circuits that contain parallel branches. TickMode::Series on the
+How often the auto-tick thread calls Tick() is set via SetAutoTickMode(). AutoTickMode::FreeRunning
+(default) ticks again as soon as the previous Tick() returns. AutoTickMode::Clocked ticks at a fixed
+rate, sleeping until each tick's deadline. AutoTickMode::SourceDriven only ticks when a component
+requests it (see Component::RequestTick_()), E.g. when a source has a new frame available. Idle
+circuits in the latter two modes hence consume next to no CPU. AutoTickMode::Batch is for offline
+processing: it ticks as FreeRunning does, but sources are not paced (see Component::PaceTick_()),
+and ticking stops once the circuit reaches end of stream.
+
+A circuit reaches end of stream once any of its components does (see
+Component::SetEndOfStream_()), E.g. when a file reader has output its last frame. CanEndStream()
+tells whether it ever can, I.e. whether any of its components is a finite source. Once auto-tick
+has been stopped, Flush() flushes each component in topological order, so that every component
+downstream of another flushes after it.
+
+Rather than traversing the component graph on every tick, a circuit compiles an execution plan the
+first time it is ticked: its components are sorted into topological levels, feedback wires are
+identified, and each component's per-buffer tasks are linked to those of its dependents. This plan
+is reused for every subsequent tick, and is only recompiled after the circuit's components or wiring
+change (via the methods below).
+
+Many changes can be applied at once via Commit() (see CircuitTransaction), E.g. to load or replace
+a whole set of components.
+
+Changing a circuit's components or wiring does not pause or drain a running circuit. Each change is
+applied to the circuit's next plan, which every buffer is swapped to at its next tick boundary,
+while buffers already in flight finish ticking under the plan they started with. A removed component
+is hence still ticked by those buffers until they are swapped over. Only SetBufferCount() drains the
+circuit.
+
+TickMode::Parallel (default) will tick components on a work-stealing thread pool owned by the
+circuit (sized to the number of hardware threads). Each tick runs as a graph of dependency-counted
+tasks, hence independent branches process concurrently, and a tick takes only as long as its
+slowest chain of components. Components are ranked by how critical they are to that chain (see
+Component::Rank()) when the plan is compiled, and every so often thereafter (rescheduling only once
+a rank has changed significantly since the components were last scheduled), so that the most
+critical ready components are processed first. The aim of this mode is to improve the performance
+of circuits that contain parallel branches. TickMode::Series on the
 other hand, tells the circuit to tick its components one-by-one in a single thread. This mode aims
 to improve the performance of circuits that do not contain parallel branches.
+
+Circuits running side by side in one process (E.g. one per camera) can tick their components on
+one thread pool, rather than each own a worker per hardware thread: either construct each circuit
+with the same pool from NewThreadPool(), or hand one circuit's pool to another via
+ShareThreadPool(). Their ticks then compete for the same workers, so the process' thread count
+doesn't grow with its number of circuits.
+
+A circuit's timeline can be traced for offline analysis: between StartTrace() and StopTrace(), each
+tick of a buffer, and each Process_() call, InOrder wait and Reset() wait of its components, is
+recorded as a span labelled with the component instance name and buffer number. WriteTrace() then
+outputs the spans as Chrome Trace Event JSON, for viewing in chrome://tracing or Perfetto. Tracing
+stops by itself once maxEvents spans have been recorded, in which case IsTraceTruncated() returns
+true and WriteTrace() marks the point at which the trace was cut short.
 */
 
 class DLLEXPORT Circuit final
@@ -68,7 +168,16 @@ public:
     NONCOPYABLE( Circuit );
     DEFINE_PTRS( Circuit );
 
+    enum class AutoTickMode
+    {
+        FreeRunning,
+        Clocked,
+        SourceDriven,
+        Batch
+    };
+
     Circuit();
+    explicit Circuit( std::shared_ptr<internal::ThreadPool> const& threadPool );
     ~Circuit();
 
     int AddComponent( Component::SPtr const& component );
@@ -87,9 +196,22 @@ public:
     void DisconnectComponent( Component::SCPtr const& component );
     void DisconnectComponent( int componentIndex );
 
+    void DisconnectInput( Component::SCPtr const& component, int inputNo );
+    void DisconnectInput( int componentIndex, int inputNo );
+
+    [[nodiscard]] bool Validate( CircuitTransaction const& transaction, std::string* error = nullptr ) const;
+    [[nodiscard]] static bool CanConnectOutToIn( Component::SCPtr const& fromComponent,
+                                                 int fromOutput,
+                                                 Component::SCPtr const& toComponent,
+                                                 int toInput,
+                                                 std::string* error = nullptr );
+    bool Commit( CircuitTransaction const& transaction, std::string* error = nullptr );
+
     void SetBufferCount( int bufferCount );
     [[nodiscard]] int GetBufferCount() const;
 
+    [[nodiscard]] int64_t GetTotalTicks() const;
+
     void Tick( Component::TickMode mode = Component::TickMode::Parallel );
 
     void StartAutoTick( Component::TickMode mode = Component::TickMode::Parallel );
@@ -97,6 +219,22 @@ public:
     void PauseAutoTick();
     void ResumeAutoTick();
 
+    [[nodiscard]] static std::shared_ptr<internal::ThreadPool> NewThreadPool( int threadCount = 0 );
+    void ShareThreadPool( Circuit const& circuit );
+
+    void SetAutoTickMode( AutoTickMode autoTickMode, double tickRate = 30.0 );
+    [[nodiscard]] AutoTickMode GetAutoTickMode() const;
+    [[nodiscard]] double GetAutoTickRate() const;
+
+    [[nodiscard]] bool CanEndStream() const;
+    [[nodiscard]] bool IsEndOfStream() const;
+    void Flush();
+
+    void StartTrace( int64_t maxEvents = 1000000 );
+    void StopTrace();
+    void WriteTrace( std::ostream& out ) const;
+    [[nodiscard]] bool IsTraceTruncated() const;
+
 private:
     std::unique_ptr<internal::Circuit> p;
 };
@@ -31,6 +31,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <dspatch/SignalBus.h>
 #include <dspatch/ComponentTypes.hpp>
 
+#include <array>
+#include <chrono>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <map>
@@ -40,6 +43,9 @@ namespace DSPatch
 namespace internal
 {
     class Component;
+    class AutoTickThread;
+    class ThreadPool;
+    class Tracer;
 }  // namespace internal
 
 /// Abstract base class for DSPatch components
@@ -65,6 +71,95 @@ acquired input bus is then passed to the Process_() method. The Reset() method i
 component that the last circuit traversal has completed and hence can execute the next Tick()
 request.
 
+In TickMode::Parallel, a component's processing is submitted as a task to the thread pool provided
+via SetThreadPool() (a Circuit provides its own pool to every component added to it). The task is
+only submitted once all of the component's incoming components have finished processing, hence
+pool threads never block waiting on one another. Without a thread pool, processing runs on the
+calling thread.
+
+A Circuit avoids this recursive traversal altogether by scanning its components once via Scan(),
+which sorts them into topological levels (ResetScan() discards the scan, which is required whenever
+the component's wiring changes). IsScanOutdated() tells whether the component has been rewired since
+it was scanned, E.g. directly via ConnectInput() rather than via its circuit. BindBuffer() then
+binds one buffer to the scan: it links the buffer's task to those of its non-feedback incoming
+components, and takes a copy of the current input wires for the buffer to tick with. A bound buffer
+is ticked in scan order, hence Tick() no longer needs to visit its incoming components, and it is
+unaffected by later wiring changes until it is rebound (or unbound via UnbindBuffer()). This allows
+a circuit to rewire its components while buffers are still ticking. Buffers must be bound in tick
+order, and whenever a buffer is bound without a component that the previous buffer ticks, that
+component's SkipBuffer() must be called for the buffer, so that it hands its in-order turn on to the
+next buffer that actually ticks it.
+
+Once scanned, Rank() returns how critical the component is to finishing a tick: its process time (a
+moving average, following changes in load while smoothing out the odd slow tick) plus that of its
+slowest chain of dependents. Components must hence be ranked in reverse scan order, after
+ResetRank() has been called on each. A component always outranks its dependents, so descending rank
+is also a valid scan order. Buffers bound in that order link each component to its dependents most
+critical first, and in TickMode::Parallel, a component that finishes processing carries on with its
+most critical dependent in the same thread.
+
+Source components (components that produce data on their own schedule, E.g. a camera or a file
+reader) should inform the circuit's auto-tick thread (provided via SetAutoTickThread()) of when they
+next need to be ticked. RequestTick_() requests a tick at a given time (now by default) and returns
+true if the circuit's AutoTickMode will honour it. PaceTick_() paces a source to a fixed period: it
+returns true if a period has passed since lastTick (advancing lastTick by that period), otherwise
+false once a tick has been requested for when the period is up. PaceTick_() never sleeps: where
+ticks are not requested (E.g. in AutoTickMode::FreeRunning), ticks before the period is up are
+skipped. In AutoTickMode::Batch, sources are not paced at all: PaceTick_() always returns true, and
+IsBatch_() tells a source to produce its data once through, as fast as the circuit processes it
+(E.g. a file reader ignoring its loop setting).
+
+A finite source declares itself via SetFiniteSource_() on construction, and marks the end of its
+data via SetEndOfStream_(), once it has output its last data. A source that fails (E.g. a file
+reader that can't open its file) ends its stream via SetStreamError_() instead, which
+GetStreamError() reports until the stream is restarted. IsEndOfStream() reports either to the
+circuit (see Circuit::IsEndOfStream()). Once the circuit has finished processing, Flush() calls
+Flush_(), which components that hold on to data across ticks (E.g. file writers) should override to
+write out and close whatever they hold.
+
+With more than one buffer, an InOrder component's buffers queue up behind one another whenever
+the component processes slower than the circuit ticks, increasing latency up to the full buffer
+depth. SetQueuePolicy() sets what happens to queued buffers: QueuePolicy::Block (default) processes
+every buffer in turn, QueuePolicy::LatestOnly skips a buffer whenever a newer one is already
+queued, and QueuePolicy::DropOldest skips a buffer whenever more than queueSize newer ones are
+already queued. A skipped buffer's Process_() is not called, leaving its outputs empty.
+
+A component whose outputs depend only on its inputs and its own settings can be evaluated on change
+via SetEvaluationMode(). In EvaluationMode::OnChange, a component keeps hold of the input values it
+last processed along with the outputs it produced from them. When a tick's input values are those
+very same (shared) values (see Signal::IsSharedWith()), and HasChanges_() reports no change to the
+component's own settings, Process_() is skipped and the held outputs are re-emitted instead. Since
+re-emitted outputs are the same shared values, OnChange components further downstream skip too. A
+component without inputs is always processed, but can re-emit its held outputs via ReuseOutputs_()
+when it has nothing new to output (E.g. a static image source). Ticks that produce no outputs are
+not held, and SetEnabled() always forces the next tick to be processed. As the input values are held
+from before Process_() is called, TakeMutable() on an OnChange component's inputs always copies. A
+component whose settings already track their own changes (E.g. a property set) can hand that check
+to SetChangeProbe_() on construction, rather than override HasChanges_().
+
+A component that processes a large frame row by row (E.g. per-pixel and stencil image filters) can
+be declared tileable via SetTileable_(), where halo is how many rows beyond its own a stripe of
+output reads from the input (0 for per-pixel operations). Within Process_(), ProcessTiles_() then
+splits the frame's rows into stripes and processes them concurrently on the circuit's thread pool,
+returning once every stripe is done. Each stripe should write straight into its rows of a shared,
+pre-allocated output, hence the stripes need no reassembly. Stripes are kept tall relative to the
+halo, and a component that is not tileable (or without a thread pool) processes all rows at once.
+
+GetTotalProcessCount() and GetTotalProcessTime() return how many times Process_() has been called
+and how long those calls took in total, and GetTotalOutputCount() how many of those calls output
+anything (E.g. how many frames a source has read). Sampling these periodically gives a component's
+recent call rate and mean process time.
+
+For a finer breakdown, GetMetrics() returns the Metrics of one buffer, or of all buffers combined:
+how many ticks the buffer took, how many of those reused held outputs or were dropped by the queue
+policy, and histograms of the time spent in Process_(), waiting for an InOrder turn, and waiting in
+Reset() for the tick to complete. Metrics are recorded lock-free as each tick runs, and subtracting
+an earlier GetMetrics() from a later one gives the metrics of the ticks in between. Changing the
+buffer count discards the metrics of removed buffers, and ResetMetrics() discards all of them.
+
+While the tracer provided via SetTracer() is tracing (see Circuit::StartTrace()), each Process_()
+call, InOrder wait and Reset() wait is also recorded as a span named after the component instance.
+
 <b>PERFORMANCE TIP:</b> If a component's Process_() method is capable of processing buffers
 out-of-order within a stream processing circuit, consider initialising its base with
 ProcessOrder::OutOfOrder to improve performance. Note however that Process_() must be thread-safe
@@ -89,6 +184,48 @@ public:
         Parallel
     };
 
+    enum class QueuePolicy
+    {
+        Block,
+        LatestOnly,
+        DropOldest
+    };
+
+    enum class EvaluationMode
+    {
+        Always,
+        OnChange
+    };
+
+    struct DLLEXPORT Histogram
+    {
+        static constexpr int bucketCount = 40;  // bucket i counts durations in [2^i, 2^(i+1)) ns (bucket 0 also counts 0)
+
+        int64_t count = 0;
+        std::chrono::nanoseconds total{ 0 };
+        std::chrono::nanoseconds max{ 0 };
+        std::array<int64_t, bucketCount> buckets{};
+
+        [[nodiscard]] std::chrono::nanoseconds Mean() const;
+        [[nodiscard]] std::chrono::nanoseconds Percentile( double percentile ) const;
+
+        void Add( Histogram const& other );
+        void Subtract( Histogram const& earlier );
+    };
+
+    struct DLLEXPORT Metrics
+    {
+        int64_t tickCount = 0;
+        int64_t reuseCount = 0;  // ticks that re-emitted held outputs in EvaluationMode::OnChange
+        int64_t dropCount = 0;   // ticks whose Process_() the queue policy skipped
+        Histogram processTime;
+        Histogram waitTime;  // waiting for an InOrder turn to process
+        Histogram syncTime;  // waiting in Reset() for the tick to complete
+
+        void Add( Metrics const& other );
+        void Subtract( Metrics const& earlier );
+    };
+
     explicit Component( ProcessOrder processOrder = ProcessOrder::InOrder );
     virtual ~Component();
 
@@ -98,6 +235,8 @@ public:
     void DisconnectInput( Component::SCPtr const& fromComponent );
     void DisconnectAllInputs();
 
+    [[nodiscard]] Component::SPtr GetInputComponent( int inputNo, int* fromOutput = nullptr ) const;
+
     [[nodiscard]] int GetInputCount() const;
     [[nodiscard]] int GetOutputCount() const;
 
@@ -119,6 +258,35 @@ public:
     void SetBufferCount( int bufferCount );
     [[nodiscard]] int GetBufferCount() const;
 
+    void SetQueuePolicy( QueuePolicy queuePolicy, int queueSize = 1 );
+    [[nodiscard]] QueuePolicy GetQueuePolicy() const;
+    [[nodiscard]] int GetQueueSize() const;
+
+    void SetEvaluationMode( EvaluationMode evaluationMode );
+    [[nodiscard]] EvaluationMode GetEvaluationMode() const;
+
+    [[nodiscard]] bool IsTileable() const;
+    [[nodiscard]] int GetTileHalo() const;
+
+    [[nodiscard]] ProcessOrder GetProcessOrder() const;
+
+    [[nodiscard]] bool IsFiniteSource() const;
+    [[nodiscard]] bool IsEndOfStream() const;
+    [[nodiscard]] std::string GetStreamError() const;
+    void Flush();
+
+    [[nodiscard]] int64_t GetTotalProcessCount() const;
+    [[nodiscard]] int64_t GetTotalOutputCount() const;
+    [[nodiscard]] std::chrono::nanoseconds GetTotalProcessTime() const;
+
+    [[nodiscard]] Metrics GetMetrics() const;
+    [[nodiscard]] Metrics GetMetrics( int bufferNo ) const;
+    void ResetMetrics();
+
+    void SetThreadPool( std::shared_ptr<internal::ThreadPool> const& threadPool );
+    void SetAutoTickThread( std::shared_ptr<internal::AutoTickThread> const& autoTickThread );
+    void SetTracer( std::shared_ptr<internal::Tracer> const& tracer );
+
     virtual bool HasGui(int interface) = 0;
     virtual void UpdateGui(void *context, int interface) = 0;
     virtual std::string GetState() = 0;
@@ -127,12 +295,39 @@ public:
     bool Tick( TickMode mode = TickMode::Parallel, int bufferNo = 0 );
     void Reset( int bufferNo = 0 );
 
+    int Scan( std::vector<std::vector<Component*>>& levels );
+    [[nodiscard]] bool IsScanOutdated() const;
+    void ResetScan();
+
+    int64_t Rank();
+    void ResetRank();
+
+    void BindBuffer( int bufferNo );
+    void UnbindBuffer( int bufferNo );
+    void SkipBuffer( int bufferNo );
+
 protected:
     virtual void Process_( SignalBus const&, SignalBus& ) = 0;
 
     void SetInputCount_( int inputCount, std::vector<std::string> const& inputNames = {}, std::vector<IoType> const& inputTypes = {} );
     void SetOutputCount_( int outputCount, std::vector<std::string> const& outputNames = {}, std::vector<IoType> const& outputTypes = {} );
 
+    bool RequestTick_( std::chrono::steady_clock::time_point when = std::chrono::steady_clock::now() );
+    bool PaceTick_( std::chrono::steady_clock::time_point& lastTick, std::chrono::steady_clock::duration period );
+    [[nodiscard]] bool IsBatch_() const;
+
+    void SetFiniteSource_( bool finiteSource = true );
+    void SetEndOfStream_( bool endOfStream = true );
+    void SetStreamError_( std::string const& error );
+    virtual void Flush_();
+
+    virtual bool HasChanges_();
+    void SetChangeProbe_( std::function<bool()> const& hasChanges );
+    bool ReuseOutputs_( SignalBus& outputs );
+
+    void SetTileable_( bool tileable, int halo = 0 );
+    void ProcessTiles_( int rowCount, std::function<void( int firstRow, int lastRow )> const& processTile );
+
     void SetComponentName_(std::string component_name);
     void SetComponentCategory_(Category component_category);
     void SetComponentAuthor_(std::string component_author);
@@ -30,9 +30,40 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <dspatch/Common.h>
 
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
 namespace DSPatch
 {
 
+/// Customisation point for Signal::TakeMutable()
+
+/**
+By default, a value is taken to be independent of any other value, hence a copy of it (via its
+copy constructor) is safe to modify. Types that are handles to reference counted data (E.g.
+cv::Mat) should specialise MutableValue, such that IsExclusive() reports whether the handle is the
+only reference to its data, and Copy() returns a deep copy. A specialisation must be visible
+wherever TakeMutable() is called for its type.
+*/
+
+template <class ValueType>
+struct MutableValue
+{
+    static bool IsExclusive( ValueType const& )
+    {
+        return true;
+    }
+
+    static ValueType Copy( ValueType const& value )
+    {
+        return value;
+    }
+};
+
 /// Value container used to carry data between components
 
 /**
@@ -43,6 +74,25 @@ designed such that a signal bus can hold any number of different typed variables
 allow for a variable to dynamically change it's type when needed - this can be useful for inputs
 that accept a number of different data types (E.g. Varying sample size in an audio buffer: array of
 byte / int / float).
+
+A signal's value can be shared between any number of signals via ShareSignal(). Shared values are
+reference counted, hence passing one value on to many signals costs just an atomic increment per
+signal, rather than a copy. A shared value must be treated as immutable: setting a new value on a
+signal that shares its value first detaches it (copy-on-write), leaving the other signals
+unaffected. Hence, a signal that still shares its value with another (see IsSharedWith()) is known
+to hold exactly the value it was shared, making this a cheap check for whether a value has changed.
+
+Values are stored inline within a signal's value holder when small enough (this covers every FlowCV
+IoType, cv::Mat being the largest), and are identified by an integer type tag. Hence, once a
+signal's value holder has been allocated, setting values of any of these types (even when the type
+changes from one value to the next) requires no further heap allocation.
+
+GetValue() returns the signal's value as it is, shared or not, hence a value must not be modified
+through it unless the signal is known to hold the only reference to it (E.g. a component's own
+output before it is shared). TakeMutable() returns the signal's value for modifying in place. When
+the value is still shared with other signals (or, per MutableValue, with other values), the signal
+is first given a copy of its own. Hence a component that modifies its input (E.g. draws onto a
+frame) only pays for a copy when some other component still needs to see the input unmodified.
 */
 
 class DLLEXPORT Signal final
@@ -60,58 +110,104 @@ public:
     ValueType* GetValue();
 
     template <class ValueType>
-    void SetValue( ValueType const& newValue );
+    void SetValue( ValueType&& newValue );
+
+    template <class ValueType>
+    ValueType* TakeMutable();
 
     bool CopySignal( Signal::SPtr const& fromSignal );
     bool MoveSignal( Signal::SPtr const& fromSignal );
+    bool ShareSignal( Signal::SPtr const& fromSignal );
+
+    [[nodiscard]] bool IsSharedWith( Signal::SPtr const& signal ) const;
 
     void ClearValue();
 
     [[nodiscard]] std::type_info const& GetType() const;
 
 private:
-    struct _ValueHolder
-    {
-        NONCOPYABLE( _ValueHolder );
-
-        _ValueHolder() = default;
-        virtual ~_ValueHolder() = default;
+    static constexpr size_t _inlineSize = 96;
 
-        virtual std::type_info const& GetType() const = 0;
-        virtual _ValueHolder* GetCopy() const = 0;
-        virtual void SetValue( _ValueHolder* valueHolder ) = 0;
+    struct _Type final
+    {
+        uint64_t tag;
+        std::type_info const& info;
+        void ( *destroy )( void* storage );
+        void ( *copy )( void* storage, void const* fromStorage );
+        void ( *assign )( void* storage, void const* fromStorage );
     };
 
     template <class ValueType>
-    struct _Value final : _ValueHolder
+    struct _Storage final
     {
-        NONCOPYABLE( _Value );
+        static constexpr bool isInline = sizeof( ValueType ) <= _inlineSize && alignof( ValueType ) <= alignof( std::max_align_t );
 
-        _Value( ValueType const& value )
-            : value( value )
-            , type( typeid( ValueType ) )
+        static ValueType* Get( void const* storage )
         {
+            if constexpr ( isInline )
+            {
+                return (ValueType*)storage;
+            }
+            else
+            {
+                return *(ValueType* const*)storage;
+            }
         }
 
-        virtual std::type_info const& GetType() const override
+        template <class... Args>
+        static void Construct( void* storage, Args&&... args )
         {
-            return type;
+            if constexpr ( isInline )
+            {
+                new ( storage ) ValueType( std::forward<Args>( args )... );
+            }
+            else
+            {
+                *(ValueType**)storage = new ValueType( std::forward<Args>( args )... );
+            }
         }
 
-        virtual _ValueHolder* GetCopy() const override
+        static void Destroy( void* storage )
         {
-            return new _Value( value );
+            if constexpr ( isInline )
+            {
+                Get( storage )->~ValueType();
+            }
+            else
+            {
+                delete Get( storage );
+            }
         }
+    };
 
-        virtual void SetValue( _ValueHolder* valueHolder ) override
+    struct _ValueHolder final
+    {
+        NONCOPYABLE( _ValueHolder );
+
+        _ValueHolder() = default;
+
+        ~_ValueHolder()
         {
-            value = ( (_Value<ValueType>*)valueHolder )->value;
+            if ( type != nullptr )
+            {
+                type->destroy( storage );
+            }
         }
 
-        ValueType value;
-        std::type_info const& type;
+        std::atomic<int> refCount{ 1 };
+        _Type const* type = nullptr;
+        alignas( std::max_align_t ) unsigned char storage[_inlineSize];
     };
 
+    template <class ValueType>
+    static _Type const& _TypeOf();
+
+    static uint64_t _MakeTag( char const* typeName );
+
+    bool _IsShared() const;
+    void _ReleaseValue();
+    void* _ClearHolder();
+
     _ValueHolder* _valueHolder = nullptr;
     bool _hasValue = false;
 };
@@ -122,14 +218,14 @@ ValueType* Signal::GetValue()
     // You might be thinking: Why the raw pointer return here?
 
     // This is mainly for performance, and partly for readability. Performance, because returning a
-    // shared_ptr here means having to store the value as a shared_ptr in Signal::_Value too. This
-    // adds yet another level of indirection to the value, as well as some reference counting
+    // shared_ptr here means having to store the value as a shared_ptr in Signal::_ValueHolder too.
+    // This adds yet another level of indirection to the value, as well as some reference counting
     // overhead. These Get() and Set() methods are VERY frequently called, so doing as little as
     // possible with the data here is best, which actually aids in the readably of the code too.
 
-    if ( _hasValue && GetType() == typeid( ValueType ) )
+    if ( _hasValue && _valueHolder->type->tag == _TypeOf<ValueType>().tag )
     {
-        return &( (_Value<ValueType>*)_valueHolder )->value;
+        return _Storage<ValueType>::Get( _valueHolder->storage );
     }
     else
     {
@@ -138,18 +234,58 @@ ValueType* Signal::GetValue()
 }
 
 template <class ValueType>
-void Signal::SetValue( ValueType const& newValue )
+void Signal::SetValue( ValueType&& newValue )
 {
-    if ( GetType() == typeid( ValueType ) )
+    using Type = typename std::decay<ValueType>::type;
+
+    auto const& type = _TypeOf<Type>();
+
+    if ( _valueHolder != nullptr && _valueHolder->type != nullptr && _valueHolder->type->tag == type.tag && !_IsShared() )
     {
-        ( (_Value<ValueType>*)_valueHolder )->value = newValue;
+        *_Storage<Type>::Get( _valueHolder->storage ) = std::forward<ValueType>( newValue );
     }
     else
     {
-        delete _valueHolder;
-        _valueHolder = new _Value<ValueType>( newValue );
+        _Storage<Type>::Construct( _ClearHolder(), std::forward<ValueType>( newValue ) );
+        _valueHolder->type = &type;
     }
     _hasValue = true;
 }
 
+template <class ValueType>
+ValueType* Signal::TakeMutable()
+{
+    auto value = GetValue<ValueType>();
+
+    if ( value != nullptr && ( _IsShared() || !MutableValue<ValueType>::IsExclusive( *value ) ) )
+    {
+        // SetValue() detaches this signal from a shared value before setting the copy
+        SetValue( MutableValue<ValueType>::Copy( *value ) );
+        value = GetValue<ValueType>();
+    }
+
+    return value;
+}
+
+template <class ValueType>
+Signal::_Type const& Signal::_TypeOf()
+{
+    // You might be thinking: Why not just compare type_info addresses?
+
+    // Because each plugin carries its own copy of the type_info objects it uses, type_info addresses
+    // differ across module boundaries, and type_info::operator==() falls back to a string compare.
+    // A tag derived from the type's (mangled) name on the other hand is the same in every module,
+    // and is computed just once per type, per module.
+
+    static _Type const type{ _MakeTag( typeid( ValueType ).name() ), typeid( ValueType ),
+                             []( void* storage ) { _Storage<ValueType>::Destroy( storage ); },
+                             []( void* storage, void const* fromStorage ) {
+                                 _Storage<ValueType>::Construct( storage, *_Storage<ValueType>::Get( fromStorage ) );
+                             },
+                             []( void* storage, void const* fromStorage ) {
+                                 *_Storage<ValueType>::Get( storage ) = *_Storage<ValueType>::Get( fromStorage );
+                             } };
+    return type;
+}
+
 }  // namespace DSPatch
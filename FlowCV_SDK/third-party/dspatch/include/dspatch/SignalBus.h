@@ -47,6 +47,13 @@ A SignalBus contains Signals (see Signal). Via the Process_() method, a Componen
 into it's "inputs" SignalBus and provides signals to it's "outputs" SignalBus. The SignalBus class
 provides public getters and setters for manipulating it's internal Signal values directly,
 abstracting the need to retrieve and interface with the contained Signals themself.
+
+A component's inputs share their values with the outputs they are wired to, and so with every other
+component wired to those outputs. Hence GetValue() on a const bus (as Process_() receives its
+inputs) returns a const value, and an input must be taken via TakeMutable() to be modified in place
+(see Signal::TakeMutable()). A circuit lets go of an output once every component wired to it has
+fetched it (unless it is fed back), hence a component that is the only consumer of an input can
+usually modify it without any copy at all.
 */
 
 class DLLEXPORT SignalBus final
@@ -67,13 +74,20 @@ public:
     [[nodiscard]] bool HasValue( int signalIndex ) const;
 
     template <class ValueType>
-    ValueType* GetValue( int signalIndex ) const;
+    ValueType const* GetValue( int signalIndex ) const;
+
+    template <class ValueType>
+    ValueType* GetValue( int signalIndex );
 
     template <class ValueType>
-    bool SetValue( int signalIndex, ValueType const& newValue );
+    bool SetValue( int signalIndex, ValueType&& newValue );
+
+    template <class ValueType>
+    ValueType* TakeMutable( int signalIndex ) const;
 
     bool CopySignal( int toSignalIndex, Signal::SPtr const& fromSignal );
     bool MoveSignal( int toSignalIndex, Signal::SPtr const& fromSignal );
+    bool ShareSignal( int toSignalIndex, Signal::SPtr const& fromSignal );
 
     void ClearAllValues();
 
@@ -86,7 +100,20 @@ private:
 };
 
 template <class ValueType>
-ValueType* SignalBus::GetValue( int signalIndex ) const
+ValueType const* SignalBus::GetValue( int signalIndex ) const
+{
+    if ( (size_t)signalIndex < _signals.size() )
+    {
+        return _signals[signalIndex]->GetValue<ValueType>();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+template <class ValueType>
+ValueType* SignalBus::GetValue( int signalIndex )
 {
     if ( (size_t)signalIndex < _signals.size() )
     {
@@ -99,11 +126,11 @@ ValueType* SignalBus::GetValue( int signalIndex ) const
 }
 
 template <class ValueType>
-bool SignalBus::SetValue( int signalIndex, ValueType const& newValue )
+bool SignalBus::SetValue( int signalIndex, ValueType&& newValue )
 {
     if ( (size_t)signalIndex < _signals.size() )
     {
-        _signals[signalIndex]->SetValue( newValue );
+        _signals[signalIndex]->SetValue( std::forward<ValueType>( newValue ) );
         return true;
     }
     else
@@ -112,4 +139,17 @@ bool SignalBus::SetValue( int signalIndex, ValueType const& newValue )
     }
 }
 
+template <class ValueType>
+ValueType* SignalBus::TakeMutable( int signalIndex ) const
+{
+    if ( (size_t)signalIndex < _signals.size() )
+    {
+        return _signals[signalIndex]->TakeMutable<ValueType>();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
 }  // namespace DSPatch
@@ -30,25 +30,121 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <internal/AutoTickThread.h>
 #include <internal/CircuitThread.h>
+#include <internal/ThreadPool.h>
+#include <internal/Tracer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace DSPatch;
 
+namespace
+{
+
+int const rankInterval = 64;        // ticks between re-ranking a circuit's components
+double const rerankThreshold = 0.25;  // relative change in a component's rank that calls for rescheduling
+
+}  // namespace
+
 namespace DSPatch
 {
 namespace internal
 {
 
+class CircuitTransaction
+{
+public:
+    enum class Action
+    {
+        AddComponent,
+        RemoveComponent,
+        RemoveAllComponents,
+        ConnectOutToIn,
+        DisconnectInput
+    };
+
+    struct Edit
+    {
+        Action action;
+        DSPatch::Component::SPtr addedComponent;
+        DSPatch::Component::SCPtr component;  // the removed component, or the component whose input is (dis)connected
+        DSPatch::Component::SCPtr fromComponent;
+        int fromOutput;
+        int toInput;
+    };
+
+    std::vector<Edit> edits;
+    bool allowFeedback = true;
+};
+
 class Circuit
 {
 public:
+    struct Plan
+    {
+        std::vector<DSPatch::Component::SPtr> components;  // keeps components alive while still ticked
+        std::vector<DSPatch::Component*> schedule;         // components in topological order
+    };
+
+    // components and wiring as a transaction would leave them
+    struct Model
+    {
+        struct Source
+        {
+            DSPatch::Component const* component = nullptr;
+            int64_t generation = 0;  // a wire from a component that has since been removed (and re-added) is stale
+            int fromOutput = 0;
+        };
+
+        struct Node
+        {
+            DSPatch::Component::SPtr component;
+            int64_t generation;  // also orders components as they would be added
+            std::vector<Source> inputs;
+        };
+
+        [[nodiscard]] bool IsConnected( Source const& source ) const;
+
+        std::unordered_map<DSPatch::Component const*, Node> nodes;
+        int64_t nextGeneration = 0;
+    };
+
     bool FindComponent( DSPatch::Component::SCPtr const& component, int& returnIndex ) const;
 
+    void BuildModel( Model& model ) const;
+    bool ApplyToModel( CircuitTransaction const& transaction, Model& model, std::string* error ) const;
+    void CommitModel( Model const& model );
+
+    void Changed();
+    void Compile();
+    void Rank( bool force );
+    void BindBuffer( int bufferNo );
+    void UnbindBuffers();
+    void ReleaseRemovedComponents();
+
     int pauseCount = 0;
+    std::atomic<int64_t> totalTicks{ 0 };
     int currentThreadNo = 0;
 
-    AutoTickThread autoTickThread;
+    AutoTickThread::SPtr autoTickThread = std::make_shared<AutoTickThread>();
+
+    ThreadPool::SPtr threadPool;
 
+    Tracer::SPtr tracer = std::make_shared<Tracer>();
+
+    std::mutex editMutex;  // guards components (and their wiring) against Compile() and BindBuffer()
     std::vector<DSPatch::Component::SPtr> components;
+    std::unordered_map<DSPatch::Component const*, int> componentIndices;  // index of each component in components
+    std::vector<DSPatch::Component::SPtr> removedComponents;  // removed, but possibly still ticked
+
+    std::atomic<bool> changed{ true };
+    std::shared_ptr<Plan> plan = std::make_shared<Plan>();
+    std::unordered_map<DSPatch::Component const*, int64_t> scheduledRanks;  // ranks the plan was last scheduled by
+    std::vector<std::shared_ptr<Plan>> bufferPlans = std::vector<std::shared_ptr<Plan>>( 1 );  // plan bound to each buffer
 
     std::vector<CircuitThread::UPtr> circuitThreads;
 };
@@ -56,9 +152,57 @@ public:
 }  // namespace internal
 }  // namespace DSPatch
 
+CircuitTransaction::CircuitTransaction()
+    : p( new internal::CircuitTransaction() )
+{
+}
+
+CircuitTransaction::~CircuitTransaction() = default;
+
+void CircuitTransaction::AddComponent( Component::SPtr const& component )
+{
+    p->edits.push_back( { internal::CircuitTransaction::Action::AddComponent, component, component, nullptr, 0, 0 } );
+}
+
+void CircuitTransaction::RemoveComponent( Component::SCPtr const& component )
+{
+    p->edits.push_back( { internal::CircuitTransaction::Action::RemoveComponent, nullptr, component, nullptr, 0, 0 } );
+}
+
+void CircuitTransaction::RemoveAllComponents()
+{
+    p->edits.push_back( { internal::CircuitTransaction::Action::RemoveAllComponents, nullptr, nullptr, nullptr, 0, 0 } );
+}
+
+void CircuitTransaction::ConnectOutToIn( Component::SCPtr const& fromComponent, int fromOutput, Component::SCPtr const& toComponent, int toInput )
+{
+    p->edits.push_back( { internal::CircuitTransaction::Action::ConnectOutToIn, nullptr, toComponent, fromComponent, fromOutput, toInput } );
+}
+
+void CircuitTransaction::DisconnectInput( Component::SCPtr const& component, int inputNo )
+{
+    p->edits.push_back( { internal::CircuitTransaction::Action::DisconnectInput, nullptr, component, nullptr, 0, inputNo } );
+}
+
+void CircuitTransaction::SetAllowFeedback( bool allowFeedback )
+{
+    p->allowFeedback = allowFeedback;
+}
+
+bool CircuitTransaction::IsEmpty() const
+{
+    return p->edits.empty();
+}
+
 Circuit::Circuit()
+    : Circuit( NewThreadPool() )
+{
+}
+
+Circuit::Circuit( std::shared_ptr<internal::ThreadPool> const& threadPool )
     : p( new internal::Circuit() )
 {
+    p->threadPool = threadPool != nullptr ? threadPool : NewThreadPool();
 }
 
 Circuit::~Circuit()
@@ -66,6 +210,9 @@ Circuit::~Circuit()
     StopAutoTick();
     SetBufferCount( 0 );
     RemoveAllComponents();
+
+    std::lock_guard<std::mutex> lock( p->editMutex );
+    p->UnbindBuffers();
 }
 
 int Circuit::AddComponent( Component::SPtr const& component )
@@ -79,12 +226,32 @@ int Circuit::AddComponent( Component::SPtr const& component )
             return componentIndex;  // if the component is already in the array
         }
 
-        // components within the circuit need to have as many buffers as there are threads in the circuit
-        component->SetBufferCount( p->circuitThreads.size() );
+        std::lock_guard<std::mutex> lock( p->editMutex );
 
-        PauseAutoTick();
+        auto removedComponent = std::find( p->removedComponents.begin(), p->removedComponents.end(), component );
+        if ( removedComponent != p->removedComponents.end() )
+        {
+            // the component was removed, but is still ticked by some buffers, so it is still set up
+            p->removedComponents.erase( removedComponent );
+        }
+        else
+        {
+            // components within the circuit need to have as many buffers as there are threads in the circuit
+            component->SetBufferCount( p->circuitThreads.size() );
+
+            // components within the circuit share the circuit's thread pool
+            component->SetThreadPool( p->threadPool );
+
+            // components within the circuit may request ticks from the circuit's auto-tick thread
+            component->SetAutoTickThread( p->autoTickThread );
+
+            // components within the circuit record spans to the circuit's tracer
+            component->SetTracer( p->tracer );
+        }
+
+        p->componentIndices[component.get()] = p->components.size();
         p->components.emplace_back( component );
-        ResumeAutoTick();
+        p->Changed();
 
         return p->components.size() - 1;
     }
@@ -104,24 +271,50 @@ void Circuit::RemoveComponent( Component::SCPtr const& component )
 
 void Circuit::RemoveComponent( int componentIndex )
 {
-    PauseAutoTick();
+    if ( (size_t)componentIndex >= p->components.size() )
+    {
+        return;
+    }
 
     DisconnectComponent( componentIndex );
 
-    if ( !p->components.empty() )
+    std::lock_guard<std::mutex> lock( p->editMutex );
+
+    // buffers still bound to a plan containing the component will keep ticking it until rebound
+    p->removedComponents.emplace_back( p->components[componentIndex] );
+    p->componentIndices.erase( p->components[componentIndex].get() );
+    p->components.erase( p->components.begin() + componentIndex );
+    for ( size_t i = componentIndex; i < p->components.size(); ++i )
     {
-        p->components.erase( p->components.begin() + componentIndex );
+        p->componentIndices[p->components[i].get()] = i;
     }
+    p->Changed();
 
-    ResumeAutoTick();
+    p->ReleaseRemovedComponents();
 }
 
 void Circuit::RemoveAllComponents()
 {
-    for ( size_t i = 0; i < p->components.size(); ++i )
+    // You might be thinking: Why not just RemoveComponent() each component in turn?
+
+    // Each removal disconnects the component from every other component, and re-indexes those after
+    // it, making a large circuit slow to clear. Removing all of them at once only needs each
+    // component's own inputs disconnected.
+
+    std::lock_guard<std::mutex> lock( p->editMutex );
+
+    for ( auto& component : p->components )
     {
-        RemoveComponent( i-- );  // size drops as one is removed
+        component->DisconnectAllInputs();
     }
+
+    // buffers still bound to a plan containing the components will keep ticking them until rebound
+    p->removedComponents.insert( p->removedComponents.end(), p->components.begin(), p->components.end() );
+    p->components.clear();
+    p->componentIndices.clear();
+    p->Changed();
+
+    p->ReleaseRemovedComponents();
 }
 
 int Circuit::GetComponentCount() const
@@ -170,9 +363,9 @@ bool Circuit::ConnectOutToIn( int fromComponent, int fromOutput, int toComponent
         return false;
     }
 
-    PauseAutoTick();
+    std::lock_guard<std::mutex> lock( p->editMutex );
     bool result = p->components[toComponent]->ConnectInput( p->components[fromComponent], fromOutput, toInput );
-    ResumeAutoTick();
+    p->Changed();
 
     return result;
 }
@@ -189,7 +382,12 @@ void Circuit::DisconnectComponent( Component::SCPtr const& component )
 
 void Circuit::DisconnectComponent( int componentIndex )
 {
-    PauseAutoTick();
+    if ( (size_t)componentIndex >= p->components.size() )
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock( p->editMutex );
 
     // remove component from _inputComponents and _inputWires
     p->components[componentIndex]->DisconnectAllInputs();
@@ -200,7 +398,105 @@ void Circuit::DisconnectComponent( int componentIndex )
         component->DisconnectInput( p->components[componentIndex] );
     }
 
-    ResumeAutoTick();
+    p->Changed();
+}
+
+void Circuit::DisconnectInput( Component::SCPtr const& component, int inputNo )
+{
+    int componentIndex;
+
+    if ( p->FindComponent( component, componentIndex ) )
+    {
+        DisconnectInput( componentIndex, inputNo );
+    }
+}
+
+void Circuit::DisconnectInput( int componentIndex, int inputNo )
+{
+    if ( (size_t)componentIndex >= p->components.size() )
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock( p->editMutex );
+    p->components[componentIndex]->DisconnectInput( inputNo );
+    p->Changed();
+}
+
+bool Circuit::Validate( CircuitTransaction const& transaction, std::string* error ) const
+{
+    std::lock_guard<std::mutex> lock( p->editMutex );
+
+    internal::Circuit::Model model;
+    p->BuildModel( model );
+    return p->ApplyToModel( *transaction.p, model, error );
+}
+
+bool Circuit::CanConnectOutToIn( Component::SCPtr const& fromComponent,
+                                 int fromOutput,
+                                 Component::SCPtr const& toComponent,
+                                 int toInput,
+                                 std::string* error )
+{
+    auto fail = [error]( std::string const& message ) {
+        if ( error != nullptr )
+        {
+            *error = message;
+        }
+        return false;
+    };
+
+    if ( fromComponent == nullptr || toComponent == nullptr )
+    {
+        return fail( "Cannot wire a null component" );
+    }
+    if ( fromOutput < 0 || fromOutput >= fromComponent->GetOutputCount() )
+    {
+        return fail( fromComponent->GetComponentName() + " has no output " + std::to_string( fromOutput ) );
+    }
+    if ( toInput < 0 || toInput >= toComponent->GetInputCount() )
+    {
+        return fail( toComponent->GetComponentName() + " has no input " + std::to_string( toInput ) );
+    }
+
+    IoType fromType = fromComponent->GetOutputType( fromOutput );
+    IoType toType = toComponent->GetInputType( toInput );
+    if ( fromType != toType && fromType != IoType::Io_Type_Unspecified && toType != IoType::Io_Type_Unspecified )
+    {
+        return fail( "Output " + std::to_string( fromOutput ) + " of " + fromComponent->GetComponentName() + " does not match the type of input " +
+                     std::to_string( toInput ) + " of " + toComponent->GetComponentName() );
+    }
+
+    return true;
+}
+
+bool Circuit::Commit( CircuitTransaction const& transaction, std::string* error )
+{
+    if ( transaction.IsEmpty() )
+    {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock( p->editMutex );
+
+    // You might be thinking: Why not just call AddComponent(), ConnectOutToIn(), etc. for each edit?
+
+    // Each of those is a separate change to the circuit, hence a running circuit may tick (and
+    // compile a plan for) any partly applied state of the transaction, and an invalid edit part way
+    // through would leave the circuit half edited. Applying the edits to a model of the circuit
+    // first validates the whole transaction, then the circuit is changed to match the model in one
+    // step, under one lock.
+
+    internal::Circuit::Model model;
+    p->BuildModel( model );
+    if ( !p->ApplyToModel( *transaction.p, model, error ) )
+    {
+        return false;
+    }
+
+    p->CommitModel( model );
+
+    return true;
 }
 
 void Circuit::SetBufferCount( int bufferCount )
@@ -215,6 +511,12 @@ void Circuit::SetBufferCount( int bufferCount )
             circuitThread->Stop();
         }
 
+        std::lock_guard<std::mutex> lock( p->editMutex );
+
+        // unbind all buffers (components are about to be resized)
+        p->UnbindBuffers();
+        p->bufferPlans.resize( bufferCount > 0 ? bufferCount : 1 );
+
         // resize thread array
         p->circuitThreads.resize( bufferCount );
 
@@ -225,7 +527,7 @@ void Circuit::SetBufferCount( int bufferCount )
             {
                 p->circuitThreads[i] = std::unique_ptr<internal::CircuitThread>( new internal::CircuitThread() );
             }
-            p->circuitThreads[i]->Start( &p->components, i );
+            p->circuitThreads[i]->Start( i, p->tracer );
         }
 
         // set all components to the new buffer count
@@ -243,39 +545,99 @@ int Circuit::GetBufferCount() const
     return p->circuitThreads.size();
 }
 
+int64_t Circuit::GetTotalTicks() const
+{
+    return p->totalTicks;
+}
+
 void Circuit::Tick( Component::TickMode mode )
 {
+    // You might be thinking: Why not sync all threads and recompile the plan as soon as the circuit changes?
+
+    // That would stall the circuit until every buffer in flight is done. Instead, each buffer is
+    // bound to the latest plan at its own tick boundary, while the others finish their ticks under
+    // the plan they were bound to.
+
+    // components rewired directly (rather than via the circuit) outdate the plan too
+    if ( !p->changed && p->plan != nullptr )
+    {
+        for ( auto const& component : p->plan->components )
+        {
+            if ( component->IsScanOutdated() )
+            {
+                p->changed = true;
+                break;
+            }
+        }
+    }
+
+    // bind this buffer to the latest plan if the circuit has changed since it was bound
+    // ==================================================================================
+    if ( p->changed || p->bufferPlans[p->currentThreadNo] != p->plan )
+    {
+        // wait for this buffer's previous tick to complete
+        if ( !p->circuitThreads.empty() )
+        {
+            p->circuitThreads[p->currentThreadNo]->Sync();
+        }
+
+        std::lock_guard<std::mutex> lock( p->editMutex );
+
+        if ( p->changed )
+        {
+            p->Compile();
+            p->Rank( true );
+        }
+
+        p->BindBuffer( p->currentThreadNo );
+    }
+    // re-rank components every so often, as their process times settle or change
+    else if ( p->totalTicks % rankInterval == 0 )
+    {
+        std::lock_guard<std::mutex> lock( p->editMutex );
+
+        p->Rank( false );
+    }
+
     // process in a single thread if this circuit has no threads
     // =========================================================
     if ( p->circuitThreads.empty() )
     {
+        auto const& schedule = p->bufferPlans[0]->schedule;
+        auto tickStart = std::chrono::steady_clock::now();
+
         // tick all internal components
-        for ( auto& component : p->components )
+        for ( auto component : schedule )
         {
             component->Tick( mode );
         }
 
         // reset all internal components
-        for ( auto& component : p->components )
+        for ( auto component : schedule )
         {
             component->Reset();
         }
+
+        p->tracer->Record( "Tick", "circuit", 0, tickStart, std::chrono::steady_clock::now() );
     }
     // process in multiple threads if this circuit has threads
     // =======================================================
     else
     {
-        p->circuitThreads[p->currentThreadNo]->SyncAndResume( mode );  // sync and resume thread x
+        // sync and resume thread x
+        p->circuitThreads[p->currentThreadNo]->SyncAndResume( mode, &p->bufferPlans[p->currentThreadNo]->schedule );
 
         p->currentThreadNo = p->currentThreadNo + 1 == (int)p->circuitThreads.size() ? 0 : p->currentThreadNo + 1;
     }
+
+    ++p->totalTicks;
 }
 
 void Circuit::StartAutoTick( Component::TickMode mode )
 {
-    if ( p->autoTickThread.IsStopped() )
+    if ( p->autoTickThread->IsStopped() )
     {
-        p->autoTickThread.Start( this, mode );
+        p->autoTickThread->Start( this, mode );
     }
     else
     {
@@ -285,14 +647,14 @@ void Circuit::StartAutoTick( Component::TickMode mode )
 
 void Circuit::StopAutoTick()
 {
-    if ( !p->autoTickThread.IsStopped() )
+    if ( !p->autoTickThread->IsStopped() )
     {
-        p->autoTickThread.Stop();
+        p->autoTickThread->Stop();
 
         // manually tick until 0
         while ( p->currentThreadNo != 0 )
         {
-            Tick( p->autoTickThread.Mode() );
+            Tick( p->autoTickThread->Mode() );
         }
 
         // sync all threads
@@ -303,21 +665,57 @@ void Circuit::StopAutoTick()
     }
 }
 
+std::shared_ptr<internal::ThreadPool> Circuit::NewThreadPool( int threadCount )
+{
+    return std::make_shared<internal::ThreadPool>( threadCount );
+}
+
+void Circuit::ShareThreadPool( Circuit const& circuit )
+{
+    if ( &circuit == this || circuit.p->threadPool == p->threadPool )
+    {
+        return;
+    }
+
+    PauseAutoTick();
+
+    // buffers in flight submit their tasks to the thread pool they were started with
+    for ( auto& circuitThread : p->circuitThreads )
+    {
+        circuitThread->Sync();
+    }
+
+    std::lock_guard<std::mutex> lock( p->editMutex );
+
+    p->threadPool = circuit.p->threadPool;
+
+    for ( auto& component : p->components )
+    {
+        component->SetThreadPool( p->threadPool );
+    }
+    for ( auto& component : p->removedComponents )
+    {
+        component->SetThreadPool( p->threadPool );
+    }
+
+    ResumeAutoTick();
+}
+
 void Circuit::PauseAutoTick()
 {
-    if ( p->autoTickThread.IsStopped() )
+    if ( p->autoTickThread->IsStopped() )
     {
         return;
     }
 
-    if ( ++p->pauseCount == 1 && !p->autoTickThread.IsPaused() )
+    if ( ++p->pauseCount == 1 && !p->autoTickThread->IsPaused() )
     {
-        p->autoTickThread.Pause();
+        p->autoTickThread->Pause();
 
         // manually tick until 0
         while ( p->currentThreadNo != 0 )
         {
-            Tick( p->autoTickThread.Mode() );
+            Tick( p->autoTickThread->Mode() );
         }
 
         // sync all threads
@@ -330,22 +728,542 @@ void Circuit::PauseAutoTick()
 
 void Circuit::ResumeAutoTick()
 {
-    if ( p->autoTickThread.IsPaused() && --p->pauseCount == 0 )
+    if ( p->autoTickThread->IsPaused() && --p->pauseCount == 0 )
     {
-        p->autoTickThread.Resume();
+        p->autoTickThread->Resume();
     }
 }
 
-bool internal::Circuit::FindComponent( DSPatch::Component::SCPtr const& component, int& returnIndex ) const
+void Circuit::SetAutoTickMode( AutoTickMode autoTickMode, double tickRate )
 {
-    for ( size_t i = 0; i < components.size(); ++i )
+    p->autoTickThread->SetAutoTickMode( autoTickMode, tickRate );
+}
+
+Circuit::AutoTickMode Circuit::GetAutoTickMode() const
+{
+    return p->autoTickThread->GetAutoTickMode();
+}
+
+double Circuit::GetAutoTickRate() const
+{
+    return p->autoTickThread->GetAutoTickRate();
+}
+
+bool Circuit::CanEndStream() const
+{
+    std::lock_guard<std::mutex> lock( p->editMutex );
+
+    for ( auto& component : p->components )
     {
-        if ( components[i] == component )
+        if ( component->IsFiniteSource() )
         {
-            returnIndex = i;
             return true;
         }
     }
 
     return false;
 }
+
+bool Circuit::IsEndOfStream() const
+{
+    std::lock_guard<std::mutex> lock( p->editMutex );
+
+    for ( auto& component : p->components )
+    {
+        if ( component->IsEndOfStream() )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Circuit::Flush()
+{
+    std::lock_guard<std::mutex> lock( p->editMutex );
+
+    if ( p->changed )
+    {
+        p->Compile();
+        p->Rank( true );
+    }
+
+    for ( auto component : p->plan->schedule )
+    {
+        component->Flush();
+    }
+}
+
+void Circuit::StartTrace( int64_t maxEvents )
+{
+    p->tracer->Start( maxEvents );
+}
+
+void Circuit::StopTrace()
+{
+    p->tracer->Stop();
+}
+
+void Circuit::WriteTrace( std::ostream& out ) const
+{
+    p->tracer->Write( out );
+}
+
+bool Circuit::IsTraceTruncated() const
+{
+    return p->tracer->IsTruncated();
+}
+
+bool internal::Circuit::FindComponent( DSPatch::Component::SCPtr const& component, int& returnIndex ) const
+{
+    auto componentIndex = componentIndices.find( component.get() );
+    if ( componentIndex == componentIndices.end() )
+    {
+        return false;
+    }
+
+    returnIndex = componentIndex->second;
+    return true;
+}
+
+bool internal::Circuit::Model::IsConnected( Source const& source ) const
+{
+    auto node = nodes.find( source.component );
+    return node != nodes.end() && node->second.generation == source.generation;
+}
+
+void internal::Circuit::BuildModel( Model& model ) const
+{
+    model.nodes.clear();
+    model.nodes.reserve( components.size() );
+    model.nextGeneration = components.size();
+
+    for ( size_t i = 0; i < components.size(); ++i )
+    {
+        model.nodes[components[i].get()] = { components[i], (int64_t)i, {} };
+    }
+
+    for ( auto& node : model.nodes )
+    {
+        auto& component = node.second.component;
+        node.second.inputs.resize( component->GetInputCount() );
+        for ( int i = 0; i < component->GetInputCount(); ++i )
+        {
+            int fromOutput;
+            auto fromComponent = component->GetInputComponent( i, &fromOutput );
+            auto fromNode = fromComponent != nullptr ? model.nodes.find( fromComponent.get() ) : model.nodes.end();
+            if ( fromNode != model.nodes.end() )
+            {
+                node.second.inputs[i] = { fromComponent.get(), fromNode->second.generation, fromOutput };
+            }
+        }
+    }
+}
+
+bool internal::Circuit::ApplyToModel( CircuitTransaction const& transaction, Model& model, std::string* error ) const
+{
+    auto fail = [error]( std::string const& message ) {
+        if ( error != nullptr )
+        {
+            *error = message;
+        }
+        return false;
+    };
+
+    for ( auto const& edit : transaction.edits )
+    {
+        switch ( edit.action )
+        {
+            case CircuitTransaction::Action::AddComponent:
+                if ( edit.addedComponent == nullptr )
+                {
+                    return fail( "Cannot add a null component" );
+                }
+                if ( model.nodes.count( edit.addedComponent.get() ) == 0 )
+                {
+                    model.nodes[edit.addedComponent.get()] = {
+                        edit.addedComponent, model.nextGeneration++, std::vector<Model::Source>( edit.addedComponent->GetInputCount() ) };
+                }
+                break;
+
+            case CircuitTransaction::Action::RemoveComponent:
+                model.nodes.erase( edit.component.get() );
+                break;
+
+            case CircuitTransaction::Action::RemoveAllComponents:
+                model.nodes.clear();
+                break;
+
+            case CircuitTransaction::Action::ConnectOutToIn:
+            {
+                auto fromNode = model.nodes.find( edit.fromComponent.get() );
+                auto toNode = model.nodes.find( edit.component.get() );
+                if ( fromNode == model.nodes.end() || toNode == model.nodes.end() )
+                {
+                    return fail( "Cannot wire a component that is not in the circuit" );
+                }
+                auto const& fromComponent = fromNode->second.component;
+                auto const& toComponent = toNode->second.component;
+                if ( !DSPatch::Circuit::CanConnectOutToIn( fromComponent, edit.fromOutput, toComponent, edit.toInput, error ) )
+                {
+                    return false;
+                }
+                toNode->second.inputs[edit.toInput] = { fromComponent.get(), fromNode->second.generation, edit.fromOutput };
+                break;
+            }
+
+            case CircuitTransaction::Action::DisconnectInput:
+            {
+                auto node = model.nodes.find( edit.component.get() );
+                if ( node != model.nodes.end() && edit.toInput >= 0 && edit.toInput < (int)node->second.inputs.size() )
+                {
+                    node->second.inputs[edit.toInput] = {};
+                }
+                break;
+            }
+        }
+    }
+
+    if ( transaction.allowFeedback )
+    {
+        return true;
+    }
+
+    // depth-first search for a wire back to a component still on the search path
+    std::unordered_map<DSPatch::Component const*, int> visits;  // 1: on the search path, 2: done
+    for ( auto const& root : model.nodes )
+    {
+        if ( visits[root.first] != 0 )
+        {
+            continue;
+        }
+
+        std::vector<std::pair<Model::Node const*, size_t>> path{ { &root.second, 0 } };
+        visits[root.first] = 1;
+        while ( !path.empty() )
+        {
+            auto& [node, nextInput] = path.back();
+            if ( nextInput == node->inputs.size() )
+            {
+                visits[node->component.get()] = 2;
+                path.pop_back();
+                continue;
+            }
+
+            auto const& source = node->inputs[nextInput++];
+            if ( !model.IsConnected( source ) )
+            {
+                continue;
+            }
+
+            int& visit = visits[source.component];
+            if ( visit == 1 )
+            {
+                return fail( "Wiring " + source.component->GetComponentName() + " to " + node->component->GetComponentName() +
+                             " closes a loop" );
+            }
+            if ( visit == 0 )
+            {
+                visit = 1;
+                path.emplace_back( &model.nodes.at( source.component ), 0 );
+            }
+        }
+    }
+
+    return true;
+}
+
+void internal::Circuit::CommitModel( Model const& model )
+{
+    // components taken out of the circuit lose their wires, as in RemoveComponent()
+    for ( auto& component : components )
+    {
+        if ( model.nodes.count( component.get() ) == 0 )
+        {
+            component->DisconnectAllInputs();
+            removedComponents.emplace_back( component );
+        }
+    }
+
+    std::vector<Model::Node const*> nodes;
+    nodes.reserve( model.nodes.size() );
+    for ( auto const& node : model.nodes )
+    {
+        nodes.emplace_back( &node.second );
+    }
+    std::sort( nodes.begin(), nodes.end(), []( auto a, auto b ) { return a->generation < b->generation; } );
+
+    // components removed earlier, but still ticked by some buffers, are still set up
+    std::unordered_set<DSPatch::Component const*> stillSetUp;
+    for ( auto const& component : removedComponents )
+    {
+        stillSetUp.insert( component.get() );
+    }
+
+    std::unordered_set<DSPatch::Component const*> restoredComponents;
+    for ( auto node : nodes )
+    {
+        auto& component = node->component;
+        if ( componentIndices.count( component.get() ) == 0 )
+        {
+            if ( stillSetUp.count( component.get() ) != 0 )
+            {
+                restoredComponents.insert( component.get() );
+            }
+            else
+            {
+                // set up as in AddComponent()
+                component->SetBufferCount( circuitThreads.size() );
+                component->SetThreadPool( threadPool );
+                component->SetAutoTickThread( autoTickThread );
+                component->SetTracer( tracer );
+            }
+        }
+
+        for ( int i = 0; i < (int)node->inputs.size(); ++i )
+        {
+            auto const& source = node->inputs[i];
+            bool connected = model.IsConnected( source );
+
+            int fromOutput = 0;
+            auto fromComponent = component->GetInputComponent( i, &fromOutput );
+            if ( connected && fromComponent.get() == source.component && fromOutput == source.fromOutput )
+            {
+                continue;
+            }
+
+            if ( connected )
+            {
+                component->ConnectInput( model.nodes.at( source.component ).component, source.fromOutput, i );
+            }
+            else if ( fromComponent != nullptr )
+            {
+                component->DisconnectInput( i );
+            }
+        }
+    }
+
+    if ( !restoredComponents.empty() )
+    {
+        removedComponents.erase( std::remove_if( removedComponents.begin(),
+                                                 removedComponents.end(),
+                                                 [&]( auto const& component ) { return restoredComponents.count( component.get() ) != 0; } ),
+                                 removedComponents.end() );
+    }
+
+    components.clear();
+    componentIndices.clear();
+    for ( auto node : nodes )
+    {
+        componentIndices[node->component.get()] = components.size();
+        components.emplace_back( node->component );
+    }
+
+    Changed();
+    ReleaseRemovedComponents();
+}
+
+void internal::Circuit::Changed()
+{
+    changed = true;
+
+    // in AutoTickMode::SourceDriven, the circuit should reflect the change without waiting on a source
+    autoTickThread->RequestTick( std::chrono::steady_clock::now() );
+}
+
+void internal::Circuit::Compile()
+{
+    changed = false;
+
+    // discard the previous scan
+    for ( auto& component : components )
+    {
+        component->ResetScan();
+    }
+
+    // sort components into topological levels (in the order they were added, so as to identify
+    // feedback wires exactly as a recursive traversal from each component in turn would)
+    std::vector<std::vector<DSPatch::Component*>> levels;
+    for ( auto& component : components )
+    {
+        component->Scan( levels );
+    }
+
+    // flatten levels into the new plan's schedule (buffers still bound to the previous plan keep it alive)
+    plan = std::make_shared<Plan>();
+    plan->components = components;
+    for ( auto& level : levels )
+    {
+        plan->schedule.insert( plan->schedule.end(), level.begin(), level.end() );
+    }
+}
+
+void internal::Circuit::Rank( bool force )
+{
+    for ( auto component : plan->schedule )
+    {
+        component->ResetRank();
+    }
+
+    // rank from the bottom of the plan up, so that every component's dependents are ranked first
+    std::vector<std::pair<int64_t, DSPatch::Component*>> ranks;
+    for ( auto component = plan->schedule.rbegin(); component != plan->schedule.rend(); ++component )
+    {
+        ranks.emplace_back( ( *component )->Rank(), *component );
+    }
+
+    // You might be thinking: Why not reschedule whenever the ranks come out in a different order?
+
+    // Components of similar rank would then swap places back and forth with every bit of jitter in
+    // their process times, each time costing every buffer a rebind. Only a significant change to a
+    // rank is worth that.
+
+    if ( !force )
+    {
+        bool changed = false;
+        for ( auto const& rank : ranks )
+        {
+            auto scheduledRank = scheduledRanks.find( rank.second );
+            if ( scheduledRank == scheduledRanks.end() ||
+                 std::abs( rank.first - scheduledRank->second ) > (int64_t)( (double)scheduledRank->second * rerankThreshold ) )
+            {
+                changed = true;
+                break;
+            }
+        }
+        if ( !changed )
+        {
+            return;
+        }
+    }
+
+    scheduledRanks.clear();
+    for ( auto const& rank : ranks )
+    {
+        scheduledRanks[rank.second] = rank.first;
+    }
+
+    // schedule the most critical components first (descending rank is still in topological order),
+    // keeping components of equal rank in their current order so as not to reschedule needlessly
+    std::reverse( ranks.begin(), ranks.end() );
+    std::stable_sort( ranks.begin(), ranks.end(), []( auto const& a, auto const& b ) { return a.first > b.first; } );
+
+    std::vector<DSPatch::Component*> schedule;
+    for ( auto const& rank : ranks )
+    {
+        schedule.emplace_back( rank.second );
+    }
+
+    if ( schedule == plan->schedule )
+    {
+        return;
+    }
+
+    // buffers bound to the current plan are still ticking its schedule, so reschedule a copy of it
+    // (bound to each buffer at its next tick boundary, re-linking tasks most critical first)
+    if ( std::find( bufferPlans.begin(), bufferPlans.end(), plan ) != bufferPlans.end() )
+    {
+        plan = std::make_shared<Plan>( *plan );
+    }
+    plan->schedule = std::move( schedule );
+}
+
+void internal::Circuit::BindBuffer( int bufferNo )
+{
+    auto& bufferPlan = bufferPlans[bufferNo];
+
+    // unbind the buffer from both plans before binding, as binding links tasks across components
+    if ( bufferPlan != nullptr )
+    {
+        for ( auto component : bufferPlan->schedule )
+        {
+            component->UnbindBuffer( bufferNo );
+        }
+    }
+    for ( auto component : plan->schedule )
+    {
+        component->UnbindBuffer( bufferNo );
+    }
+
+    // components ticked by the previous buffer, but not by this one, must not hand their turn to it
+    auto const& prevPlan = bufferPlans[bufferNo == 0 ? bufferPlans.size() - 1 : bufferNo - 1];
+    if ( prevPlan != nullptr && prevPlan != plan )
+    {
+        std::unordered_set<DSPatch::Component const*> planComponents;
+        for ( auto const& component : plan->components )
+        {
+            planComponents.insert( component.get() );
+        }
+
+        for ( auto const& component : prevPlan->components )
+        {
+            if ( planComponents.count( component.get() ) == 0 )
+            {
+                component->SkipBuffer( bufferNo );
+            }
+        }
+    }
+
+    for ( auto component : plan->schedule )
+    {
+        component->BindBuffer( bufferNo );
+    }
+
+    bufferPlan = plan;
+
+    ReleaseRemovedComponents();
+}
+
+void internal::Circuit::UnbindBuffers()
+{
+    for ( size_t i = 0; i < bufferPlans.size(); ++i )
+    {
+        if ( bufferPlans[i] != nullptr )
+        {
+            for ( auto component : bufferPlans[i]->schedule )
+            {
+                component->UnbindBuffer( i );
+            }
+            bufferPlans[i] = nullptr;
+        }
+    }
+
+    ReleaseRemovedComponents();
+}
+
+void internal::Circuit::ReleaseRemovedComponents()
+{
+    if ( removedComponents.empty() )
+    {
+        return;
+    }
+
+    // components of every plan still bound to a buffer (most buffers are bound to the same plan)
+    std::unordered_set<Plan const*> boundPlans;
+    std::unordered_set<DSPatch::Component const*> tickedComponents;
+    for ( auto const& bufferPlan : bufferPlans )
+    {
+        if ( bufferPlan != nullptr && boundPlans.insert( bufferPlan.get() ).second )
+        {
+            for ( auto const& component : bufferPlan->components )
+            {
+                tickedComponents.insert( component.get() );
+            }
+        }
+    }
+
+    auto released = std::remove_if( removedComponents.begin(), removedComponents.end(), [&]( auto const& component ) {
+        if ( tickedComponents.count( component.get() ) != 0 )
+        {
+            return false;
+        }
+
+        component->SetThreadPool( nullptr );
+        component->SetAutoTickThread( nullptr );
+        component->SetTracer( nullptr );
+        component->ResetScan();
+        return true;
+    } );
+    removedComponents.erase( released, removedComponents.end() );
+}
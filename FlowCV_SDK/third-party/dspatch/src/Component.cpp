@@ -28,15 +28,29 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <dspatch/Component.h>
 
-#include <internal/ComponentThread.h>
+#include <internal/AutoTickThread.h>
+#include <internal/ComponentTask.h>
+#include <internal/Metrics.h>
+#include <internal/ThreadPool.h>
+#include <internal/Tracer.h>
 #include <internal/Wire.h>
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
-#include <unordered_set>
+#include <deque>
+#include <functional>
 #include <utility>
 
 using namespace DSPatch;
 
+namespace
+{
+
+int64_t const rankSmoothing = 8;  // each process time moves a component's rank 1 / rankSmoothing of the way
+
+}  // namespace
+
 namespace DSPatch
 {
 namespace internal
@@ -52,39 +66,106 @@ public:
         Ticking
     };
 
+    enum class ScanStatus
+    {
+        NotScanned,
+        Scanning,
+        Scanned
+    };
+
     Component( DSPatch::Component::ProcessOrder processOrder )
         : processOrder( processOrder )
     {
     }
 
     void WaitForRelease( int threadNo );
+    bool WaitForRelease( int threadNo, std::function<void()> const& resume );
     void ReleaseThread( int threadNo );
+    bool DropTurn();
+    void RecordProcess( int bufferNo, std::chrono::steady_clock::time_point processStart, char const* instanceName );
+    void RecordWait( int bufferNo, char const* instanceName );
+    void RecordSync( int bufferNo, std::chrono::steady_clock::time_point syncStart, char const* instanceName );
+    bool Recall( int bufferNo, bool changed );
+    void Memoize( int bufferNo );
 
-    void GetOutput( int bufferNo, int fromOutput, int toInput, DSPatch::SignalBus& toBus, DSPatch::Component::TickMode mode );
+    void GetOutput( int bufferNo, int fromOutput, int toInput, DSPatch::SignalBus& toBus );
+    void SizeOutputUses( int bufferNo );
 
-    void IncRefs( int output );
-    void DecRefs( int output );
+    static constexpr int minTileRows = 64;  // rows below which a stripe is not worth its own thread
 
     const DSPatch::Component::ProcessOrder processOrder;
 
     int bufferCount = 0;
 
+    std::atomic<DSPatch::Component::QueuePolicy> queuePolicy{ DSPatch::Component::QueuePolicy::Block };
+    std::atomic<int> queueSize{ 1 };
+    std::atomic<int> queuedCount{ 0 };
+
+    std::atomic<int64_t> processCount{ 0 };
+    std::atomic<int64_t> outputCount{ 0 };  // Process_() calls that output anything
+    std::atomic<int64_t> processTime{ 0 };  // nanoseconds
+    std::atomic<int64_t> smoothedProcessTime{ -1 };  // moving average of process times (nanoseconds), -1 until processed
+
+    mutable std::mutex metricsMutex;  // guards the vector below (not the metrics) against SetBufferCount()
+    std::vector<std::unique_ptr<BufferMetrics>> bufferMetrics;
+
+    std::atomic<DSPatch::Component::EvaluationMode> evaluationMode{ DSPatch::Component::EvaluationMode::Always };
+    std::atomic<bool> invalidated{ false };  // the held outputs must not be re-emitted (E.g. SetEnabled() was called)
+    std::mutex memoMutex;                    // guards the held values below across buffers
+    bool memoValid = false;
+    uint64_t memoEpoch = 0;                  // incremented whenever the held values become stale
+    std::vector<uint64_t> processEpochs;     // memoEpoch as at each buffer's last Recall()
+    std::vector<DSPatch::SignalBus> memoKeys;  // each buffer's inputs as they were before Process_()
+    DSPatch::SignalBus memoInputs;           // inputs last processed
+    DSPatch::SignalBus memoOutputs;          // outputs produced from memoInputs
+    std::function<bool()> changeProbe;       // reports changes to the component's settings (see HasChanges_())
+
+    std::atomic<bool> tileable{ false };
+    std::atomic<int> tileHalo{ 0 };  // rows beyond its own that a stripe reads
+
+    std::atomic<bool> finiteSource{ false };
+    std::atomic<bool> endOfStream{ false };
+    mutable std::mutex streamErrorMutex;  // guards the error below
+    std::string streamError;
+
     std::vector<DSPatch::SignalBus> inputBuses;
     std::vector<DSPatch::SignalBus> outputBuses;
 
-    std::vector<std::vector<std::pair<int, int>>> refs;  // ref_total:ref_counter per output, per buffer
-    std::vector<std::vector<std::unique_ptr<std::mutex>>> refMutexes;
+    struct OutputUse
+    {
+        int consumers = 0;      // non-feedback wires fetching the output (0 where unknown, I.e. unbound)
+        bool feedback = false;  // fetched by a feedback wire, hence must be held until the next tick
+        std::atomic<int> fetchCount{ 0 };
+    };
+    std::vector<std::deque<OutputUse>> outputUses;  // each buffer's use of each output, set by binding
 
     std::vector<Wire> inputWires;
 
-    std::vector<ComponentThread::UPtr> componentThreads;
-    std::vector<std::unordered_set<Wire*>> feedbackWires;
+    ThreadPool::SPtr threadPool;
+    AutoTickThread::SPtr autoTickThread;
+    Tracer::SPtr tracer;
+    std::vector<ComponentTask::UPtr> componentTasks;
+
+    ScanStatus scanStatus = ScanStatus::NotScanned;
+    int scanLevel = 0;
+    std::atomic<int> wiringRevision{ 0 };  // advanced by every change to inputWires
+    int scanRevision = -1;                 // wiringRevision as of the last scan
+    std::vector<DSPatch::Component*> scanInputs;  // non-feedback incoming components
+    int64_t dependentRank = 0;                    // rank of our most critical scanned dependent
+
+    std::vector<std::unique_ptr<std::vector<Wire>>> boundWires;  // each bound buffer's copy of inputWires
 
     std::vector<TickStatus> tickStatuses;
-    std::vector<bool> gotReleases;
+    std::vector<char> gotReleases;  // not vector<bool>: each flag is guarded by its own mutex, so no shared words
+    std::vector<std::function<void()>> releaseResumes;
     std::vector<std::unique_ptr<std::mutex>> releaseMutexes;
     std::vector<std::unique_ptr<std::condition_variable>> releaseCondts;
 
+    std::mutex turnMutex;           // guards the turn order below against BindBuffer() and SkipBuffer()
+    std::vector<int> nextBuffers;   // buffer to hand the turn to after each buffer (-1: not yet bound)
+    int heldBuffer = -1;            // buffer whose next buffer to tick this component is not yet bound
+    bool heldTurn = false;          // the turn was handed on by heldBuffer before its next buffer was bound
+
     std::vector<std::string> inputNames;
     std::vector<std::string> outputNames;
     std::vector<IoType> inputTypes;
@@ -119,9 +200,7 @@ bool Component::ConnectInput( Component::SPtr const& fromComponent, int fromOutp
     DisconnectInput( toInput );
 
     p->inputWires.emplace_back( fromComponent, fromOutput, toInput );
-
-    // update source output's reference count
-    fromComponent->p->IncRefs( fromOutput );
+    ++p->wiringRevision;
 
     return true;
 }
@@ -133,10 +212,8 @@ void Component::DisconnectInput( int inputNo )
     {
         if ( it->toInput == inputNo )
         {
-            // update source output's reference count
-            it->fromComponent->p->DecRefs( it->fromOutput );
-
             p->inputWires.erase( it );
+            ++p->wiringRevision;
             break;
         }
     }
@@ -149,10 +226,8 @@ void Component::DisconnectInput( Component::SCPtr const& fromComponent )
     {
         if ( it->fromComponent == fromComponent )
         {
-            // update source output's reference count
-            fromComponent->p->DecRefs( it->fromOutput );
-
             it = p->inputWires.erase( it );
+            ++p->wiringRevision;
         }
         else
         {
@@ -170,6 +245,23 @@ void Component::DisconnectAllInputs()
     }
 }
 
+Component::SPtr Component::GetInputComponent( int inputNo, int* fromOutput ) const
+{
+    for ( auto const& wire : p->inputWires )
+    {
+        if ( wire.toInput == inputNo )
+        {
+            if ( fromOutput != nullptr )
+            {
+                *fromOutput = wire.fromOutput;
+            }
+            return wire.fromComponent;
+        }
+    }
+
+    return nullptr;
+}
+
 int Component::GetInputCount() const
 {
     return p->inputBuses[0].GetSignalCount();
@@ -226,49 +318,54 @@ void Component::SetBufferCount( int bufferCount )
     }
 
     // resize vectors
-    p->componentThreads.resize( bufferCount );
-    p->feedbackWires.resize( bufferCount );
+    p->componentTasks.resize( bufferCount );
+    p->boundWires.resize( bufferCount );
 
     p->tickStatuses.resize( bufferCount );
 
     p->inputBuses.resize( bufferCount );
     p->outputBuses.resize( bufferCount );
+    p->outputUses.resize( bufferCount );
 
     p->gotReleases.resize( bufferCount );
+    p->releaseResumes.resize( bufferCount );
     p->releaseMutexes.resize( bufferCount );
     p->releaseCondts.resize( bufferCount );
 
-    p->refs.resize( bufferCount );
-    p->refMutexes.resize( bufferCount );
+    p->nextBuffers.resize( bufferCount );
+    p->processEpochs.resize( bufferCount );
+    p->memoKeys.resize( bufferCount );
 
+    {
+        std::lock_guard<std::mutex> lock( p->metricsMutex );
+        p->bufferMetrics.resize( bufferCount );
+    }
     // init new vector values
     for ( int i = p->bufferCount; i < bufferCount; ++i )
     {
-        p->componentThreads[i] = std::unique_ptr<internal::ComponentThread>( new internal::ComponentThread() );
+        p->componentTasks[i] = std::unique_ptr<internal::ComponentTask>( new internal::ComponentTask() );
 
         p->tickStatuses[i] = internal::Component::TickStatus::NotTicked;
 
         p->inputBuses[i].SetSignalCount( p->inputBuses[0].GetSignalCount() );
         p->outputBuses[i].SetSignalCount( p->outputBuses[0].GetSignalCount() );
+        p->memoKeys[i].SetSignalCount( p->inputBuses[0].GetSignalCount() );
+        p->SizeOutputUses( i );
 
         p->gotReleases[i] = false;
         p->releaseMutexes[i] = std::unique_ptr<std::mutex>( new std::mutex() );
         p->releaseCondts[i] = std::unique_ptr<std::condition_variable>( new std::condition_variable() );
 
-        p->refs[i].resize( p->refs[0].size() );
-        for ( size_t j = 0; j < p->refs[0].size(); ++j )
-        {
-            // sync output reference counts
-            p->refs[i][j] = p->refs[0][j];
-        }
+        p->bufferMetrics[i] = std::unique_ptr<internal::BufferMetrics>( new internal::BufferMetrics() );
+    }
 
-        p->refMutexes[i].resize( p->refMutexes[0].size() );
-        for ( size_t j = 0; j < p->refs[0].size(); ++j )
-        {
-            // construct new output reference mutexes
-            p->refMutexes[i][j] = std::unique_ptr<std::mutex>( new std::mutex() );
-        }
+    // buffers take their turns in order, starting from buffer 0
+    for ( int i = 0; i < bufferCount; ++i )
+    {
+        p->nextBuffers[i] = i + 1 == bufferCount ? 0 : i + 1;
     }
+    p->heldBuffer = -1;
+    p->heldTurn = false;
 
     p->gotReleases[0] = true;
 
@@ -280,6 +377,213 @@ int Component::GetBufferCount() const
     return p->inputBuses.size();
 }
 
+void Component::SetQueuePolicy( QueuePolicy queuePolicy, int queueSize )
+{
+    p->queuePolicy = queuePolicy;
+    p->queueSize = queuePolicy == QueuePolicy::LatestOnly || queueSize < 1 ? 1 : queueSize;
+}
+
+Component::QueuePolicy Component::GetQueuePolicy() const
+{
+    return p->queuePolicy;
+}
+
+int Component::GetQueueSize() const
+{
+    return p->queueSize;
+}
+
+void Component::SetEvaluationMode( EvaluationMode evaluationMode )
+{
+    p->evaluationMode = evaluationMode;
+    p->invalidated = true;
+}
+
+Component::EvaluationMode Component::GetEvaluationMode() const
+{
+    return p->evaluationMode;
+}
+
+bool Component::IsTileable() const
+{
+    return p->tileable;
+}
+
+int Component::GetTileHalo() const
+{
+    return p->tileHalo;
+}
+
+Component::ProcessOrder Component::GetProcessOrder() const
+{
+    return p->processOrder;
+}
+
+bool Component::IsFiniteSource() const
+{
+    return p->finiteSource;
+}
+
+bool Component::IsEndOfStream() const
+{
+    return p->endOfStream;
+}
+
+std::string Component::GetStreamError() const
+{
+    std::lock_guard<std::mutex> lock( p->streamErrorMutex );
+    return p->streamError;
+}
+
+void Component::Flush()
+{
+    Flush_();
+}
+
+int64_t Component::GetTotalProcessCount() const
+{
+    return p->processCount;
+}
+
+int64_t Component::GetTotalOutputCount() const
+{
+    return p->outputCount;
+}
+
+std::chrono::nanoseconds Component::GetTotalProcessTime() const
+{
+    return std::chrono::nanoseconds( p->processTime );
+}
+
+Component::Metrics Component::GetMetrics() const
+{
+    std::lock_guard<std::mutex> lock( p->metricsMutex );
+
+    Metrics metrics;
+    for ( auto const& bufferMetrics : p->bufferMetrics )
+    {
+        Metrics buffer;
+        bufferMetrics->Get( buffer );
+        metrics.Add( buffer );
+    }
+    return metrics;
+}
+
+Component::Metrics Component::GetMetrics( int bufferNo ) const
+{
+    std::lock_guard<std::mutex> lock( p->metricsMutex );
+
+    Metrics metrics;
+    if ( bufferNo >= 0 && (size_t)bufferNo < p->bufferMetrics.size() )
+    {
+        p->bufferMetrics[bufferNo]->Get( metrics );
+    }
+    return metrics;
+}
+
+void Component::ResetMetrics()
+{
+    std::lock_guard<std::mutex> lock( p->metricsMutex );
+
+    for ( auto& bufferMetrics : p->bufferMetrics )
+    {
+        bufferMetrics->Reset();
+    }
+}
+
+std::chrono::nanoseconds Component::Histogram::Mean() const
+{
+    return count == 0 ? std::chrono::nanoseconds( 0 ) : total / count;
+}
+
+std::chrono::nanoseconds Component::Histogram::Percentile( double percentile ) const
+{
+    if ( count == 0 )
+    {
+        return std::chrono::nanoseconds( 0 );
+    }
+
+    // find the bucket holding the percentile, then interpolate within its range
+    double rank = std::min( std::max( percentile, 0.0 ), 100.0 ) / 100.0 * (double)count;
+    int64_t below = 0;
+    for ( int i = 0; i < bucketCount; ++i )
+    {
+        if ( buckets[i] == 0 || (double)( below + buckets[i] ) < rank )
+        {
+            below += buckets[i];
+            continue;
+        }
+
+        double low = i == 0 ? 0.0 : (double)( int64_t( 1 ) << i );
+        double high = (double)( int64_t( 1 ) << ( i + 1 ) );
+        auto ns = (int64_t)( low + ( high - low ) * ( rank - (double)below ) / (double)buckets[i] );
+        return std::min( std::chrono::nanoseconds( ns ), max );
+    }
+
+    return max;
+}
+
+void Component::Histogram::Add( Histogram const& other )
+{
+    count += other.count;
+    total += other.total;
+    max = std::max( max, other.max );
+    for ( int i = 0; i < bucketCount; ++i )
+    {
+        buckets[i] += other.buckets[i];
+    }
+}
+
+void Component::Histogram::Subtract( Histogram const& earlier )
+{
+    // You might be thinking: What about max?
+
+    // The maximum of the durations recorded since earlier can't be derived from the two, hence the
+    // later (overall) maximum is kept as an upper bound.
+
+    count -= earlier.count;
+    total -= earlier.total;
+    for ( int i = 0; i < bucketCount; ++i )
+    {
+        buckets[i] -= earlier.buckets[i];
+    }
+}
+
+void Component::Metrics::Add( Metrics const& other )
+{
+    tickCount += other.tickCount;
+    reuseCount += other.reuseCount;
+    dropCount += other.dropCount;
+    processTime.Add( other.processTime );
+    waitTime.Add( other.waitTime );
+    syncTime.Add( other.syncTime );
+}
+
+void Component::Metrics::Subtract( Metrics const& earlier )
+{
+    tickCount -= earlier.tickCount;
+    reuseCount -= earlier.reuseCount;
+    dropCount -= earlier.dropCount;
+    processTime.Subtract( earlier.processTime );
+    waitTime.Subtract( earlier.waitTime );
+    syncTime.Subtract( earlier.syncTime );
+}
+
+void Component::SetThreadPool( std::shared_ptr<internal::ThreadPool> const& threadPool )
+{
+    p->threadPool = threadPool;
+}
+
+void Component::SetAutoTickThread( std::shared_ptr<internal::AutoTickThread> const& autoTickThread )
+{
+    p->autoTickThread = autoTickThread;
+}
+
+void Component::SetTracer( std::shared_ptr<internal::Tracer> const& tracer )
+{
+    p->tracer = tracer;
+}
+
 bool Component::Tick( Component::TickMode mode, int bufferNo )
 {
     // continue only if this component has not already been ticked
@@ -288,73 +592,156 @@ bool Component::Tick( Component::TickMode mode, int bufferNo )
         // 1. set tickStatus -> TickStarted
         p->tickStatuses[bufferNo] = internal::Component::TickStatus::TickStarted;
 
-        // 2. tick incoming components
-        for ( auto& wire : p->inputWires )
-        {
-            if ( mode == TickMode::Series )
+        auto processBuffer = [this, bufferNo]() {
+            // in EvaluationMode::OnChange, unchanged inputs re-emit the outputs held from last time
+            bool onChange = p->evaluationMode == EvaluationMode::OnChange;
+            if ( onChange && p->Recall( bufferNo, p->invalidated.exchange( false ) || HasChanges_() ) )
             {
-                wire.fromComponent->Tick( mode, bufferNo );
+                ++p->bufferMetrics[bufferNo]->reuseCount;
+                return;
             }
-            else if ( mode == TickMode::Parallel )
+
+            auto processStart = std::chrono::steady_clock::now();
+            Process_( p->inputBuses[bufferNo], p->outputBuses[bufferNo] );
+            p->RecordProcess( bufferNo, processStart, GetInstanceName() );
+
+            auto const& outputs = p->outputBuses[bufferNo];
+            for ( int i = 0; i < outputs.GetSignalCount(); ++i )
             {
-                if ( !wire.fromComponent->Tick( mode, bufferNo ) )
+                if ( outputs.HasValue( i ) )
                 {
-                    p->feedbackWires[bufferNo].emplace( &wire );
+                    ++p->outputCount;
+                    break;
                 }
             }
-        }
 
-        // 3. set tickStatus -> Ticking
-        p->tickStatuses[bufferNo] = internal::Component::TickStatus::Ticking;
+            if ( onChange )
+            {
+                p->Memoize( bufferNo );
+            }
+        };
+
+        auto tick = [this, mode, bufferNo, processBuffer]() {
+            ++p->bufferMetrics[bufferNo]->tickCount;
 
-        auto tick = [this, mode, bufferNo]() {
             // 4. get new inputs from incoming components
-            for ( auto& wire : p->inputWires )
+            for ( auto& wire : p->boundWires[bufferNo] ? *p->boundWires[bufferNo] : p->inputWires )
             {
-                if ( mode == TickMode::Parallel )
+                wire.fromComponent->p->GetOutput( bufferNo, wire.fromOutput, wire.toInput, p->inputBuses[bufferNo] );
+            }
+
+            // You might be thinking: Why not clear the outputs in Reset()?
+
+            // This is because we need components to hold onto their outputs long enough for any
+            // loopback wires to grab them during the next tick.
+
+            // 5. clear outputs
+            p->outputBuses[bufferNo].ClearAllValues();
+
+            if ( mode == TickMode::Series )
+            {
+                if ( p->processOrder == ProcessOrder::InOrder && p->bufferCount > 1 )
                 {
-                    // wait for non-feedback incoming components to finish ticking
-                    auto wireIndex = p->feedbackWires[bufferNo].find( &wire );
-                    if ( wireIndex == p->feedbackWires[bufferNo].end() )
+                    // 6. wait for our turn to process
+                    ++p->queuedCount;
+                    p->bufferMetrics[bufferNo]->queueTime = std::chrono::steady_clock::now();
+                    p->WaitForRelease( bufferNo );
+                    p->RecordWait( bufferNo, GetInstanceName() );
+
+                    // 7. call Process_() with newly aquired inputs (unless our queue policy drops them)
+                    if ( !p->DropTurn() )
                     {
-                        wire.fromComponent->p->componentThreads[bufferNo]->Sync();
+                        processBuffer();
                     }
                     else
                     {
-                        p->feedbackWires[bufferNo].erase( wireIndex );
+                        ++p->bufferMetrics[bufferNo]->dropCount;
                     }
-                }
 
-                wire.fromComponent->p->GetOutput( bufferNo, wire.fromOutput, wire.toInput, p->inputBuses[bufferNo], mode );
+                    // 8. signal that we're done processing
+                    p->ReleaseThread( bufferNo );
+                }
+                else
+                {
+                    // 6. call Process_() with newly aquired inputs
+                    processBuffer();
+                }
             }
+            else if ( mode == TickMode::Parallel )
+            {
+                auto process = [this, bufferNo, processBuffer]() {
+                    bool inOrder = p->processOrder == ProcessOrder::InOrder && p->bufferCount > 1;
 
-            // You might be thinking: Why not clear the outputs in Reset()?
+                    // 7. call Process_() with newly aquired inputs (unless our queue policy drops them)
+                    if ( inOrder )
+                    {
+                        p->RecordWait( bufferNo, GetInstanceName() );
+                    }
+                    if ( !inOrder || !p->DropTurn() )
+                    {
+                        processBuffer();
+                    }
+                    else
+                    {
+                        ++p->bufferMetrics[bufferNo]->dropCount;
+                    }
 
-            // This is because we need components to hold onto their outputs long enough for any
-            // loopback wires to grab them during the next tick. The same applies to how we handle
-            // output reference counting in internal::Component::GetOutput(), reseting the counter upon
-            // the final request rather than in Reset().
+                    if ( inOrder )
+                    {
+                        // 8. signal that we're done processing
+                        p->ReleaseThread( bufferNo );
+                    }
 
-            // 5. clear outputs
-            p->outputBuses[bufferNo].ClearAllValues();
+                    // 9. release components waiting on our outputs
+                    p->componentTasks[bufferNo]->Done();
+                };
 
-            if ( p->processOrder == ProcessOrder::InOrder && p->bufferCount > 1 )
-            {
-                // 6. wait for our turn to process
-                p->WaitForRelease( bufferNo );
+                // 6. wait for our turn to process (if not our turn yet, ReleaseThread() resumes us later)
+                if ( p->processOrder != ProcessOrder::InOrder || p->bufferCount <= 1 )
+                {
+                    process();
+                }
+                else
+                {
+                    ++p->queuedCount;
+                    p->bufferMetrics[bufferNo]->queueTime = std::chrono::steady_clock::now();
+                    if ( p->WaitForRelease( bufferNo, process ) )
+                    {
+                        process();
+                    }
+                }
+            }
+        };
 
-                // 7. call Process_() with newly aquired inputs
-                Process_( p->inputBuses[bufferNo], p->outputBuses[bufferNo] );
+        if ( mode == TickMode::Parallel )
+        {
+            p->componentTasks[bufferNo]->Start( tick, p->threadPool.get() );
+        }
 
-                // 8. signal that we're done processing
-                p->ReleaseThread( bufferNo );
-            }
-            else
+        // 2. tick incoming components (a bound buffer is ticked in scan order instead, its task
+        //    already linked to those of its non-feedback incoming components)
+        if ( !p->boundWires[bufferNo] )
+        {
+            for ( auto& wire : p->inputWires )
             {
-                // 6. call Process_() with newly aquired inputs
-                Process_( p->inputBuses[bufferNo], p->outputBuses[bufferNo] );
+                if ( mode == TickMode::Series )
+                {
+                    wire.fromComponent->Tick( mode, bufferNo );
+                }
+                else if ( mode == TickMode::Parallel )
+                {
+                    // non-feedback incoming components must finish ticking before our tick can start
+                    // (feedback components return false here, as they have already started a tick)
+                    if ( wire.fromComponent->Tick( mode, bufferNo ) )
+                    {
+                        wire.fromComponent->p->componentTasks[bufferNo]->AddDependent( *p->componentTasks[bufferNo] );
+                    }
+                }
             }
-        };
+        }
+
+        // 3. set tickStatus -> Ticking
+        p->tickStatuses[bufferNo] = internal::Component::TickStatus::Ticking;
 
         // do tick
         if ( mode == TickMode::Series )
@@ -363,7 +750,7 @@ bool Component::Tick( Component::TickMode mode, int bufferNo )
         }
         else if ( mode == TickMode::Parallel )
         {
-            p->componentThreads[bufferNo]->Resume( tick );
+            p->componentTasks[bufferNo]->Release();
         }
     }
     else if ( p->tickStatuses[bufferNo] == internal::Component::TickStatus::TickStarted )
@@ -379,7 +766,9 @@ bool Component::Tick( Component::TickMode mode, int bufferNo )
 void Component::Reset( int bufferNo )
 {
     // wait for ticking to complete
-    p->componentThreads[bufferNo]->Sync();
+    auto syncStart = std::chrono::steady_clock::now();
+    p->componentTasks[bufferNo]->Sync();
+    p->RecordSync( bufferNo, syncStart, GetInstanceName() );
 
     // clear inputs
     p->inputBuses[bufferNo].ClearAllValues();
@@ -388,6 +777,314 @@ void Component::Reset( int bufferNo )
     p->tickStatuses[bufferNo] = internal::Component::TickStatus::NotTicked;
 }
 
+int Component::Scan( std::vector<std::vector<Component*>>& levels )
+{
+    // return -1 to indicate that we have already started a scan, and hence, are a feedback component
+    if ( p->scanStatus == internal::Component::ScanStatus::Scanning )
+    {
+        return -1;
+    }
+
+    // continue only if this component has not already been scanned
+    if ( p->scanStatus == internal::Component::ScanStatus::NotScanned )
+    {
+        // 1. set scanStatus -> Scanning
+        p->scanStatus = internal::Component::ScanStatus::Scanning;
+        p->scanRevision = p->wiringRevision;
+        p->scanLevel = 0;
+
+        // 2. scan incoming components
+        for ( auto& wire : p->inputWires )
+        {
+            int level = wire.fromComponent->Scan( levels );
+
+            // non-feedback incoming components must finish ticking before our tick can start
+            if ( level != -1 )
+            {
+                p->scanLevel = std::max( p->scanLevel, level + 1 );
+                p->scanInputs.emplace_back( wire.fromComponent.get() );
+            }
+        }
+
+        // 3. set scanStatus -> Scanned
+        p->scanStatus = internal::Component::ScanStatus::Scanned;
+
+        // 4. add ourself to our level (one above that of our highest incoming component)
+        if ( (int)levels.size() <= p->scanLevel )
+        {
+            levels.resize( p->scanLevel + 1 );
+        }
+        levels[p->scanLevel].emplace_back( this );
+    }
+
+    return p->scanLevel;
+}
+
+bool Component::IsScanOutdated() const
+{
+    return p->scanRevision != p->wiringRevision.load( std::memory_order_relaxed );
+}
+
+void Component::ResetScan()
+{
+    p->scanInputs.clear();
+    p->scanStatus = internal::Component::ScanStatus::NotScanned;
+}
+
+int64_t Component::Rank()
+{
+    // our rank is our smoothed process time plus that of our slowest chain of dependents (counting
+    // at least 1ns per component, so that chains not yet processed are still ranked by their length)
+    int64_t smoothedProcessTime = p->smoothedProcessTime.load( std::memory_order_relaxed );
+    int64_t rank = p->dependentRank + std::max<int64_t>( smoothedProcessTime, 1 );
+
+    for ( auto scanInput : p->scanInputs )
+    {
+        scanInput->p->dependentRank = std::max( scanInput->p->dependentRank, rank );
+    }
+
+    return rank;
+}
+
+void Component::ResetRank()
+{
+    p->dependentRank = 0;
+}
+
+void Component::BindBuffer( int bufferNo )
+{
+    // You might be thinking: Why not just hand the in-order turn to the next buffer as usual?
+
+    // Buffers in between may have been bound without this component (I.e. while it was removed),
+    // and hence, never take their turn. Since buffers are bound in tick order, the last buffer to
+    // tick this component before them is linked to hand the turn straight to this one.
+
+    {
+        std::lock_guard<std::mutex> lock( p->turnMutex );
+
+        if ( std::none_of( p->boundWires.begin(), p->boundWires.end(), []( auto const& wires ) { return wires != nullptr; } ) )
+        {
+            // no bound buffers are ticking this component, so the turn can safely start here
+            for ( int i = 0; i < p->bufferCount; ++i )
+            {
+                p->nextBuffers[i] = i + 1 == p->bufferCount ? 0 : i + 1;
+                p->gotReleases[i] = i == bufferNo;
+                p->releaseResumes[i] = nullptr;
+            }
+            p->heldBuffer = -1;
+            p->heldTurn = false;
+        }
+        else if ( p->heldBuffer != -1 )
+        {
+            p->nextBuffers[p->heldBuffer] = bufferNo;
+            p->heldBuffer = -1;
+
+            if ( p->heldTurn )
+            {
+                std::lock_guard<std::mutex> releaseLock( *p->releaseMutexes[bufferNo] );
+                p->gotReleases[bufferNo] = true;
+                p->heldTurn = false;
+            }
+        }
+
+        // until the next buffer is bound, assume it will tick this component too
+        p->nextBuffers[bufferNo] = bufferNo + 1 == p->bufferCount ? 0 : bufferNo + 1;
+    }
+
+    p->boundWires[bufferNo] = std::unique_ptr<std::vector<internal::Wire>>( new std::vector<internal::Wire>( p->inputWires ) );
+
+    // tell each incoming component how many of its output's consumers to wait for before letting go of it
+    for ( auto& wire : p->inputWires )
+    {
+        auto& outputUses = wire.fromComponent->p->outputUses[bufferNo];
+        if ( (size_t)wire.fromOutput >= outputUses.size() )
+        {
+            continue;
+        }
+
+        if ( std::find( p->scanInputs.begin(), p->scanInputs.end(), wire.fromComponent.get() ) != p->scanInputs.end() )
+        {
+            ++outputUses[wire.fromOutput].consumers;
+        }
+        else
+        {
+            outputUses[wire.fromOutput].feedback = true;
+        }
+    }
+
+    for ( auto scanInput : p->scanInputs )
+    {
+        scanInput->p->componentTasks[bufferNo]->Link( *p->componentTasks[bufferNo] );
+    }
+}
+
+void Component::SkipBuffer( int bufferNo )
+{
+    std::lock_guard<std::mutex> lock( p->turnMutex );
+
+    int prevBuffer = bufferNo == 0 ? p->bufferCount - 1 : bufferNo - 1;
+
+    // only the previous buffer may have assumed that this one would take the turn next
+    if ( p->nextBuffers[prevBuffer] != bufferNo )
+    {
+        return;
+    }
+
+    p->nextBuffers[prevBuffer] = -1;
+    p->heldBuffer = prevBuffer;
+
+    // take the turn back if it has already been handed to this buffer
+    std::lock_guard<std::mutex> releaseLock( *p->releaseMutexes[bufferNo] );
+    if ( p->gotReleases[bufferNo] )
+    {
+        p->gotReleases[bufferNo] = false;
+        p->heldTurn = true;
+    }
+}
+
+void Component::UnbindBuffer( int bufferNo )
+{
+    p->componentTasks[bufferNo]->Unlink();
+    p->boundWires[bufferNo] = nullptr;
+
+    for ( auto& outputUse : p->outputUses[bufferNo] )
+    {
+        outputUse.consumers = 0;
+        outputUse.feedback = false;
+        outputUse.fetchCount = 0;
+    }
+}
+
+bool Component::RequestTick_( std::chrono::steady_clock::time_point when )
+{
+    if ( p->autoTickThread == nullptr )
+    {
+        return false;
+    }
+
+    return p->autoTickThread->RequestTick( when );
+}
+
+bool Component::PaceTick_( std::chrono::steady_clock::time_point& lastTick, std::chrono::steady_clock::duration period )
+{
+    auto now = std::chrono::steady_clock::now();
+
+    // in batch, every tick is due straight away
+    if ( IsBatch_() )
+    {
+        lastTick = now;
+        return true;
+    }
+    auto due = lastTick + period;
+
+    // You might be thinking: Why not sleep until due if the auto-tick thread won't tick us then?
+
+    // We are processing on a circuit thread or, worse, a thread pool worker shared with other
+    // circuits. Sleeping would stall all of them, so instead we skip ticks until one is due.
+
+    if ( now < due )
+    {
+        RequestTick_( due );
+        return false;
+    }
+
+    // advance by exactly one period so that the tick rate does not drift (unless we have fallen
+    // more than a period behind, in which case skip the ticks we missed)
+    lastTick = now - due > period ? now : due;
+
+    RequestTick_( lastTick + period );
+
+    return true;
+}
+
+bool Component::IsBatch_() const
+{
+    return p->autoTickThread != nullptr && p->autoTickThread->GetAutoTickMode() == Circuit::AutoTickMode::Batch;
+}
+
+void Component::SetFiniteSource_( bool finiteSource )
+{
+    p->finiteSource = finiteSource;
+}
+
+void Component::SetEndOfStream_( bool endOfStream )
+{
+    if ( !endOfStream )
+    {
+        std::lock_guard<std::mutex> lock( p->streamErrorMutex );
+        p->streamError.clear();
+    }
+    p->endOfStream = endOfStream;
+}
+
+void Component::SetStreamError_( std::string const& error )
+{
+    {
+        std::lock_guard<std::mutex> lock( p->streamErrorMutex );
+        p->streamError = error;
+    }
+    p->endOfStream = true;
+}
+
+void Component::Flush_()
+{
+}
+
+bool Component::HasChanges_()
+{
+    return p->changeProbe && p->changeProbe();
+}
+
+void Component::SetChangeProbe_( std::function<bool()> const& hasChanges )
+{
+    p->changeProbe = hasChanges;
+}
+
+bool Component::ReuseOutputs_( SignalBus& outputs )
+{
+    std::lock_guard<std::mutex> lock( p->memoMutex );
+
+    if ( !p->memoValid )
+    {
+        return false;
+    }
+
+    for ( int i = 0; i < p->memoOutputs.GetSignalCount(); ++i )
+    {
+        outputs.ShareSignal( i, p->memoOutputs.GetSignal( i ) );
+    }
+
+    return true;
+}
+
+void Component::SetTileable_( bool tileable, int halo )
+{
+    p->tileHalo = std::max( halo, 0 );
+    p->tileable = tileable;
+}
+
+void Component::ProcessTiles_( int rowCount, std::function<void( int firstRow, int lastRow )> const& processTile )
+{
+    // split into a stripe per pool thread, as long as each stripe is tall enough that re-reading its
+    // halo rows (already read by the neighbouring stripes) costs little
+    int tileCount = 1;
+    if ( p->tileable && p->threadPool != nullptr )
+    {
+        int minTileRows = std::max( internal::Component::minTileRows, 4 * p->tileHalo );
+        tileCount = std::min( p->threadPool->GetThreadCount(), rowCount / minTileRows );
+    }
+
+    if ( tileCount <= 1 )
+    {
+        processTile( 0, rowCount );
+        return;
+    }
+
+    p->threadPool->ParallelFor( tileCount, [rowCount, tileCount, &processTile]( int tileNo ) {
+        processTile( rowCount * tileNo / tileCount, rowCount * ( tileNo + 1 ) / tileCount );
+    } );
+}
+
 void Component::SetInputCount_( int inputCount, std::vector<std::string> const& inputNames, std::vector<IoType> const& inputTypes )
 {
     p->inputNames = inputNames;
@@ -397,6 +1094,14 @@ void Component::SetInputCount_( int inputCount, std::vector<std::string> const&
     {
         inputBus.SetSignalCount( inputCount );
     }
+    for ( auto& memoKey : p->memoKeys )
+    {
+        memoKey.SetSignalCount( inputCount );
+    }
+
+    std::lock_guard<std::mutex> lock( p->memoMutex );
+    p->memoInputs.SetSignalCount( inputCount );
+    p->invalidated = true;
 }
 
 void Component::SetOutputCount_( int outputCount, std::vector<std::string> const& outputNames, std::vector<IoType> const& outputTypes )
@@ -404,28 +1109,15 @@ void Component::SetOutputCount_( int outputCount, std::vector<std::string> const
     p->outputNames = outputNames;
     p->outputTypes = outputTypes;
 
-    for ( auto& outputBus : p->outputBuses )
+    for ( size_t i = 0; i < p->outputBuses.size(); ++i )
     {
-        outputBus.SetSignalCount( outputCount );
+        p->outputBuses[i].SetSignalCount( outputCount );
+        p->SizeOutputUses( i );
     }
 
-    // add reference counters for our new outputs
-    for ( auto& ref : p->refs )
-    {
-        ref.resize( outputCount );
-    }
-    for ( auto& refMutexes : p->refMutexes )
-    {
-        refMutexes.resize( outputCount );
-        for ( auto& refMutex : refMutexes )
-        {
-            // construct new output reference mutexes
-            if ( !refMutex )
-            {
-                refMutex = std::unique_ptr<std::mutex>( new std::mutex() );
-            }
-        }
-    }
+    std::lock_guard<std::mutex> lock( p->memoMutex );
+    p->memoOutputs.SetSignalCount( outputCount );
+    p->invalidated = true;
 }
 
 void Component::SetComponentName_(std::string component_name)
@@ -489,6 +1181,7 @@ int Component::GetInstanceCount() const
 void Component::SetEnabled(bool enabled)
 {
     isEnabled_ = enabled;
+    p->invalidated = true;
 }
 
 bool Component::IsEnabled()
@@ -507,62 +1200,259 @@ void internal::Component::WaitForRelease( int threadNo )
     gotReleases[threadNo] = false;  // reset the release flag
 }
 
+bool internal::Component::WaitForRelease( int threadNo, std::function<void()> const& resume )
+{
+    std::lock_guard<std::mutex> lock( *releaseMutexes[threadNo] );
+
+    if ( !gotReleases[threadNo] )
+    {
+        releaseResumes[threadNo] = resume;  // resume once released
+        return false;
+    }
+    gotReleases[threadNo] = false;  // reset the release flag
+    return true;
+}
+
 void internal::Component::ReleaseThread( int threadNo )
 {
-    threadNo = threadNo + 1 == bufferCount ? 0 : threadNo + 1;  // we're actually releasing the next available thread
+    std::function<void()> resume;
 
-    std::lock_guard<std::mutex> lock( *releaseMutexes[threadNo] );
+    {
+        std::lock_guard<std::mutex> turnLock( turnMutex );
+
+        threadNo = nextBuffers[threadNo];  // we're actually releasing the next available thread
+
+        if ( threadNo == -1 )
+        {
+            heldTurn = true;  // hold the turn until the next buffer to tick this component is bound
+            return;
+        }
 
-    gotReleases[threadNo] = true;
-    releaseCondts[threadNo]->notify_all();
+        std::lock_guard<std::mutex> lock( *releaseMutexes[threadNo] );
+
+        if ( releaseResumes[threadNo] )
+        {
+            // the next thread is already waiting for release, resume it directly
+            std::swap( resume, releaseResumes[threadNo] );
+        }
+        else
+        {
+            gotReleases[threadNo] = true;
+            releaseCondts[threadNo]->notify_all();
+        }
+    }
+
+    if ( resume )
+    {
+        if ( threadPool != nullptr )
+        {
+            threadPool->Submit( std::move( resume ) );
+        }
+        else
+        {
+            resume();
+        }
+    }
 }
 
-void internal::Component::GetOutput(
-    int bufferNo, int fromOutput, int toInput, DSPatch::SignalBus& toBus, DSPatch::Component::TickMode mode )
+bool internal::Component::DropTurn()
 {
-    if ( !outputBuses[bufferNo].HasValue( fromOutput ) )
+    // You might be thinking: How do we know that the other queued buffers are newer than ours?
+
+    // Buffers take their turns in order, so by the time a buffer gets its turn, all older buffers
+    // have already had theirs. Any other buffers still queued must therefore be newer.
+
+    int newerCount = --queuedCount;
+
+    switch ( queuePolicy.load() )
     {
-        return;
+        case DSPatch::Component::QueuePolicy::LatestOnly:
+            return newerCount > 0;
+        case DSPatch::Component::QueuePolicy::DropOldest:
+            return newerCount > queueSize;
+        default:
+            return false;
     }
+}
+
+void internal::Component::RecordProcess( int bufferNo, std::chrono::steady_clock::time_point processStart, char const* instanceName )
+{
+    auto processEnd = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>( processEnd - processStart );
 
-    auto& signal = outputBuses[bufferNo].GetSignal( fromOutput );
+    processTime += duration.count();
+    ++processCount;
+    bufferMetrics[bufferNo]->processTime.Record( duration );
 
-    if ( mode == DSPatch::Component::TickMode::Parallel && refs[bufferNo][fromOutput].first > 1 )
+    // You might be thinking: Why not rank by the mean process time?
+
+    // A mean over the whole run barely moves once a component has processed for a while, so it
+    // would never follow a change in load. A moving average follows such changes, while still
+    // smoothing out the odd slow tick.
+
+    auto smoothed = smoothedProcessTime.load( std::memory_order_relaxed );
+    while ( !smoothedProcessTime.compare_exchange_weak(
+        smoothed, smoothed < 0 ? duration.count() : smoothed + ( duration.count() - smoothed ) / rankSmoothing, std::memory_order_relaxed ) )
     {
-        refMutexes[bufferNo][fromOutput]->lock();
     }
 
-    if ( ++refs[bufferNo][fromOutput].second == refs[bufferNo][fromOutput].first )
+    if ( tracer )
     {
-        // this is the final reference, reset the counter, move the signal
-        refs[bufferNo][fromOutput].second = 0;
+        tracer->Record( instanceName, "process", bufferNo, processStart, processEnd );
+    }
+}
 
-        toBus.MoveSignal( toInput, signal );
+void internal::Component::RecordWait( int bufferNo, char const* instanceName )
+{
+    auto& metrics = *bufferMetrics[bufferNo];
+    auto waitEnd = std::chrono::steady_clock::now();
+    metrics.waitTime.Record( waitEnd - metrics.queueTime );
+
+    if ( tracer )
+    {
+        tracer->Record( instanceName, "wait", bufferNo, metrics.queueTime, waitEnd );
     }
-    else
+}
+
+void internal::Component::RecordSync( int bufferNo, std::chrono::steady_clock::time_point syncStart, char const* instanceName )
+{
+    auto syncEnd = std::chrono::steady_clock::now();
+    bufferMetrics[bufferNo]->syncTime.Record( syncEnd - syncStart );
+
+    // a sync that didn't have to wait isn't worth a span
+    if ( tracer && syncEnd - syncStart >= std::chrono::microseconds( 1 ) )
+    {
+        tracer->Record( instanceName, "sync", bufferNo, syncStart, syncEnd );
+    }
+}
+
+bool internal::Component::Recall( int bufferNo, bool changed )
+{
+    std::lock_guard<std::mutex> lock( memoMutex );
+
+    if ( changed )
+    {
+        // outputs held from before the change are stale, as are those of any buffers still processing
+        memoValid = false;
+        ++memoEpoch;
+    }
+    processEpochs[bufferNo] = memoEpoch;
+
+    // You might be thinking: Why hold on to the inputs now, rather than in Memoize()?
+
+    // Process_() may take its inputs via TakeMutable(), after which they are no longer the values
+    // that were input. Holding on to them here keeps them shared, so TakeMutable() copies instead.
+
+    auto const& inputBus = inputBuses[bufferNo];
+    bool recalled = memoValid && inputBus.GetSignalCount() != 0;
+
+    for ( int i = 0; i < inputBus.GetSignalCount(); ++i )
+    {
+        auto const& memoInput = memoInputs.GetSignal( i );
+        if ( recalled && ( inputBus.HasValue( i ) ? !inputBus.GetSignal( i )->IsSharedWith( memoInput ) : memoInput->HasValue() ) )
+        {
+            recalled = false;
+        }
+        if ( !memoKeys[bufferNo].ShareSignal( i, inputBus.GetSignal( i ) ) )
+        {
+            memoKeys[bufferNo].GetSignal( i )->ClearValue();
+        }
+    }
+
+    if ( !recalled )
+    {
+        return false;
+    }
+    memoKeys[bufferNo].ClearAllValues();
+
+    for ( int i = 0; i < memoOutputs.GetSignalCount(); ++i )
+    {
+        outputBuses[bufferNo].ShareSignal( i, memoOutputs.GetSignal( i ) );
+    }
+
+    return true;
+}
+
+void internal::Component::Memoize( int bufferNo )
+{
+    auto& memoKey = memoKeys[bufferNo];
+    auto const& outputBus = outputBuses[bufferNo];
+
+    bool hasOutputs = false;
+    for ( int i = 0; i < outputBus.GetSignalCount() && !hasOutputs; ++i )
     {
-        // otherwise, copy the signal
-        toBus.CopySignal( toInput, signal );
+        hasOutputs = outputBus.HasValue( i );
     }
 
-    if ( mode == DSPatch::Component::TickMode::Parallel && refs[bufferNo][fromOutput].first > 1 )
+    std::lock_guard<std::mutex> lock( memoMutex );
+
+    // hold on to nothing if there was nothing output, or things have changed since we started processing
+    if ( !hasOutputs || processEpochs[bufferNo] != memoEpoch )
     {
-        refMutexes[bufferNo][fromOutput]->unlock();
+        memoKey.ClearAllValues();
+        return;
+    }
+
+    for ( int i = 0; i < memoKey.GetSignalCount(); ++i )
+    {
+        if ( !memoInputs.ShareSignal( i, memoKey.GetSignal( i ) ) )
+        {
+            memoInputs.GetSignal( i )->ClearValue();
+        }
+    }
+    memoKey.ClearAllValues();
+    for ( int i = 0; i < outputBus.GetSignalCount(); ++i )
+    {
+        if ( !memoOutputs.ShareSignal( i, outputBus.GetSignal( i ) ) )
+        {
+            memoOutputs.GetSignal( i )->ClearValue();
+        }
     }
+
+    memoValid = true;
 }
 
-void internal::Component::IncRefs( int output )
+void internal::Component::GetOutput( int bufferNo, int fromOutput, int toInput, DSPatch::SignalBus& toBus )
 {
-    for ( auto& ref : refs )
+    if ( !outputBuses[bufferNo].HasValue( fromOutput ) )
     {
-        ++ref[output].first;
+        return;
+    }
+
+    // You might be thinking: Don't we need to lock the output while it's being shared?
+
+    // No. An output is never written to while its consumers are reading it (consumers only read an
+    // output once its component is done processing, or, in the case of feedback wires, before it
+    // starts). Hence, fanning an output out to N inputs costs just N atomic reference increments.
+
+    toBus.ShareSignal( toInput, outputBuses[bufferNo].GetSignal( fromOutput ) );
+
+    // You might be thinking: Why let go of an output once every consumer has fetched it?
+
+    // Because while we hold on to it, no consumer can take it over to modify in place (see
+    // SignalBus::TakeMutable()). An output fetched by a feedback wire on the other hand is needed
+    // again next tick, so is held as usual. Each consumer counts its fetch only once it has shared
+    // the output, hence the last to count is free to clear it.
+
+    auto& outputUse = outputUses[bufferNo][fromOutput];
+    if ( outputUse.consumers != 0 && !outputUse.feedback && ++outputUse.fetchCount == outputUse.consumers )
+    {
+        outputUse.fetchCount = 0;
+        outputBuses[bufferNo].GetSignal( fromOutput )->ClearValue();
     }
 }
 
-void internal::Component::DecRefs( int output )
+void internal::Component::SizeOutputUses( int bufferNo )
 {
-    for ( auto& ref : refs )
+    auto& uses = outputUses[bufferNo];
+    size_t outputCount = outputBuses[bufferNo].GetSignalCount();
+
+    while ( uses.size() < outputCount )
+    {
+        uses.emplace_back();
+    }
+    while ( uses.size() > outputCount )
     {
-        --ref[output].first;
+        uses.pop_back();
     }
 }
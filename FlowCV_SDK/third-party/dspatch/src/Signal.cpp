@@ -36,7 +36,7 @@ Signal::Signal()
 
 Signal::~Signal()
 {
-    delete _valueHolder;
+    _ReleaseValue();
 }
 
 bool Signal::HasValue() const
@@ -48,15 +48,16 @@ bool Signal::CopySignal( Signal::SPtr const& fromSignal )
 {
     if ( fromSignal != nullptr && fromSignal->_hasValue )
     {
-        if ( _valueHolder != nullptr && fromSignal->_valueHolder != nullptr &&
-             _valueHolder->GetType() == fromSignal->_valueHolder->GetType() )
+        auto const& type = *fromSignal->_valueHolder->type;
+
+        if ( _valueHolder != nullptr && _valueHolder->type != nullptr && _valueHolder->type->tag == type.tag && !_IsShared() )
         {
-            _valueHolder->SetValue( fromSignal->_valueHolder );
+            type.assign( _valueHolder->storage, fromSignal->_valueHolder->storage );
         }
         else
         {
-            delete _valueHolder;
-            _valueHolder = fromSignal->_valueHolder->GetCopy();
+            type.copy( _ClearHolder(), fromSignal->_valueHolder->storage );
+            _valueHolder->type = &type;
         }
 
         _hasValue = true;
@@ -94,19 +95,103 @@ bool Signal::MoveSignal( Signal::SPtr const& fromSignal )
     }
 }
 
+bool Signal::ShareSignal( Signal::SPtr const& fromSignal )
+{
+    if ( fromSignal != nullptr && fromSignal->_hasValue )
+    {
+        if ( _valueHolder != fromSignal->_valueHolder )
+        {
+            _ReleaseValue();
+
+            _valueHolder = fromSignal->_valueHolder;
+            ++_valueHolder->refCount;
+        }
+
+        _hasValue = true;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool Signal::IsSharedWith( Signal::SPtr const& signal ) const
+{
+    return signal != nullptr && _hasValue && signal->_hasValue && _valueHolder == signal->_valueHolder;
+}
+
 void Signal::ClearValue()
 {
+    // You might be thinking: Why not always release the value here?
+
+    // An unshared value holder is kept so that it can be reused (copy assigned) by the next call
+    // to SetValue(). A shared value holder on the other hand is released, so that whichever signal
+    // ends up holding the last reference to it can reuse it instead.
+
+    if ( _IsShared() )
+    {
+        _ReleaseValue();
+    }
+
     _hasValue = false;
 }
 
 std::type_info const& Signal::GetType() const
 {
-    if ( _valueHolder != nullptr )
+    if ( _valueHolder != nullptr && _valueHolder->type != nullptr )
     {
-        return _valueHolder->GetType();
+        return _valueHolder->type->info;
     }
     else
     {
         return typeid( void );
     }
 }
+
+bool Signal::_IsShared() const
+{
+    return _valueHolder != nullptr && _valueHolder->refCount != 1;
+}
+
+uint64_t Signal::_MakeTag( char const* typeName )
+{
+    // 64-bit FNV-1a hash of the type's name
+    uint64_t tag = 14695981039346656037ull;
+    for ( ; *typeName != '\0'; ++typeName )
+    {
+        tag ^= (unsigned char)*typeName;
+        tag *= 1099511628211ull;
+    }
+    return tag;
+}
+
+void Signal::_ReleaseValue()
+{
+    if ( _valueHolder != nullptr && --_valueHolder->refCount == 0 )
+    {
+        delete _valueHolder;
+    }
+    _valueHolder = nullptr;
+}
+
+void* Signal::_ClearHolder()
+{
+    _hasValue = false;
+
+    if ( _valueHolder == nullptr || _IsShared() )
+    {
+        // we need a holder of our own
+        _ReleaseValue();
+        _valueHolder = new _ValueHolder();
+    }
+    else if ( _valueHolder->type != nullptr )
+    {
+        // destroy the current value in place, so that its storage can be reused for the next
+        auto type = _valueHolder->type;
+        _valueHolder->type = nullptr;
+        type->destroy( _valueHolder->storage );
+    }
+
+    return _valueHolder->storage;
+}
@@ -123,6 +123,18 @@ bool SignalBus::MoveSignal( int toSignalIndex, Signal::SPtr const& fromSignal )
     }
 }
 
+bool SignalBus::ShareSignal( int toSignalIndex, Signal::SPtr const& fromSignal )
+{
+    if ( (size_t)toSignalIndex < _signals.size() )
+    {
+        return _signals[toSignalIndex]->ShareSignal( fromSignal );
+    }
+    else
+    {
+        return false;
+    }
+}
+
 void SignalBus::ClearAllValues()
 {
     for ( auto& signal : _signals )
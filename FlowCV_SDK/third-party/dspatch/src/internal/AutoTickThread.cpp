@@ -72,6 +72,11 @@ void AutoTickThread::Start( DSPatch::Circuit* circuit, DSPatch::Component::TickM
     _stopped = false;
     _pause = false;
 
+    // tick once straight away (in AutoTickMode::SourceDriven, this gives components the chance to
+    // request their next tick)
+    _nextTick = std::chrono::steady_clock::now();
+    _tickRequested = true;
+
     _thread = std::thread( &AutoTickThread::_Run, this );
 }
 
@@ -101,6 +106,7 @@ void AutoTickThread::Pause()
     if ( !_pause && !_stopped )
     {
         _pause = true;
+        _tickCondt.notify_all();   // wake the thread if it is waiting to tick
         _pauseCondt.wait( lock );  // wait for resume
     }
 }
@@ -111,18 +117,67 @@ void AutoTickThread::Resume()
 
     if ( _pause )
     {
+        // the circuit may have changed while paused, so tick once straight away
+        _nextTick = std::chrono::steady_clock::now();
+        _tickRequested = true;
+
         _resumeCondt.notify_all();
         _pause = false;
     }
 }
 
+void AutoTickThread::SetAutoTickMode( DSPatch::Circuit::AutoTickMode autoTickMode, double tickRate )
+{
+    std::lock_guard<std::mutex> lock( _resumeMutex );
+
+    _autoTickMode = autoTickMode;
+    _tickRate = tickRate > 0.0 ? tickRate : 30.0;
+    _tickPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<double>( 1.0 / _tickRate ) );
+
+    _nextTick = std::chrono::steady_clock::now();
+    _tickRequested = true;
+
+    _tickCondt.notify_all();
+}
+
+DSPatch::Circuit::AutoTickMode AutoTickThread::GetAutoTickMode() const
+{
+    return _autoTickMode;
+}
+
+double AutoTickThread::GetAutoTickRate() const
+{
+    return _tickRate;
+}
+
+bool AutoTickThread::RequestTick( std::chrono::steady_clock::time_point when )
+{
+    std::lock_guard<std::mutex> lock( _resumeMutex );
+
+    if ( !_tickRequested || when < _nextTick )
+    {
+        _nextTick = when;
+    }
+    _tickRequested = true;
+
+    _tickCondt.notify_all();
+
+    // return true to indicate that we will tick at the requested time
+    return _autoTickMode == DSPatch::Circuit::AutoTickMode::SourceDriven && !_stopped;
+}
+
 void AutoTickThread::_Run()
 {
     if ( _circuit != nullptr )
     {
         while ( !_stop )
         {
-            _circuit->Tick( _mode );
+            _WaitForTick();
+
+            if ( !_pause )
+            {
+                _circuit->Tick( _mode );
+            }
 
             if ( _pause )
             {
@@ -137,3 +192,58 @@ void AutoTickThread::_Run()
 
     _stopped = true;
 }
+
+void AutoTickThread::_WaitForTick()
+{
+    // (checked before locking, as the circuit locks its own mutex, which is held while resuming)
+    bool endOfStream = _autoTickMode == DSPatch::Circuit::AutoTickMode::Batch && _circuit->IsEndOfStream();
+
+    std::unique_lock<std::mutex> lock( _resumeMutex );
+
+    if ( _autoTickMode == DSPatch::Circuit::AutoTickMode::Clocked )
+    {
+        // wait for this tick's deadline
+        while ( !_pause && !_stop && _autoTickMode == DSPatch::Circuit::AutoTickMode::Clocked &&
+                std::chrono::steady_clock::now() < _nextTick )
+        {
+            _tickCondt.wait_until( lock, _nextTick );
+        }
+
+        // schedule the next tick one period after this tick's deadline (if we have fallen more than
+        // a period behind, rather skip the ticks we missed than try to catch up on them)
+        auto now = std::chrono::steady_clock::now();
+        _nextTick += _tickPeriod;
+        if ( _nextTick < now )
+        {
+            _nextTick = now + _tickPeriod;
+        }
+    }
+    else if ( _autoTickMode == DSPatch::Circuit::AutoTickMode::SourceDriven )
+    {
+        // wait for a tick to be requested, then for the requested time
+        while ( !_pause && !_stop && _autoTickMode == DSPatch::Circuit::AutoTickMode::SourceDriven )
+        {
+            if ( !_tickRequested )
+            {
+                _tickCondt.wait( lock );
+            }
+            else if ( std::chrono::steady_clock::now() < _nextTick )
+            {
+                _tickCondt.wait_until( lock, _nextTick );
+            }
+            else
+            {
+                _tickRequested = false;
+                break;
+            }
+        }
+    }
+    else if ( endOfStream )
+    {
+        // once the stream has ended, there is nothing left to tick
+        while ( !_pause && !_stop && _autoTickMode == DSPatch::Circuit::AutoTickMode::Batch )
+        {
+            _tickCondt.wait( lock );
+        }
+    }
+}
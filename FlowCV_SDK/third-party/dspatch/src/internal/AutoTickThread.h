@@ -31,6 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <dspatch/Circuit.h>
 #include <dspatch/Common.h>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <thread>
 
@@ -46,6 +48,13 @@ An AutoTickThread is responsible for ticking a circuit continuously in a free-ru
 initialisation, a reference to the circuit must be provided for the thread's _Run() method to use.
 Once Start() has been called, the thread will begin, repeatedly calling the circuit's Tick()
 method until instructed to Pause() or Stop().
+
+The rate at which the thread ticks the circuit depends on its AutoTickMode (see SetAutoTickMode()).
+In AutoTickMode::Clocked, each tick is scheduled one tick period after the previous tick's deadline
+(rather than after the previous tick completed), so that the tick rate does not drift. In
+AutoTickMode::SourceDriven, the thread waits for RequestTick() to be called (by the circuit's
+components), ticking once the earliest requested tick time is reached. In AutoTickMode::Batch, the
+thread ticks freely until the circuit reaches end of stream, then waits to be paused or stopped.
 */
 
 class AutoTickThread final
@@ -67,8 +76,15 @@ public:
     void Pause();
     void Resume();
 
+    void SetAutoTickMode( DSPatch::Circuit::AutoTickMode autoTickMode, double tickRate );
+    [[nodiscard]] DSPatch::Circuit::AutoTickMode GetAutoTickMode() const;
+    [[nodiscard]] double GetAutoTickRate() const;
+
+    bool RequestTick( std::chrono::steady_clock::time_point when );
+
 private:
     void _Run();
+    void _WaitForTick();
 
 private:
     DSPatch::Component::TickMode _mode;
@@ -77,8 +93,13 @@ private:
     bool _stop = false;
     bool _pause = false;
     bool _stopped = true;
+    std::atomic<DSPatch::Circuit::AutoTickMode> _autoTickMode{ DSPatch::Circuit::AutoTickMode::FreeRunning };
+    double _tickRate = 30.0;
+    std::chrono::steady_clock::duration _tickPeriod{};
+    std::chrono::steady_clock::time_point _nextTick;
+    bool _tickRequested = false;
     std::mutex _resumeMutex;
-    std::condition_variable _resumeCondt, _pauseCondt;
+    std::condition_variable _resumeCondt, _pauseCondt, _tickCondt;
 };
 
 }  // namespace internal
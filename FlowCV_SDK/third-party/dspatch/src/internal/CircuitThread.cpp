@@ -39,15 +39,16 @@ CircuitThread::~CircuitThread()
     Stop();
 }
 
-void CircuitThread::Start( std::vector<DSPatch::Component::SPtr>* components, int threadNo )
+void CircuitThread::Start( int threadNo, Tracer::SPtr const& tracer )
 {
     if ( !_stopped )
     {
         return;
     }
 
-    _components = components;
+    _components = nullptr;
     _threadNo = threadNo;
+    _tracer = tracer;
 
     _stop = false;
     _stopped = false;
@@ -70,7 +71,7 @@ void CircuitThread::Stop()
 
     _stop = true;
 
-    SyncAndResume( _mode );
+    SyncAndResume( _mode, _components );
 
     if ( _thread.joinable() )
     {
@@ -93,7 +94,7 @@ void CircuitThread::Sync()
     }
 }
 
-void CircuitThread::SyncAndResume( DSPatch::Component::TickMode mode )
+void CircuitThread::SyncAndResume( DSPatch::Component::TickMode mode, std::vector<DSPatch::Component*> const* components )
 {
     if ( _stopped )
     {
@@ -109,6 +110,7 @@ void CircuitThread::SyncAndResume( DSPatch::Component::TickMode mode )
     _gotSync = false;  // reset the sync flag
 
     _mode = mode;
+    _components = components;
 
     _gotResume = true;  // set the resume flag
     _resumeCondt.notify_all();
@@ -116,43 +118,52 @@ void CircuitThread::SyncAndResume( DSPatch::Component::TickMode mode )
 
 void CircuitThread::_Run()
 {
-    if ( _components != nullptr )
+    if ( _tracer )
+    {
+        _tracer->NameThread( "Circuit Thread " + std::to_string( _threadNo ) );
+    }
+
+    while ( !_stop )
     {
-        while ( !_stop )
         {
+            std::unique_lock<std::mutex> lock( _resumeMutex );
+
+            _gotSync = true;  // set the sync flag
+            _syncCondt.notify_all();
+
+            if ( !_gotResume )  // if haven't already got resume
             {
-                std::unique_lock<std::mutex> lock( _resumeMutex );
+                _resumeCondt.wait( lock );  // wait for resume
+            }
+            _gotResume = false;  // reset the resume flag
+        }
+
+        if ( !_stop && _components != nullptr )
+        {
+            // You might be thinking: Can't we have each thread start on a different component?
+
+            // Well no. Because threadNo == bufferNo, in order to maintain synchronisation
+            // within the circuit, when a component wants to process its buffers in-order, it
+            // requires that every other in-order component in the system has not only
+            // processed its buffers in the same order, but has processed the same number of
+            // buffers too.
 
-                _gotSync = true;  // set the sync flag
-                _syncCondt.notify_all();
+            // E.g. 1,2,3 and 1,2,3. Not 1,2,3 and 2,3,1,2,3.
 
-                if ( !_gotResume )  // if haven't already got resume
-                {
-                    _resumeCondt.wait( lock );  // wait for resume
-                }
-                _gotResume = false;  // reset the resume flag
+            auto tickStart = std::chrono::steady_clock::now();
+
+            for ( auto component : *_components )
+            {
+                component->Tick( _mode, _threadNo );
+            }
+            for ( auto component : *_components )
+            {
+                component->Reset( _threadNo );
             }
 
-            if ( !_stop )
+            if ( _tracer )
             {
-                // You might be thinking: Can't we have each thread start on a different component?
-
-                // Well no. Because threadNo == bufferNo, in order to maintain synchronisation
-                // within the circuit, when a component wants to process its buffers in-order, it
-                // requires that every other in-order component in the system has not only
-                // processed its buffers in the same order, but has processed the same number of
-                // buffers too.
-
-                // E.g. 1,2,3 and 1,2,3. Not 1,2,3 and 2,3,1,2,3.
-
-                for ( auto& component : *_components )
-                {
-                    component->Tick( _mode, _threadNo );
-                }
-                for ( auto& component : *_components )
-                {
-                    component->Reset( _threadNo );
-                }
+                _tracer->Record( "Tick", "circuit", _threadNo, tickStart, std::chrono::steady_clock::now() );
             }
         }
     }
@@ -30,6 +30,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <dspatch/Component.h>
 
+#include <internal/Tracer.h>
+
 #include <condition_variable>
 #include <thread>
 
@@ -41,21 +43,23 @@ namespace internal
 /// Thread class for asynchronously ticking circuit components
 
 /**
-A CircuitThread is responsible for ticking and reseting all components within a Circuit. Upon
-initialisation, a reference to the vector of circuit components must be provided for the thread
-_Run() method to loop through. Each CircuitThread has a thread number (threadNo), which is also
-provided upon initialisation. When creating multiple CircuitThreads, each thread must have their
+A CircuitThread is responsible for ticking and reseting all components within a Circuit. Each
+time the thread is resumed, a reference to the schedule (the components in tick order) bound to
+its buffer must be provided for the thread _Run() method to loop through. Each CircuitThread has a
+thread number (threadNo), which is provided upon initialisation. When creating multiple CircuitThreads, each thread must have their
 own unique thread number, beginning at 0 and incrementing by 1 for every thread added. This thread
 number corresponds with the Component's buffer number when calling it's Tick() and Reset() methods
 in the CircuitThread's component loop. Hence, for every circuit thread created, each component's
 buffer count within that circuit must be incremented to match.
 
-The SyncAndResume() method causes the CircuitThread to tick and reset all circuit components once,
+The SyncAndResume() method causes the CircuitThread to tick and reset all scheduled components once,
 after which the thread will wait until instructed to resume again. As each component is done
 processing it hands over control to the next waiting circuit thread, therefore, from an external
 control loop (I.e. Circuit's Tick() method) we can simply loop through our array of CircuitThreads
 calling SyncAndResume() on each. If a circuit thread is busy processing, a call to SyncAndResume()
 will block momentarily until that thread is done processing.
+
+Each tick is recorded as a span to the tracer provided upon initialisation (while it is tracing).
 */
 
 class CircuitThread final
@@ -67,10 +71,10 @@ public:
     CircuitThread();
     ~CircuitThread();
 
-    void Start( std::vector<DSPatch::Component::SPtr>* components, int threadNo );
+    void Start( int threadNo, Tracer::SPtr const& tracer );
     void Stop();
     void Sync();
-    void SyncAndResume( DSPatch::Component::TickMode mode );
+    void SyncAndResume( DSPatch::Component::TickMode mode, std::vector<DSPatch::Component*> const* components );
 
 private:
     void _Run();
@@ -78,8 +82,9 @@ private:
 private:
     DSPatch::Component::TickMode _mode;
     std::thread _thread;
-    std::vector<DSPatch::Component::SPtr>* _components = nullptr;
+    std::vector<DSPatch::Component*> const* _components = nullptr;
     int _threadNo = 0;
+    Tracer::SPtr _tracer;
     bool _stop = false;
     bool _stopped = true;
     bool _gotResume = false;
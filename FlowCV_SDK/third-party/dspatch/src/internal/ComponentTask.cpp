@@ -0,0 +1,135 @@
+/******************************************************************************
+DSPatch - The Refreshingly Simple C++ Dataflow Framework
+Copyright (c) 2021, Marcus Tomlinson
+
+BSD 2-Clause License
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <internal/ComponentTask.h>
+
+using namespace DSPatch::internal;
+
+ComponentTask::ComponentTask()
+{
+}
+
+ComponentTask::~ComponentTask()
+{
+    Sync();
+}
+
+void ComponentTask::Start( std::function<void()> const& tick, ThreadPool* threadPool )
+{
+    std::lock_guard<std::mutex> lock( _doneMutex );
+
+    _tick = tick;
+    _threadPool = threadPool;
+
+    _done = false;
+}
+
+void ComponentTask::AddDependent( ComponentTask& dependent )
+{
+    std::lock_guard<std::mutex> lock( _doneMutex );
+
+    if ( !_done )
+    {
+        ++dependent._dependencyCount;
+        _dependents.emplace_back( &dependent );
+    }
+}
+
+void ComponentTask::Link( ComponentTask& dependent )
+{
+    ++dependent._linkedDependencyCount;
+    ++dependent._dependencyCount;
+    _linkedDependents.emplace_back( &dependent );
+}
+
+void ComponentTask::Unlink()
+{
+    // linked dependents may already be destroyed, so we only discard our own end of each link
+    _linkedDependents.clear();
+    _linkedDependencyCount = 0;
+    _dependencyCount = 1;
+}
+
+void ComponentTask::Release()
+{
+    if ( --_dependencyCount != 0 )
+    {
+        return;
+    }
+
+    if ( _threadPool != nullptr )
+    {
+        // submit a copy, as _tick is re-assigned by the next Start() as soon as Done() is called
+        _threadPool->Submit( std::function<void()>( _tick ) );
+    }
+    else
+    {
+        _tick();
+    }
+}
+
+void ComponentTask::Done()
+{
+    // linked dependents are released before we are marked done, as once done (and synced), our
+    // links may be discarded
+    if ( !_linkedDependents.empty() )
+    {
+        // release the most critical dependent last, for this worker to carry on with
+        for ( size_t i = 1; i < _linkedDependents.size(); ++i )
+        {
+            _linkedDependents[i]->Release();
+        }
+        _linkedDependents[0]->Release();
+    }
+
+    std::vector<ComponentTask*> dependents;
+
+    {
+        std::lock_guard<std::mutex> lock( _doneMutex );
+
+        _done = true;
+        std::swap( dependents, _dependents );
+
+        // re-arm for the next tick (held until Release() is called)
+        _dependencyCount = _linkedDependencyCount + 1;
+
+        _doneCondt.notify_all();
+    }
+
+    for ( auto dependent : dependents )
+    {
+        dependent->Release();
+    }
+}
+
+void ComponentTask::Sync()
+{
+    std::unique_lock<std::mutex> lock( _doneMutex );
+
+    _doneCondt.wait( lock, [this] { return _done; } );  // wait for done
+}
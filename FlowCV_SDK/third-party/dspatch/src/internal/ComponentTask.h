@@ -0,0 +1,95 @@
+/******************************************************************************
+DSPatch - The Refreshingly Simple C++ Dataflow Framework
+Copyright (c) 2021, Marcus Tomlinson
+
+BSD 2-Clause License
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <internal/ThreadPool.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+
+namespace DSPatch
+{
+namespace internal
+{
+
+/// Dependency-counted task for ticking a single circuit component on a ThreadPool
+
+/**
+A ComponentTask's primary purpose is to tick parallel circuit components in parallel, without
+dedicating a thread to every component buffer.
+
+Start() arms the task with the tick method to execute and the pool to execute it on. Any number of
+dependencies can then be added by calling AddDependent() on the tasks of the component's incoming
+components. Once Release() has been called, the tick method is submitted to the pool as soon as
+every dependency has called Done(). The tick method itself must call Done() when it has completed,
+which in turn releases the task's own dependents. A call to Sync() blocks until Done() is called.
+
+Alternatively, dependents can be linked to a task once via Link(), in which case they remain
+dependents of the task for every subsequent tick, and need not be added again via AddDependent().
+Unlink() only discards the links held by the task itself, so it must be called on every task
+involved in order to discard a set of links.
+
+Linked dependents should be linked most critical first. On Done(), the first linked dependent is
+released last, so that whichever worker ran the task goes on to run it itself (as the most recently
+added task on that worker's queue), while idle workers steal the rest in the order they were linked.
+*/
+
+class ComponentTask final
+{
+public:
+    NONCOPYABLE( ComponentTask );
+    DEFINE_PTRS( ComponentTask );
+
+    ComponentTask();
+    ~ComponentTask();
+
+    void Start( std::function<void()> const& tick, ThreadPool* threadPool );
+    void AddDependent( ComponentTask& dependent );
+    void Link( ComponentTask& dependent );
+    void Unlink();
+    void Release();
+    void Done();
+    void Sync();
+
+private:
+    std::function<void()> _tick;
+    ThreadPool* _threadPool = nullptr;
+    std::atomic<int> _dependencyCount{ 1 };
+    std::vector<ComponentTask*> _dependents;
+    std::vector<ComponentTask*> _linkedDependents;
+    int _linkedDependencyCount = 0;
+    bool _done = true;
+    std::mutex _doneMutex;
+    std::condition_variable _doneCondt;
+};
+
+}  // namespace internal
+}  // namespace DSPatch
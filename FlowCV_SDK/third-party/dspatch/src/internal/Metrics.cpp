@@ -0,0 +1,98 @@
+/******************************************************************************
+DSPatch - The Refreshingly Simple C++ Dataflow Framework
+Copyright (c) 2021, Marcus Tomlinson
+
+BSD 2-Clause License
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <internal/Metrics.h>
+
+using namespace DSPatch::internal;
+
+Histogram::Histogram()
+{
+    Reset();
+}
+
+void Histogram::Record( std::chrono::nanoseconds duration )
+{
+    int64_t ns = duration.count() > 0 ? duration.count() : 0;
+
+    int bucket = 0;
+    for ( int64_t n = ns >> 1; n != 0 && bucket < DSPatch::Component::Histogram::bucketCount - 1; n >>= 1 )
+    {
+        ++bucket;
+    }
+
+    _buckets[bucket].fetch_add( 1, std::memory_order_relaxed );
+    _total.fetch_add( ns, std::memory_order_relaxed );
+    _count.fetch_add( 1, std::memory_order_relaxed );
+
+    int64_t max = _max.load( std::memory_order_relaxed );
+    while ( ns > max && !_max.compare_exchange_weak( max, ns, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+void Histogram::Get( DSPatch::Component::Histogram& histogram ) const
+{
+    histogram.count = _count.load( std::memory_order_relaxed );
+    histogram.total = std::chrono::nanoseconds( _total.load( std::memory_order_relaxed ) );
+    histogram.max = std::chrono::nanoseconds( _max.load( std::memory_order_relaxed ) );
+    for ( int i = 0; i < DSPatch::Component::Histogram::bucketCount; ++i )
+    {
+        histogram.buckets[i] = _buckets[i].load( std::memory_order_relaxed );
+    }
+}
+
+void Histogram::Reset()
+{
+    _count = 0;
+    _total = 0;
+    _max = 0;
+    for ( auto& bucket : _buckets )
+    {
+        bucket = 0;
+    }
+}
+
+void BufferMetrics::Get( DSPatch::Component::Metrics& metrics ) const
+{
+    metrics.tickCount = tickCount.load( std::memory_order_relaxed );
+    metrics.reuseCount = reuseCount.load( std::memory_order_relaxed );
+    metrics.dropCount = dropCount.load( std::memory_order_relaxed );
+    processTime.Get( metrics.processTime );
+    waitTime.Get( metrics.waitTime );
+    syncTime.Get( metrics.syncTime );
+}
+
+void BufferMetrics::Reset()
+{
+    tickCount = 0;
+    reuseCount = 0;
+    dropCount = 0;
+    processTime.Reset();
+    waitTime.Reset();
+    syncTime.Reset();
+}
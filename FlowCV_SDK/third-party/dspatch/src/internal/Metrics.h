@@ -28,53 +28,57 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
-#include <dspatch/Common.h>
+#include <dspatch/Component.h>
 
-#include <condition_variable>
-#include <thread>
-#include <functional>
+#include <atomic>
+#include <chrono>
 
 namespace DSPatch
 {
 namespace internal
 {
 
-/// Thread class for asynchronously ticking a single circuit component
+/// Lock-free recorder of a Component::Histogram
 
 /**
-A ComponentThread's primary purpose is to tick parallel circuit components in parallel.
-
-Upon Start(), an internal thread will spawn and wait for the first call to Resume() before
-executing the tick method provided. A call to Sync() will then block until the thread has completed
-execution of the tick method. At this point, the thread will wait until instructed to resume again.
+Record() can be called from any number of threads at once, and Get() at any time. A Get() that
+overlaps a Record() may see the recorded duration in some totals and not yet in others, which is of
+no consequence to a histogram used for monitoring.
 */
 
-class ComponentThread final
+class Histogram final
 {
 public:
-    NONCOPYABLE( ComponentThread );
-    DEFINE_PTRS( ComponentThread );
+    NONCOPYABLE( Histogram );
 
-    ComponentThread();
-    ~ComponentThread();
+    Histogram();
 
-    void Start();
-    void Stop();
-    void Sync();
-    void Resume( std::function<void()> const& tick );
+    void Record( std::chrono::nanoseconds duration );
+    void Get( DSPatch::Component::Histogram& histogram ) const;
+    void Reset();
 
 private:
-    void _Run();
+    std::atomic<int64_t> _count;
+    std::atomic<int64_t> _total;
+    std::atomic<int64_t> _max;
+    std::atomic<int64_t> _buckets[DSPatch::Component::Histogram::bucketCount];
+};
 
-private:
-    std::thread _thread;
-    bool _stop = false;
-    bool _stopped = true;
-    bool _gotResume = false;
-    bool _gotSync = true;
-    std::mutex _resumeMutex;
-    std::condition_variable _resumeCondt, _syncCondt;
-    std::function<void()> _tick;
+/// Metrics recorded for a single component buffer
+
+struct BufferMetrics final
+{
+    void Get( DSPatch::Component::Metrics& metrics ) const;
+    void Reset();
+
+    std::atomic<int64_t> tickCount{ 0 };
+    std::atomic<int64_t> reuseCount{ 0 };
+    std::atomic<int64_t> dropCount{ 0 };
+    Histogram processTime;
+    Histogram waitTime;
+    Histogram syncTime;
+
+    std::chrono::steady_clock::time_point queueTime;  // when the buffer's current tick queued for its turn
 };
 
 }  // namespace internal
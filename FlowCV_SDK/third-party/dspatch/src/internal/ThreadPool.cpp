@@ -0,0 +1,234 @@
+/******************************************************************************
+DSPatch - The Refreshingly Simple C++ Dataflow Framework
+Copyright (c) 2021, Marcus Tomlinson
+
+BSD 2-Clause License
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <internal/ThreadPool.h>
+
+#include <algorithm>
+#include <exception>
+
+using namespace DSPatch::internal;
+
+namespace
+{
+
+// identifies the pool (and queue) owned by the current worker thread, if any
+thread_local ThreadPool const* tlsPool = nullptr;
+thread_local int tlsThreadNo = -1;
+
+}  // namespace
+
+ThreadPool::ThreadPool( int threadCount )
+{
+    if ( threadCount <= 0 )
+    {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if ( threadCount <= 0 )
+    {
+        threadCount = 1;  // hardware_concurrency() is allowed to return 0
+    }
+
+    for ( int i = 0; i < threadCount; ++i )
+    {
+        _queues.emplace_back( new _Queue() );
+    }
+
+    for ( int i = 0; i < threadCount; ++i )
+    {
+        _threads.emplace_back( &ThreadPool::_Run, this, i );
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock( _idleMutex );
+        _stop = true;
+    }
+    _idleCondt.notify_all();
+
+    for ( auto& thread : _threads )
+    {
+        if ( thread.joinable() )
+        {
+            thread.join();
+        }
+    }
+}
+
+int ThreadPool::GetThreadCount() const
+{
+    return _threads.size();
+}
+
+void ThreadPool::Submit( std::function<void()>&& task )
+{
+    // keep tasks submitted from a worker on that worker's queue (they most likely use the same data)
+    int queueNo = tlsPool == this ? tlsThreadNo : _nextQueue++ % _queues.size();
+
+    {
+        std::lock_guard<std::mutex> lock( _queues[queueNo]->mutex );
+        _queues[queueNo]->tasks.emplace_back( std::move( task ) );
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( _idleMutex );
+        ++_taskCount;
+    }
+    _idleCondt.notify_one();
+}
+
+void ThreadPool::ParallelFor( int count, std::function<void( int )> const& body )
+{
+    struct Loop
+    {
+        std::function<void( int )> const* body;
+        int count;
+        std::atomic<int> nextIndex{ 0 };
+        int doneCount = 0;
+        std::exception_ptr exception;
+        std::mutex doneMutex;
+        std::condition_variable doneCondt;
+    };
+
+    // You might be thinking: Why not just submit one task per index and wait for them all?
+
+    // The calling thread may be a worker itself, and the pool may have no other worker free to run
+    // those tasks. Instead, every thread (the caller included) claims indices until none are left,
+    // so that the caller only ever waits on indices already claimed (and hence running).
+
+    auto loop = std::make_shared<Loop>();
+    loop->body = &body;
+    loop->count = count;
+
+    auto run = [loop]() {
+        int doneCount = 0;
+
+        // the body is only dereferenced for claimed indices, which are all run before we return
+        for ( int i = loop->nextIndex++; i < loop->count; i = loop->nextIndex++ )
+        {
+            try
+            {
+                ( *loop->body )( i );
+            }
+            catch ( ... )
+            {
+                std::lock_guard<std::mutex> lock( loop->doneMutex );
+                if ( loop->exception == nullptr )
+                {
+                    loop->exception = std::current_exception();
+                }
+            }
+            ++doneCount;
+        }
+
+        if ( doneCount != 0 )
+        {
+            std::lock_guard<std::mutex> lock( loop->doneMutex );
+            loop->doneCount += doneCount;
+            if ( loop->doneCount == loop->count )
+            {
+                loop->doneCondt.notify_all();
+            }
+        }
+    };
+
+    for ( int i = 1; i < std::min( count, GetThreadCount() + 1 ); ++i )
+    {
+        Submit( run );
+    }
+
+    run();
+
+    std::unique_lock<std::mutex> lock( loop->doneMutex );
+
+    loop->doneCondt.wait( lock, [&loop] { return loop->doneCount == loop->count; } );  // wait for done
+
+    if ( loop->exception != nullptr )
+    {
+        std::rethrow_exception( loop->exception );
+    }
+}
+
+bool ThreadPool::_PopTask( int threadNo, std::function<void()>& task )
+{
+    // 1. take the most recently added task from our own queue
+    {
+        auto& queue = *_queues[threadNo];
+        std::lock_guard<std::mutex> lock( queue.mutex );
+        if ( !queue.tasks.empty() )
+        {
+            task = std::move( queue.tasks.back() );
+            queue.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // 2. otherwise, steal the oldest task from another worker's queue
+    for ( size_t i = 1; i < _queues.size(); ++i )
+    {
+        auto& queue = *_queues[( threadNo + i ) % _queues.size()];
+        std::lock_guard<std::mutex> lock( queue.mutex );
+        if ( !queue.tasks.empty() )
+        {
+            task = std::move( queue.tasks.front() );
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::_Run( int threadNo )
+{
+    tlsPool = this;
+    tlsThreadNo = threadNo;
+
+    std::function<void()> task;
+
+    while ( true )
+    {
+        if ( _PopTask( threadNo, task ) )
+        {
+            --_taskCount;
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock( _idleMutex );
+
+        _idleCondt.wait( lock, [this] { return _stop || _taskCount > 0; } );  // wait for work
+
+        if ( _stop )
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/******************************************************************************
+DSPatch - The Refreshingly Simple C++ Dataflow Framework
+Copyright (c) 2021, Marcus Tomlinson
+
+BSD 2-Clause License
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <dspatch/Common.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace DSPatch
+{
+namespace internal
+{
+
+/// Fixed-size work-stealing thread pool for ticking circuit components
+
+/**
+A ThreadPool owns a fixed set of worker threads (by default, one per hardware thread) that execute
+tasks submitted via Submit(). Each worker has its own task queue: tasks submitted from within a
+worker are pushed onto that worker's queue, while tasks submitted from any other thread are
+distributed round-robin across all queues. A worker takes tasks from the back of its own queue and,
+when that is empty, steals from the front of the other workers' queues.
+
+Tasks submitted to a ThreadPool must never block waiting on another task in the same pool, as there
+is no guarantee that a free worker will be available to run it.
+
+ParallelFor() runs a loop body for every index of a range across the pool, returning once every
+index has been run. The calling thread runs indices too, and only ever waits on indices that other
+workers have already started running, hence ParallelFor() may safely be called from within a task.
+An exception thrown by the loop body is rethrown to the calling thread.
+*/
+
+class ThreadPool final
+{
+public:
+    NONCOPYABLE( ThreadPool );
+    DEFINE_PTRS( ThreadPool );
+
+    explicit ThreadPool( int threadCount = 0 );
+    ~ThreadPool();
+
+    [[nodiscard]] int GetThreadCount() const;
+
+    void Submit( std::function<void()>&& task );
+    void ParallelFor( int count, std::function<void( int )> const& body );
+
+private:
+    void _Run( int threadNo );
+    bool _PopTask( int threadNo, std::function<void()>& task );
+
+private:
+    struct _Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::thread> _threads;
+    std::vector<std::unique_ptr<_Queue>> _queues;
+    std::atomic<unsigned int> _nextQueue{ 0 };
+    std::atomic<int> _taskCount{ 0 };
+    bool _stop = false;
+    std::mutex _idleMutex;
+    std::condition_variable _idleCondt;
+};
+
+}  // namespace internal
+}  // namespace DSPatch
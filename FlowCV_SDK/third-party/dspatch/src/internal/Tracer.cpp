@@ -0,0 +1,205 @@
+/******************************************************************************
+DSPatch - The Refreshingly Simple C++ Dataflow Framework
+Copyright (c) 2021, Marcus Tomlinson
+
+BSD 2-Clause License
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <internal/Tracer.h>
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace DSPatch::internal;
+
+namespace
+{
+
+std::atomic<uint64_t> nextTracerId{ 0 };
+
+// the current thread's span list in each tracer it has recorded to (most recently used first)
+thread_local std::vector<std::pair<uint64_t, void*>> tlsThreads;
+
+void WriteString( std::ostream& out, std::string const& str )
+{
+    out << '"';
+    for ( char c : str )
+    {
+        if ( c == '"' || c == '\\' )
+        {
+            out << '\\' << c;
+        }
+        else if ( (unsigned char)c < 0x20 )
+        {
+            char escaped[8];
+            snprintf( escaped, sizeof( escaped ), "\\u%04x", c );
+            out << escaped;
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+}  // namespace
+
+Tracer::Tracer()
+    : _id( nextTracerId++ )
+{
+}
+
+void Tracer::Start( int64_t maxEvents )
+{
+    std::lock_guard<std::mutex> lock( _threadsMutex );
+
+    for ( auto& thread : _threads )
+    {
+        std::lock_guard<std::mutex> threadLock( thread->mutex );
+        thread->events.clear();
+    }
+
+    _eventCount = 0;
+    _truncatedAt = -1;
+    _maxEvents = maxEvents;
+    _origin = std::chrono::steady_clock::now();
+    _tracing.store( true, std::memory_order_release );
+}
+
+void Tracer::Stop()
+{
+    _tracing.store( false, std::memory_order_release );
+}
+
+void Tracer::NameThread( std::string const& name )
+{
+    auto thread = _CurrentThread();
+
+    std::lock_guard<std::mutex> lock( thread->mutex );
+    thread->name = name;
+}
+
+void Tracer::Record( char const* name,
+                     char const* category,
+                     int bufferNo,
+                     std::chrono::steady_clock::time_point start,
+                     std::chrono::steady_clock::time_point end )
+{
+    if ( !IsTracing() )
+    {
+        return;
+    }
+
+    auto eventCount = ++_eventCount;
+    if ( eventCount > _maxEvents )
+    {
+        // only the first span over the limit marks where the trace was truncated
+        if ( eventCount == _maxEvents + 1 )
+        {
+            _truncatedAt = std::chrono::duration_cast<std::chrono::nanoseconds>( start - _origin ).count();
+        }
+        _tracing.store( false, std::memory_order_release );
+        return;
+    }
+
+    auto thread = _CurrentThread();
+
+    std::lock_guard<std::mutex> lock( thread->mutex );
+    thread->events.emplace_back( _Event{ name,
+                                         category,
+                                         bufferNo,
+                                         std::chrono::duration_cast<std::chrono::nanoseconds>( start - _origin ).count(),
+                                         std::chrono::duration_cast<std::chrono::nanoseconds>( end - start ).count() } );
+}
+
+void Tracer::Write( std::ostream& out ) const
+{
+    std::lock_guard<std::mutex> lock( _threadsMutex );
+
+    // timestamps are in microseconds, with the nanoseconds kept as decimals
+    auto writeTime = [&out]( int64_t ns ) {
+        char time[32];
+        snprintf( time, sizeof( time ), "%.3f", (double)ns / 1000.0 );
+        out << time;
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    for ( size_t i = 0; i < _threads.size(); ++i )
+    {
+        auto& thread = *_threads[i];
+        std::lock_guard<std::mutex> threadLock( thread.mutex );
+
+        if ( !thread.name.empty() )
+        {
+            out << ( first ? "\n" : ",\n" ) << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i + 1 << ",\"args\":{\"name\":";
+            WriteString( out, thread.name );
+            out << "}}";
+            first = false;
+        }
+
+        for ( auto const& event : thread.events )
+        {
+            out << ( first ? "\n" : ",\n" ) << "{\"name\":";
+            WriteString( out, event.name );
+            out << ",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"ts\":";
+            writeTime( event.start );
+            out << ",\"dur\":";
+            writeTime( event.duration );
+            out << ",\"pid\":1,\"tid\":" << i + 1 << ",\"args\":{\"buffer\":" << event.bufferNo << "}}";
+            first = false;
+        }
+    }
+
+    auto truncatedAt = _truncatedAt.load();
+    if ( truncatedAt >= 0 )
+    {
+        out << ( first ? "\n" : ",\n" ) << "{\"name\":\"trace truncated\",\"cat\":\"tracer\",\"ph\":\"i\",\"s\":\"g\",\"ts\":";
+        writeTime( truncatedAt );
+        out << ",\"pid\":1,\"tid\":0,\"args\":{\"maxEvents\":" << _maxEvents << "}}";
+    }
+
+    out << "\n]}\n";
+}
+
+Tracer::_Thread* Tracer::_CurrentThread()
+{
+    auto cached = std::find_if( tlsThreads.begin(), tlsThreads.end(), [this]( auto const& entry ) { return entry.first == _id; } );
+    if ( cached == tlsThreads.end() )
+    {
+        std::lock_guard<std::mutex> lock( _threadsMutex );
+
+        _threads.emplace_back( new _Thread() );
+        tlsThreads.emplace_back( _id, _threads.back().get() );
+        cached = tlsThreads.end() - 1;
+    }
+    if ( cached != tlsThreads.begin() )
+    {
+        std::iter_swap( cached, tlsThreads.begin() );
+    }
+
+    return static_cast<_Thread*>( tlsThreads.front().second );
+}
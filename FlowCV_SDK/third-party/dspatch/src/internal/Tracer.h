@@ -0,0 +1,123 @@
+/******************************************************************************
+DSPatch - The Refreshingly Simple C++ Dataflow Framework
+Copyright (c) 2021, Marcus Tomlinson
+
+BSD 2-Clause License
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <dspatch/Common.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace DSPatch
+{
+namespace internal
+{
+
+/// Recorder of timed spans for exporting a circuit's timeline
+
+/**
+A Tracer records spans (a name, a category, a buffer number, and when it started and ended) from
+any number of threads between Start() and Stop(), then Write() outputs them in the Chrome Trace
+Event format, which chrome://tracing and Perfetto can display as a timeline per thread.
+
+Record() returns immediately while the tracer is stopped. While started, each thread appends to its
+own list of spans, hence threads only ever contend with Write(). Once maxEvents spans have been
+recorded, the tracer stops itself so that a long run can't exhaust memory. IsTruncated() then returns
+true, and Write() marks the point at which the trace was cut short.
+
+NameThread() names the calling thread's row of the timeline.
+*/
+
+class Tracer final
+{
+public:
+    NONCOPYABLE( Tracer );
+    DEFINE_PTRS( Tracer );
+
+    Tracer();
+
+    void Start( int64_t maxEvents );
+    void Stop();
+
+    bool IsTracing() const
+    {
+        return _tracing.load( std::memory_order_acquire );  // pairs with Start() to see _origin and _maxEvents
+    }
+
+    bool IsTruncated() const
+    {
+        return _truncatedAt.load( std::memory_order_relaxed ) >= 0;
+    }
+
+    void NameThread( std::string const& name );
+    void Record( char const* name,
+                 char const* category,
+                 int bufferNo,
+                 std::chrono::steady_clock::time_point start,
+                 std::chrono::steady_clock::time_point end );
+
+    void Write( std::ostream& out ) const;
+
+private:
+    struct _Event
+    {
+        std::string name;
+        char const* category;
+        int bufferNo;
+        int64_t start;     // nanoseconds since Start()
+        int64_t duration;  // nanoseconds
+    };
+
+    struct _Thread
+    {
+        std::mutex mutex;
+        std::string name;
+        std::vector<_Event> events;
+    };
+
+    _Thread* _CurrentThread();
+
+    uint64_t const _id;  // distinguishes this tracer from any other (past or present) in a thread's cache
+
+    std::atomic<bool> _tracing{ false };
+    std::atomic<int64_t> _eventCount{ 0 };
+    std::atomic<int64_t> _truncatedAt{ -1 };  // nanoseconds since Start() of the first span not recorded
+    int64_t _maxEvents = 0;
+    std::chrono::steady_clock::time_point _origin;
+
+    mutable std::mutex _threadsMutex;
+    std::vector<std::unique_ptr<_Thread>> _threads;
+};
+
+}  // namespace internal
+}  // namespace DSPatch
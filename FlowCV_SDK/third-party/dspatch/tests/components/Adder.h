@@ -3,11 +3,11 @@
 namespace DSPatch
 {
 
-class Adder : public Component
+class Adder : public TestComponent
 {
 public:
     Adder()
-        : Component( ProcessOrder::OutOfOrder )
+        : TestComponent( ProcessOrder::OutOfOrder )
     {
         SetInputCount_( 2 );
         SetOutputCount_( 1 );
@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class BranchSyncProbe : public Component
+class BranchSyncProbe : public TestComponent
 {
 public:
     BranchSyncProbe()
@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class ChangingCounter : public Component
+class ChangingCounter : public TestComponent
 {
 public:
     ChangingCounter()
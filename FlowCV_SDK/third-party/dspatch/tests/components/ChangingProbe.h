@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class ChangingProbe : public Component
+class ChangingProbe : public TestComponent
 {
 public:
     ChangingProbe()
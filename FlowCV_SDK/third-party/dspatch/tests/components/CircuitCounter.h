@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class CircuitCounter : public Component
+class CircuitCounter : public TestComponent
 {
 public:
     CircuitCounter()
@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class CircuitProbe : public Component
+class CircuitProbe : public TestComponent
 {
 public:
     CircuitProbe()
@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class Counter : public Component
+class Counter : public TestComponent
 {
 public:
     Counter( int increment = 1 )
@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class FeedbackProbe : public Component
+class FeedbackProbe : public TestComponent
 {
 public:
     FeedbackProbe()
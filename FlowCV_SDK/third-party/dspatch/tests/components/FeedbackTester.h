@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class FeedbackTester : public Component
+class FeedbackTester : public TestComponent
 {
 public:
     FeedbackTester( int bufferCount )
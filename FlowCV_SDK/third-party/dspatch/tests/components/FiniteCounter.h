@@ -0,0 +1,41 @@
+#pragma once
+
+namespace DSPatch
+{
+
+// Counts up to a given count then ends its stream, or fails to start at all (E.g. like a file reader)
+class FiniteCounter : public TestComponent
+{
+public:
+    FiniteCounter( int count, std::string error = "" )
+        : _count( count )
+        , _error( std::move( error ) )
+    {
+        SetOutputCount_( 1 );
+        SetFiniteSource_();
+    }
+
+protected:
+    virtual void Process_( SignalBus const&, SignalBus& outputs ) override
+    {
+        if ( !_error.empty() )
+        {
+            SetStreamError_( _error );
+        }
+        else if ( _next < _count )
+        {
+            outputs.SetValue( 0, _next++ );
+        }
+        else
+        {
+            SetEndOfStream_();
+        }
+    }
+
+private:
+    int _count;
+    int _next = 0;
+    std::string _error;
+};
+
+}  // namespace DSPatch
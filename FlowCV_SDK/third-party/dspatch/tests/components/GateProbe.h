@@ -0,0 +1,49 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace DSPatch
+{
+
+// Holds its first tick until Open() is called, letting later buffers queue up behind it
+class GateProbe : public TestComponent
+{
+public:
+    GateProbe()
+    {
+        SetInputCount_( 1 );
+    }
+
+    void Open()
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _open = true;
+        _condt.notify_all();
+    }
+
+    std::vector<int> Processed()
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        return _processed;
+    }
+
+protected:
+    virtual void Process_( SignalBus const& inputs, SignalBus& ) override
+    {
+        auto in = inputs.GetValue<int>( 0 );
+
+        std::unique_lock<std::mutex> lock( _mutex );
+        _condt.wait( lock, [this] { return _open; } );
+        _processed.push_back( in ? *in : -1 );
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _condt;
+    bool _open = false;
+    std::vector<int> _processed;
+};
+
+}  // namespace DSPatch
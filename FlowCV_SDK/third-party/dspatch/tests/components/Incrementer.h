@@ -3,11 +3,11 @@
 namespace DSPatch
 {
 
-class Incrementer : public Component
+class Incrementer : public TestComponent
 {
 public:
     Incrementer( int increment = 1 )
-        : Component( ProcessOrder::OutOfOrder )
+        : TestComponent( ProcessOrder::OutOfOrder )
         , _increment( increment )
     {
         SetInputCount_( 1 );
@@ -17,7 +17,7 @@ public:
 protected:
     virtual void Process_( SignalBus const& inputs, SignalBus& outputs ) override
     {
-        auto in = inputs.GetValue<int>( 0 );
+        auto in = inputs.TakeMutable<int>( 0 );  // the counter's output is shared by every incrementer
         if ( in )
         {
             *in += _increment;
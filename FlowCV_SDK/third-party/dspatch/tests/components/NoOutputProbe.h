@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class NoOutputProbe : public Component
+class NoOutputProbe : public TestComponent
 {
 public:
     NoOutputProbe()
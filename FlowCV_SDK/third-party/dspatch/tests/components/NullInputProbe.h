@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class NullInputProbe : public Component
+class NullInputProbe : public TestComponent
 {
 public:
     NullInputProbe()
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace DSPatch
+{
+
+// Expects each tick's input to be a count plus an offset that never decreases
+class OffsetProbe : public TestComponent
+{
+public:
+    OffsetProbe()
+    {
+        SetInputCount_( 1 );
+    }
+
+    int Offset() const
+    {
+        return _offset;
+    }
+
+protected:
+    virtual void Process_( SignalBus const& inputs, SignalBus& ) override
+    {
+        auto in = inputs.GetValue<int>( 0 );
+        REQUIRE( in != nullptr );
+
+        int offset = *in - _count++;
+        REQUIRE( offset >= _offset );
+        _offset = offset;
+    }
+
+private:
+    int _count = 0;
+    std::atomic<int> _offset{ 0 };
+};
+
+}  // namespace DSPatch
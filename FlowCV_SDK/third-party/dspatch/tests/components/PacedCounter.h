@@ -0,0 +1,38 @@
+#pragma once
+
+namespace DSPatch
+{
+
+// Counts up once per period, skipping ticks in between
+class PacedCounter : public TestComponent
+{
+public:
+    PacedCounter( std::chrono::steady_clock::duration period )
+        : _period( period )
+    {
+        SetOutputCount_( 1 );
+    }
+
+    int Count() const
+    {
+        return _count;
+    }
+
+protected:
+    virtual void Process_( SignalBus const&, SignalBus& outputs ) override
+    {
+        if ( !PaceTick_( _lastTick, _period ) )
+        {
+            return;
+        }
+
+        outputs.SetValue( 0, _count++ );
+    }
+
+private:
+    std::chrono::steady_clock::duration _period;
+    std::chrono::steady_clock::time_point _lastTick;
+    int _count = 0;
+};
+
+}  // namespace DSPatch
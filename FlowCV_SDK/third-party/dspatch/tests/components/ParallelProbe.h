@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class ParallelProbe : public Component
+class ParallelProbe : public TestComponent
 {
 public:
     ParallelProbe()
@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class PassThrough : public Component
+class PassThrough : public TestComponent
 {
 public:
     PassThrough()
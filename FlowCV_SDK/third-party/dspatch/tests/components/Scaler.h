@@ -0,0 +1,40 @@
+#pragma once
+
+namespace DSPatch
+{
+
+// Multiplies its input by a factor that can be changed between ticks, evaluated on change
+class Scaler : public TestComponent
+{
+public:
+    Scaler( int factor )
+        : _factor( factor )
+    {
+        SetInputCount_( 1 );
+        SetOutputCount_( 1 );
+        SetChangeProbe_( [this] { return _changed.exchange( false ); } );
+        SetEvaluationMode( EvaluationMode::OnChange );
+    }
+
+    void SetFactor( int factor )
+    {
+        _factor = factor;
+        _changed = true;
+    }
+
+protected:
+    virtual void Process_( SignalBus const& inputs, SignalBus& outputs ) override
+    {
+        auto in = inputs.GetValue<int>( 0 );
+        if ( in )
+        {
+            outputs.SetValue( 0, *in * _factor );
+        }
+    }
+
+private:
+    std::atomic<int> _factor;
+    std::atomic<bool> _changed{ false };
+};
+
+}  // namespace DSPatch
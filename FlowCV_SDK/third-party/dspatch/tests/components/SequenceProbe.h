@@ -0,0 +1,34 @@
+#pragma once
+
+namespace DSPatch
+{
+
+// Expects each tick's input to be the one after the last (I.e. no tick lost or processed twice)
+class SequenceProbe : public TestComponent
+{
+public:
+    SequenceProbe()
+    {
+        SetInputCount_( 1 );
+    }
+
+    int Count() const
+    {
+        return _count;
+    }
+
+protected:
+    virtual void Process_( SignalBus const& inputs, SignalBus& ) override
+    {
+        auto in = inputs.GetValue<int>( 0 );
+        REQUIRE( in != nullptr );
+        REQUIRE( *in == _count );
+
+        ++_count;
+    }
+
+private:
+    std::atomic<int> _count{ 0 };
+};
+
+}  // namespace DSPatch
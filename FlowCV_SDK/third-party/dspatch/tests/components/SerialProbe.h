@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class SerialProbe : public Component
+class SerialProbe : public TestComponent
 {
 public:
     SerialProbe()
@@ -5,7 +5,7 @@
 namespace DSPatch
 {
 
-class SlowCounter : public Component
+class SlowCounter : public TestComponent
 {
 public:
     SlowCounter()
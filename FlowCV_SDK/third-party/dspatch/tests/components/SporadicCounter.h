@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class SporadicCounter : public Component
+class SporadicCounter : public TestComponent
 {
 public:
     SporadicCounter( int increment = 1 )
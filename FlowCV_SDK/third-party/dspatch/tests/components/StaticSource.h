@@ -0,0 +1,30 @@
+#pragma once
+
+namespace DSPatch
+{
+
+// Outputs the same value every tick, re-emitting it once held (E.g. like a static image source)
+class StaticSource : public TestComponent
+{
+public:
+    StaticSource( int value )
+        : _value( value )
+    {
+        SetOutputCount_( 1 );
+        SetEvaluationMode( EvaluationMode::OnChange );
+    }
+
+protected:
+    virtual void Process_( SignalBus const&, SignalBus& outputs ) override
+    {
+        if ( !ReuseOutputs_( outputs ) )
+        {
+            outputs.SetValue( 0, _value );
+        }
+    }
+
+private:
+    int _value;
+};
+
+}  // namespace DSPatch
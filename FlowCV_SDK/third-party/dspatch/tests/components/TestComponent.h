@@ -0,0 +1,34 @@
+#pragma once
+
+namespace DSPatch
+{
+
+// FlowCV's Component also carries the node editor's GUI and state hooks, test components have neither
+class TestComponent : public Component
+{
+public:
+    TestComponent( ProcessOrder processOrder = ProcessOrder::InOrder )
+        : Component( processOrder )
+    {
+    }
+
+    virtual bool HasGui( int ) override
+    {
+        return false;
+    }
+
+    virtual void UpdateGui( void*, int ) override
+    {
+    }
+
+    virtual std::string GetState() override
+    {
+        return {};
+    }
+
+    virtual void SetState( std::string&& ) override
+    {
+    }
+};
+
+}  // namespace DSPatch
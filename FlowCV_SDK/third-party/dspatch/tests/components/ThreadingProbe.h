@@ -3,7 +3,7 @@
 namespace DSPatch
 {
 
-class ThreadingProbe : public Component
+class ThreadingProbe : public TestComponent
 {
 public:
     ThreadingProbe()
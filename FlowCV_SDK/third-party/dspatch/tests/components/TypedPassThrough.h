@@ -0,0 +1,22 @@
+#pragma once
+
+namespace DSPatch
+{
+
+class TypedPassThrough : public TestComponent
+{
+public:
+    TypedPassThrough( IoType type )
+    {
+        SetInputCount_( 1, { "in" }, { type } );
+        SetOutputCount_( 1, { "out" }, { type } );
+    }
+
+protected:
+    virtual void Process_( SignalBus const& inputs, SignalBus& outputs ) override
+    {
+        outputs.MoveSignal( 0, inputs.GetSignal( 0 ) );
+    }
+};
+
+}  // namespace DSPatch
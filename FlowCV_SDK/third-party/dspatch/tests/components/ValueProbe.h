@@ -0,0 +1,33 @@
+#pragma once
+
+namespace DSPatch
+{
+
+// Expects each tick's input to be the given value
+class ValueProbe : public TestComponent
+{
+public:
+    ValueProbe( int value )
+        : _value( value )
+    {
+        SetInputCount_( 1 );
+    }
+
+    void SetExpected( int value )
+    {
+        _value = value;
+    }
+
+protected:
+    virtual void Process_( SignalBus const& inputs, SignalBus& ) override
+    {
+        auto in = inputs.GetValue<int>( 0 );
+        REQUIRE( in != nullptr );
+        REQUIRE( *in == _value );
+    }
+
+private:
+    std::atomic<int> _value;
+};
+
+}  // namespace DSPatch
@@ -1,9 +1,13 @@
 #define CATCH_CONFIG_MAIN
+// Catch's signal handlers size their stack with SIGSTKSZ, which is no longer a constant on newer glibc
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
 
 #include <catch.hpp>
 
 #include <DSPatch.h>
 
+#include <components/TestComponent.h>
+
 #include <components/Adder.h>
 #include <components/BranchSyncProbe.h>
 #include <components/ChangingCounter.h>
@@ -13,16 +17,27 @@
 #include <components/Counter.h>
 #include <components/FeedbackProbe.h>
 #include <components/FeedbackTester.h>
+#include <components/FiniteCounter.h>
+#include <components/GateProbe.h>
 #include <components/Incrementer.h>
 #include <components/NoOutputProbe.h>
 #include <components/NullInputProbe.h>
+#include <components/OffsetProbe.h>
+#include <components/PacedCounter.h>
 #include <components/ParallelProbe.h>
 #include <components/PassThrough.h>
+#include <components/Scaler.h>
+#include <components/SequenceProbe.h>
 #include <components/SerialProbe.h>
 #include <components/SlowCounter.h>
 #include <components/SporadicCounter.h>
+#include <components/StaticSource.h>
 #include <components/ThreadingProbe.h>
+#include <components/TypedPassThrough.h>
+#include <components/ValueProbe.h>
 
+#include <atomic>
+#include <sstream>
 #include <thread>
 
 using namespace DSPatch;
@@ -1126,3 +1141,465 @@ TEST_CASE( "DisconnectComponentRegressionTest" )
 
     circuit->Tick( Component::TickMode::Series );
 }
+
+TEST_CASE( "LiveEditTest" )
+{
+    // Swap the component in between a counter and a probe while buffers are in flight, and check
+    // that the probe still sees every count exactly once, in order
+    auto circuit = std::make_shared<Circuit>();
+
+    auto counter = std::make_shared<Counter>();
+    auto probe = std::make_shared<SequenceProbe>();
+    auto pass = std::make_shared<PassThrough>();
+
+    circuit->AddComponent( counter );
+    circuit->AddComponent( pass );
+    circuit->AddComponent( probe );
+
+    circuit->ConnectOutToIn( counter, 0, pass, 0 );
+    circuit->ConnectOutToIn( pass, 0, probe, 0 );
+
+    circuit->SetBufferCount( 3 );
+    circuit->StartAutoTick( Component::TickMode::Parallel );
+
+    bool committed = true;  // REQUIRE'd once ticking stops, Catch isn't thread-safe
+    for ( int i = 0; i < 200; ++i )
+    {
+        auto newPass = std::make_shared<PassThrough>();
+
+        if ( i % 2 == 0 )
+        {
+            // one edit at a time, the probe stays connected throughout
+            circuit->AddComponent( newPass );
+            circuit->ConnectOutToIn( counter, 0, newPass, 0 );
+            circuit->ConnectOutToIn( newPass, 0, probe, 0 );
+            circuit->RemoveComponent( pass );
+        }
+        else
+        {
+            // all edits at once
+            CircuitTransaction transaction;
+            transaction.RemoveComponent( pass );
+            transaction.AddComponent( newPass );
+            transaction.ConnectOutToIn( counter, 0, newPass, 0 );
+            transaction.ConnectOutToIn( newPass, 0, probe, 0 );
+            committed = circuit->Commit( transaction ) && committed;
+        }
+
+        pass = newPass;
+        std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+    }
+
+    circuit->StopAutoTick();
+
+    REQUIRE( committed );
+    REQUIRE( probe->Count() > 0 );
+    REQUIRE( probe->Count() == counter->GetTotalProcessCount() );
+    REQUIRE( probe->GetTotalProcessCount() == counter->GetTotalProcessCount() );
+}
+
+TEST_CASE( "QueuePolicyTest" )
+{
+    // Hold the first of 4 buffers in the gate while the other 3 queue up behind it, then check
+    // which of the queued counts each queue policy lets through (in series, as each buffer then has
+    // a thread of its own, whereas a held gate could occupy the whole thread pool of a small machine)
+    auto processed = []( Component::QueuePolicy queuePolicy, int queueSize ) {
+        auto circuit = std::make_shared<Circuit>();
+
+        auto counter = std::make_shared<Counter>();
+        auto gate = std::make_shared<GateProbe>();
+        gate->SetQueuePolicy( queuePolicy, queueSize );
+
+        circuit->AddComponent( counter );
+        circuit->AddComponent( gate );
+
+        circuit->ConnectOutToIn( counter, 0, gate, 0 );
+
+        circuit->SetBufferCount( 4 );
+
+        for ( int i = 0; i < 4; ++i )
+        {
+            circuit->Tick( Component::TickMode::Series );
+        }
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+        gate->Open();
+
+        circuit->SetBufferCount( 1 );  // drains all buffers
+
+        return gate->Processed();
+    };
+
+    REQUIRE( processed( Component::QueuePolicy::Block, 1 ) == std::vector<int>( { 0, 1, 2, 3 } ) );
+    REQUIRE( processed( Component::QueuePolicy::LatestOnly, 1 ) == std::vector<int>( { 0, 3 } ) );
+    REQUIRE( processed( Component::QueuePolicy::DropOldest, 1 ) == std::vector<int>( { 0, 2, 3 } ) );
+    REQUIRE( processed( Component::QueuePolicy::DropOldest, 2 ) == std::vector<int>( { 0, 1, 2, 3 } ) );
+}
+
+TEST_CASE( "PaceTickTest" )
+{
+    // Without an auto-tick thread to request ticks from, a paced source must skip the ticks that
+    // come before its period is up, rather than hold up the thread ticking it
+    auto circuit = std::make_shared<Circuit>();
+
+    auto counter = std::make_shared<PacedCounter>( std::chrono::milliseconds( 200 ) );
+
+    circuit->AddComponent( counter );
+
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < 10; ++i )
+    {
+        circuit->Tick( Component::TickMode::Series );
+    }
+
+    REQUIRE( std::chrono::steady_clock::now() - start < std::chrono::milliseconds( 200 ) );
+    REQUIRE( counter->GetTotalProcessCount() == 10 );
+    REQUIRE( counter->Count() == 1 );
+}
+
+TEST_CASE( "TraceTruncationTest" )
+{
+    // A trace that reaches its event limit must say so, rather than silently end early
+    auto circuit = std::make_shared<Circuit>();
+
+    auto counter = std::make_shared<Counter>();
+    auto probe = std::make_shared<SequenceProbe>();
+
+    circuit->AddComponent( counter );
+    circuit->AddComponent( probe );
+
+    circuit->ConnectOutToIn( counter, 0, probe, 0 );
+
+    circuit->StartTrace( 1000 );
+
+    for ( int i = 0; i < 10; ++i )
+    {
+        circuit->Tick();
+    }
+
+    std::stringstream trace;
+    circuit->WriteTrace( trace );
+
+    REQUIRE( !circuit->IsTraceTruncated() );
+    REQUIRE( trace.str().find( "trace truncated" ) == std::string::npos );
+
+    circuit->StartTrace( 10 );
+
+    for ( int i = 0; i < 10; ++i )
+    {
+        circuit->Tick();
+    }
+
+    trace.str( "" );
+    circuit->WriteTrace( trace );
+
+    REQUIRE( circuit->IsTraceTruncated() );
+    REQUIRE( trace.str().find( "trace truncated" ) != std::string::npos );
+}
+
+TEST_CASE( "OnChangeTakeMutableTest" )
+{
+    // An OnChange component that modifies its input in place must still recognise that input when
+    // it comes round again unchanged, and must not modify the value held by the component before it
+    auto circuit = std::make_shared<Circuit>();
+
+    auto source = std::make_shared<StaticSource>( 42 );
+    auto incrementer = std::make_shared<Incrementer>();
+    auto probe = std::make_shared<ValueProbe>( 43 );
+
+    incrementer->SetEvaluationMode( Component::EvaluationMode::OnChange );
+
+    circuit->AddComponent( source );
+    circuit->AddComponent( incrementer );
+    circuit->AddComponent( probe );
+
+    circuit->ConnectOutToIn( source, 0, incrementer, 0 );
+    circuit->ConnectOutToIn( incrementer, 0, probe, 0 );
+
+    for ( int i = 0; i < 10; ++i )
+    {
+        circuit->Tick( Component::TickMode::Series );
+    }
+
+    REQUIRE( probe->GetTotalProcessCount() == 10 );
+    REQUIRE( incrementer->GetTotalProcessCount() == 1 );
+
+    // enabling forces the next tick to be processed, from the very same input
+    incrementer->SetEnabled( true );
+    circuit->Tick( Component::TickMode::Series );
+
+    REQUIRE( incrementer->GetTotalProcessCount() == 2 );
+}
+
+TEST_CASE( "BatchEndOfStreamTest" )
+{
+    // In batch, a circuit must stop ticking once its finite source ends its stream, with the source
+    // having output each of its values exactly once
+    auto circuit = std::make_shared<Circuit>();
+    auto counter = std::make_shared<Counter>();
+    circuit->AddComponent( counter );
+
+    REQUIRE( !circuit->CanEndStream() );
+
+    auto source = std::make_shared<FiniteCounter>( 500 );
+    auto passThrough = std::make_shared<PassThrough>();
+    circuit->AddComponent( source );
+    circuit->AddComponent( passThrough );
+    circuit->ConnectOutToIn( source, 0, passThrough, 0 );
+
+    REQUIRE( circuit->CanEndStream() );
+
+    SECTION( "End Of Stream" )
+    {
+        circuit->SetBufferCount( 4 );
+        circuit->SetAutoTickMode( Circuit::AutoTickMode::Batch );
+        circuit->StartAutoTick( Component::TickMode::Series );
+        for ( int i = 0; i < 1000 && !circuit->IsEndOfStream(); ++i )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        }
+        circuit->StopAutoTick();
+
+        REQUIRE( circuit->IsEndOfStream() );
+        REQUIRE( source->GetStreamError().empty() );
+        REQUIRE( source->GetTotalOutputCount() == 500 );
+        REQUIRE( passThrough->GetTotalOutputCount() == 500 );
+        REQUIRE( source->GetTotalProcessCount() > 500 );
+    }
+
+    SECTION( "Stream Error" )
+    {
+        auto failing = std::make_shared<FiniteCounter>( 500, "no such file" );
+        circuit->AddComponent( failing );
+        circuit->Tick( Component::TickMode::Series );
+
+        REQUIRE( circuit->IsEndOfStream() );
+        REQUIRE( failing->GetStreamError() == "no such file" );
+        REQUIRE( failing->GetTotalOutputCount() == 0 );
+    }
+}
+
+TEST_CASE( "SharedThreadPoolTest" )
+{
+    // Circuits constructed with the same thread pool must each tick all of their components on it
+    auto threadPool = Circuit::NewThreadPool( 2 );
+
+    std::vector<std::shared_ptr<Circuit>> circuits;
+    std::vector<std::shared_ptr<SequenceProbe>> probes;
+    for ( int i = 0; i < 3; ++i )
+    {
+        auto circuit = std::make_shared<Circuit>( threadPool );
+        auto counter = std::make_shared<Counter>();
+        auto probe = std::make_shared<SequenceProbe>();
+
+        circuit->AddComponent( counter );
+        circuit->AddComponent( probe );
+        circuit->ConnectOutToIn( counter, 0, probe, 0 );
+
+        circuits.push_back( circuit );
+        probes.push_back( probe );
+    }
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        for ( auto& circuit : circuits )
+        {
+            circuit->Tick( Component::TickMode::Parallel );
+        }
+    }
+
+    for ( auto& probe : probes )
+    {
+        REQUIRE( probe->Count() == 100 );
+    }
+}
+
+TEST_CASE( "OnChangeProbeTest" )
+{
+    // An OnChange component must be processed again when its change probe reports a change to its
+    // settings, even though its input has not changed
+    auto circuit = std::make_shared<Circuit>();
+
+    auto source = std::make_shared<StaticSource>( 7 );
+    auto scaler = std::make_shared<Scaler>( 2 );
+    auto probe = std::make_shared<ValueProbe>( 14 );
+
+    circuit->AddComponent( source );
+    circuit->AddComponent( scaler );
+    circuit->AddComponent( probe );
+
+    circuit->ConnectOutToIn( source, 0, scaler, 0 );
+    circuit->ConnectOutToIn( scaler, 0, probe, 0 );
+
+    for ( int i = 0; i < 5; ++i )
+    {
+        circuit->Tick( Component::TickMode::Series );
+    }
+
+    REQUIRE( scaler->GetTotalProcessCount() == 1 );
+
+    scaler->SetFactor( 3 );
+    probe->SetExpected( 21 );
+
+    for ( int i = 0; i < 5; ++i )
+    {
+        circuit->Tick( Component::TickMode::Series );
+    }
+
+    REQUIRE( scaler->GetTotalProcessCount() == 2 );
+    REQUIRE( probe->GetTotalProcessCount() == 10 );
+}
+
+TEST_CASE( "TransactionValidationTest" )
+{
+    // An invalid edit anywhere in a transaction must fail the whole transaction, and leave the
+    // circuit as it was
+    auto circuit = std::make_shared<Circuit>();
+
+    auto counter = std::make_shared<Counter>();
+    auto probe = std::make_shared<SequenceProbe>();
+    auto outsider = std::make_shared<PassThrough>();
+    auto intPass = std::make_shared<TypedPassThrough>( IoType::Io_Type_Int );
+    auto stringPass = std::make_shared<TypedPassThrough>( IoType::Io_Type_String );
+
+    circuit->AddComponent( counter );
+    circuit->AddComponent( probe );
+
+    std::string error;
+
+    {
+        CircuitTransaction transaction;
+        transaction.ConnectOutToIn( counter, 0, outsider, 0 );
+        REQUIRE( !circuit->Validate( transaction, &error ) );
+        REQUIRE( error.find( "not in the circuit" ) != std::string::npos );
+    }
+    {
+        CircuitTransaction transaction;
+        transaction.ConnectOutToIn( counter, 1, probe, 0 );
+        REQUIRE( !circuit->Validate( transaction, &error ) );
+        REQUIRE( error.find( "has no output 1" ) != std::string::npos );
+    }
+    {
+        CircuitTransaction transaction;
+        transaction.ConnectOutToIn( counter, 0, probe, 1 );
+        REQUIRE( !circuit->Validate( transaction, &error ) );
+        REQUIRE( error.find( "has no input 1" ) != std::string::npos );
+    }
+    {
+        CircuitTransaction transaction;
+        transaction.AddComponent( intPass );
+        transaction.AddComponent( stringPass );
+        transaction.ConnectOutToIn( counter, 0, intPass, 0 );  // an unspecified type matches any type
+        REQUIRE( circuit->Validate( transaction ) );
+
+        transaction.ConnectOutToIn( intPass, 0, stringPass, 0 );
+        REQUIRE( !circuit->Validate( transaction, &error ) );
+        REQUIRE( error.find( "does not match the type" ) != std::string::npos );
+
+        REQUIRE( !circuit->Commit( transaction ) );
+        REQUIRE( circuit->GetComponentCount() == 2 );
+
+        // single wires are checked just the same, without a circuit
+        REQUIRE( Circuit::CanConnectOutToIn( counter, 0, intPass, 0 ) );
+        REQUIRE( !Circuit::CanConnectOutToIn( intPass, 0, stringPass, 0 ) );
+    }
+    {
+        // a component removed earlier in the transaction can no longer be wired
+        CircuitTransaction transaction;
+        transaction.RemoveComponent( counter );
+        transaction.ConnectOutToIn( counter, 0, probe, 0 );
+        REQUIRE( !circuit->Commit( transaction, &error ) );
+        REQUIRE( error.find( "not in the circuit" ) != std::string::npos );
+        REQUIRE( circuit->GetComponentCount() == 2 );
+    }
+    {
+        CircuitTransaction transaction;
+        transaction.ConnectOutToIn( counter, 0, probe, 0 );
+        REQUIRE( circuit->Commit( transaction ) );
+    }
+
+    for ( int i = 0; i < 10; ++i )
+    {
+        circuit->Tick();
+    }
+
+    REQUIRE( probe->Count() == 10 );
+}
+
+TEST_CASE( "TransactionFeedbackTest" )
+{
+    // Feedback wires are allowed by default, but a transaction that disallows them must reject any
+    // wire that closes a loop, including one through components it adds itself
+    auto circuit = std::make_shared<Circuit>();
+
+    auto counter = std::make_shared<Counter>();
+    auto adder = std::make_shared<Adder>();
+    auto pass = std::make_shared<PassThrough>();
+
+    circuit->AddComponent( counter );
+
+    CircuitTransaction transaction;
+    transaction.AddComponent( adder );
+    transaction.AddComponent( pass );
+    transaction.ConnectOutToIn( counter, 0, adder, 0 );
+    transaction.ConnectOutToIn( adder, 0, pass, 0 );
+    transaction.ConnectOutToIn( pass, 0, adder, 1 );
+
+    REQUIRE( circuit->Validate( transaction ) );
+
+    transaction.SetAllowFeedback( false );
+
+    std::string error;
+    REQUIRE( !circuit->Validate( transaction, &error ) );
+    REQUIRE( error.find( "closes a loop" ) != std::string::npos );
+    REQUIRE( !circuit->Commit( transaction ) );
+    REQUIRE( circuit->GetComponentCount() == 1 );
+
+    // breaking the loop makes the transaction valid
+    transaction.DisconnectInput( adder, 1 );
+    REQUIRE( circuit->Commit( transaction, &error ) );
+    REQUIRE( circuit->GetComponentCount() == 3 );
+}
+
+TEST_CASE( "TransactionHotSwapTest" )
+{
+    // Swap a +1 incrementer for a +2 incrementer in one transaction while the circuit is running:
+    // no tick may see the probe unwired, or the old incrementer after the new one
+    auto circuit = std::make_shared<Circuit>();
+
+    auto counter = std::make_shared<Counter>();
+    auto oldIncrementer = std::make_shared<Incrementer>( 1 );
+    auto newIncrementer = std::make_shared<Incrementer>( 2 );
+    auto probe = std::make_shared<OffsetProbe>();
+
+    circuit->AddComponent( counter );
+    circuit->AddComponent( oldIncrementer );
+    circuit->AddComponent( probe );
+
+    circuit->ConnectOutToIn( counter, 0, oldIncrementer, 0 );
+    circuit->ConnectOutToIn( oldIncrementer, 0, probe, 0 );
+
+    circuit->SetBufferCount( 3 );
+    circuit->StartAutoTick( Component::TickMode::Parallel );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+
+    CircuitTransaction transaction;
+    transaction.RemoveComponent( oldIncrementer );
+    transaction.AddComponent( newIncrementer );
+    transaction.ConnectOutToIn( counter, 0, newIncrementer, 0 );
+    transaction.ConnectOutToIn( newIncrementer, 0, probe, 0 );
+    bool committed = circuit->Commit( transaction );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+
+    circuit->StopAutoTick();
+
+    REQUIRE( committed );
+    REQUIRE( circuit->GetComponentCount() == 3 );
+    REQUIRE( oldIncrementer->GetTotalProcessCount() > 0 );
+    REQUIRE( newIncrementer->GetTotalProcessCount() > 0 );
+    REQUIRE( probe->Offset() == 2 );
+    REQUIRE( probe->GetTotalProcessCount() == counter->GetTotalProcessCount() );
+}
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-AbsDiff::AbsDiff() : Component(ProcessOrder::OutOfOrder)
+AbsDiff::AbsDiff() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Abs_Diff");
@@ -28,6 +28,7 @@ AbsDiff::AbsDiff() : Component(ProcessOrder::OutOfOrder)
     // 1 outputs
     SetOutputCount_(1, {"out"}, {IoType::Io_Type_CvMat});
 
+    SetTileable_(true);
     SetEnabled(true);
 }
 
@@ -43,8 +44,13 @@ void AbsDiff::Process_(SignalBus const &inputs, SignalBus &outputs)
         if (IsEnabled()) {
             // Process Image
             if (in1->type() == in2->type() && in1->channels() == in2->channels() && in1->size == in2->size) {
-                cv::Mat frame;
-                cv::absdiff(*in1, *in2, frame);
+                cv::Mat frame(in1->size(), in1->type());
+                std::vector<cv::Mat> frames = {*in1, *in2};
+                ProcessTiles_(in1->rows, [&](int firstRow, int lastRow) {
+                    cv::Mat tile = frame.rowRange(firstRow, lastRow);
+                    ProcessElements(SliceRows(frames, firstRow, lastRow), tile);
+                });
+
                 if (!frame.empty())
                     outputs.SetValue(0, frame);
             }
@@ -55,6 +61,18 @@ void AbsDiff::Process_(SignalBus const &inputs, SignalBus &outputs)
     }
 }
 
+bool AbsDiff::ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output)
+{
+    const cv::Mat &in1 = inputs[0];
+    const cv::Mat &in2 = inputs[1];
+    if (in1.empty() || in2.empty() || in1.type() != in2.type() || in1.size != in2.size)
+        return false;
+
+    cv::absdiff(in1, in2, output);
+
+    return true;
+}
+
 bool AbsDiff::HasGui(int interface)
 {
 
@@ -67,22 +85,19 @@ void AbsDiff::UpdateGui(void *context, int interface)
     ImGui::SetCurrentContext(imCurContext);
 }
 
-std::string AbsDiff::GetState()
+nlohmann::json AbsDiff::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void AbsDiff::SetState(std::string &&json_serialized)
+void AbsDiff::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
@@ -6,21 +6,24 @@
 #define FLOWCV_PLUGIN_ABS_DIFF_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
+#include "FusedChain/element_wise.hpp"
 
 namespace DSPatch::DSPatchables
 {
 
-class AbsDiff final : public Component
+class AbsDiff final : public FlowCV::JsonState, public ElementWise
 {
   public:
     AbsDiff();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
+    bool ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Add::Add() : Component(ProcessOrder::OutOfOrder)
+Add::Add() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Add");
@@ -30,6 +30,7 @@ Add::Add() : Component(ProcessOrder::OutOfOrder)
 
     mask_mode_ = 0;
 
+    SetTileable_(true);
     SetEnabled(true);
 }
 
@@ -42,33 +43,16 @@ void Add::Process_(SignalBus const &inputs, SignalBus &outputs)
         return;
     }
 
-    bool has_mask = false;
-    if (mask)
-        if (!mask->empty())
-            if (mask->channels() == 1)
-                has_mask = true;
-
     if (!in1->empty() && !in2->empty()) {
         if (IsEnabled()) {
             // Process Image
             if (in1->type() == in2->type() && in1->channels() == in2->channels() && in1->size == in2->size) {
-                cv::Mat frame;
-                if (has_mask) {
-                    if (mask_mode_ == 0) {  // Default - Fill with black
-                        if (!frame.empty())
-                            frame.setTo(cv::Scalar(0, 0, 0));
-                    }
-                    else if (mask_mode_ == 1)
-                        in1->copyTo(frame);
-                    else if (mask_mode_ == 2)
-                        in2->copyTo(frame);
-                }
-
-                if (has_mask) {
-                    cv::add(*in1, *in2, frame, *mask);
-                }
-                else
-                    cv::add(*in1, *in2, frame);
+                cv::Mat frame(in1->size(), in1->type());
+                std::vector<cv::Mat> frames = {*in1, *in2, MaskFor(mask, *in1)};
+                ProcessTiles_(in1->rows, [&](int firstRow, int lastRow) {
+                    cv::Mat tile = frame.rowRange(firstRow, lastRow);
+                    ProcessElements(SliceRows(frames, firstRow, lastRow), tile);
+                });
 
                 if (!frame.empty())
                     outputs.SetValue(0, frame);
@@ -80,6 +64,32 @@ void Add::Process_(SignalBus const &inputs, SignalBus &outputs)
     }
 }
 
+bool Add::ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output)
+{
+    const cv::Mat &in1 = inputs[0];
+    const cv::Mat &in2 = inputs[1];
+    const cv::Mat &mask = inputs[2];
+    if (in1.empty() || in2.empty() || in1.type() != in2.type() || in1.size != in2.size)
+        return false;
+
+    bool has_mask = !mask.empty() && mask.channels() == 1 && mask.size == in1.size;
+
+    output.create(in1.size(), in1.type());
+    if (has_mask) {
+        if (mask_mode_ == 0)  // Default - Fill with black
+            output.setTo(cv::Scalar(0, 0, 0));
+        else if (mask_mode_ == 1)
+            in1.copyTo(output);
+        else if (mask_mode_ == 2)
+            in2.copyTo(output);
+        cv::add(in1, in2, output, mask);
+    }
+    else
+        cv::add(in1, in2, output);
+
+    return true;
+}
+
 bool Add::HasGui(int interface)
 {
     // This is where you tell the system if your node has any of the following interfaces: Main, Control or Other
@@ -102,7 +112,7 @@ void Add::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Add::GetState()
+nlohmann::json Add::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -110,17 +120,13 @@ std::string Add::GetState()
 
     state["mask_mode"] = mask_mode_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Add::SetState(std::string &&json_serialized)
+void Add::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("mask_mode"))
         mask_mode_ = state["mask_mode"].get<int>();
 }
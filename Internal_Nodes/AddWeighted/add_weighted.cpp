@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-AddWeighted::AddWeighted() : Component(ProcessOrder::OutOfOrder)
+AddWeighted::AddWeighted() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Add_Weighted");
@@ -87,7 +87,7 @@ void AddWeighted::UpdateGui(void *context, int interface)
     }
 }
 
-std::string AddWeighted::GetState()
+nlohmann::json AddWeighted::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -97,17 +97,13 @@ std::string AddWeighted::GetState()
     state["beta"] = beta_;
     state["gamma"] = gamma_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void AddWeighted::SetState(std::string &&json_serialized)
+void AddWeighted::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("alpha"))
         alpha_ = state["alpha"].get<float>();
     if (state.contains("beta"))
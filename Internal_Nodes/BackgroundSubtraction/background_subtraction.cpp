@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-BackgroundSubtraction::BackgroundSubtraction() : Component(ProcessOrder::OutOfOrder)
+BackgroundSubtraction::BackgroundSubtraction() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Background_Subtraction");
@@ -50,8 +50,8 @@ void BackgroundSubtraction::Process_(SignalBus const &inputs, SignalBus &outputs
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat frame, mask, masked_frame;
-            in1->copyTo(frame);
+            const cv::Mat &frame = *in1;
+            cv::Mat mask, masked_frame;
             // Process Image
             if (update_settings_) {
                 // MOG2
@@ -118,7 +118,7 @@ void BackgroundSubtraction::UpdateGui(void *context, int interface)
     }
 }
 
-std::string BackgroundSubtraction::GetState()
+nlohmann::json BackgroundSubtraction::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -129,17 +129,13 @@ std::string BackgroundSubtraction::GetState()
     state["threshold"] = threshold_;
     state["detect_shadows"] = detect_shadows_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void BackgroundSubtraction::SetState(std::string &&json_serialized)
+void BackgroundSubtraction::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("mode"))
         bkg_sub_mode_ = state["mode"].get<int>();
     if (state.contains("history"))
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Bitwise::Bitwise() : Component(ProcessOrder::OutOfOrder)
+Bitwise::Bitwise() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Bitwise");
@@ -30,6 +30,7 @@ Bitwise::Bitwise() : Component(ProcessOrder::OutOfOrder)
 
     bitwise_mode_ = 0;
 
+    SetTileable_(true);
     SetEnabled(true);
 }
 
@@ -47,43 +48,18 @@ void Bitwise::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat frame_out, mask;
-
-            // Check Mask
-            if (!inMask) {
-                mask = cv::Mat(in1->rows, in1->cols, CV_8UC1, 255);
-            }
-            else {
-                inMask->copyTo(mask);
-            }
-
-            if (!in2) {
-                if (bitwise_mode_ == 0)
-                    cv::bitwise_and(*in1, *in1, frame_out, mask);
-                else if (bitwise_mode_ == 1)
-                    cv::bitwise_not(*in1, frame_out, mask);
-                else if (bitwise_mode_ == 2)
-                    cv::bitwise_or(*in1, *in1, frame_out, mask);
-                else if (bitwise_mode_ == 3)
-                    cv::bitwise_xor(*in1, *in1, frame_out, mask);
+            cv::Mat frame_out(in1->size(), in1->type());
+            std::vector<cv::Mat> frames = {*in1, in2 ? *in2 : cv::Mat(), MaskFor(inMask, *in1)};
+
+            // A differently sized in2 is resized to in1 as a whole
+            if (SameSize(frames)) {
+                ProcessTiles_(in1->rows, [&](int firstRow, int lastRow) {
+                    cv::Mat tile = frame_out.rowRange(firstRow, lastRow);
+                    ProcessElements(SliceRows(frames, firstRow, lastRow), tile);
+                });
             }
             else {
-                cv::Mat frame2;
-                if (in1->size() != in2->size()) {
-                    cv::resize(*in2, frame2, in1->size());
-                }
-                else {
-                    in2->copyTo(frame2);
-                }
-
-                if (bitwise_mode_ == 0)
-                    cv::bitwise_and(*in1, frame2, frame_out, mask);
-                else if (bitwise_mode_ == 1)
-                    cv::bitwise_not(*in1, frame_out, mask);
-                else if (bitwise_mode_ == 2)
-                    cv::bitwise_or(*in1, frame2, frame_out, mask);
-                else if (bitwise_mode_ == 3)
-                    cv::bitwise_xor(*in1, frame2, frame_out, mask);
+                ProcessElements(frames, frame_out);
             }
 
             outputs.SetValue(0, frame_out);
@@ -94,6 +70,38 @@ void Bitwise::Process_(SignalBus const &inputs, SignalBus &outputs)
     }
 }
 
+bool Bitwise::ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output)
+{
+    const cv::Mat &in1 = inputs[0];
+    if (in1.empty())
+        return false;
+    cv::Mat mask = MaskFor(&inputs[2], in1);
+
+    cv::Mat frame2 = in1;
+    if (!inputs[1].empty()) {
+        if (inputs[1].size() != in1.size())
+            cv::resize(inputs[1], frame2, in1.size());
+        else
+            frame2 = inputs[1];
+    }
+
+    // Masked out pixels are black
+    output.create(in1.size(), in1.type());
+    if (!mask.empty())
+        output.setTo(cv::Scalar::all(0));
+
+    if (bitwise_mode_ == 0)
+        cv::bitwise_and(in1, frame2, output, mask);
+    else if (bitwise_mode_ == 1)
+        cv::bitwise_not(in1, output, mask);
+    else if (bitwise_mode_ == 2)
+        cv::bitwise_or(in1, frame2, output, mask);
+    else if (bitwise_mode_ == 3)
+        cv::bitwise_xor(in1, frame2, output, mask);
+
+    return true;
+}
+
 bool Bitwise::HasGui(int interface)
 {
     // When Creating Strings for Controls use: CreateControlString("Text Here", GetInstanceCount()).c_str()
@@ -115,7 +123,7 @@ void Bitwise::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Bitwise::GetState()
+nlohmann::json Bitwise::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -123,17 +131,13 @@ std::string Bitwise::GetState()
 
     state["mode"] = bitwise_mode_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Bitwise::SetState(std::string &&json_serialized)
+void Bitwise::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("mode"))
         bitwise_mode_ = state["mode"].get<int>();
 }
@@ -3,6 +3,7 @@
 //
 
 #include "blob_detector.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -12,7 +13,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-BlobDetector::BlobDetector() : Component(ProcessOrder::OutOfOrder)
+BlobDetector::BlobDetector() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Blob_Detector");
@@ -63,8 +64,7 @@ void BlobDetector::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat frame;
-            in1->copyTo(frame);
+            cv::Mat frame = std::move(*inputs.TakeMutable<cv::Mat>(0));
             // Process Image
             cv::Ptr<cv::SimpleBlobDetector> detector = cv::SimpleBlobDetector::create(blob_params_);
             std::vector<cv::KeyPoint> keypoints;
@@ -192,7 +192,7 @@ void BlobDetector::UpdateGui(void *context, int interface)
     }
 }
 
-std::string BlobDetector::GetState()
+nlohmann::json BlobDetector::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -223,17 +223,13 @@ std::string BlobDetector::GetState()
     state["min_threshold"] = blob_params_.minThreshold;
     state["threshold_step"] = blob_params_.thresholdStep;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void BlobDetector::SetState(std::string &&json_serialized)
+void BlobDetector::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("blob_viz_color")) {
         blob_viz_color_.x = state["blob_viz_color"]["R"].get<float>();
         blob_viz_color_.y = state["blob_viz_color"]["G"].get<float>();
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Blur::Blur() : Component(ProcessOrder::OutOfOrder)
+Blur::Blur() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Blur");
@@ -33,14 +33,14 @@ Blur::Blur() : Component(ProcessOrder::OutOfOrder)
     props_.AddFloat("blur_amt_h", "Blur Amount H", 1.0f, 1.0f, 100.0f, 0.1f);
     props_.AddFloat("blur_amt_v", "Blur Amount V", 1.0f, 1.0f, 100.0f, 0.1f);
 
+    UpdateTiling_();
+    SetChangeProbe_([this] { return props_.HasChanges(); });
+    SetEvaluationMode(EvaluationMode::OnChange);
     SetEnabled(true);
 }
 
 void Blur::Process_(SignalBus const &inputs, SignalBus &outputs)
 {
-    // Blur is multithreaded, it's better to wait and not process more than one call at a time
-    std::lock_guard<std::mutex> lck(mutex_lock_);
-
     auto in1 = inputs.GetValue<cv::Mat>(0);
     if (!in1) {
         return;
@@ -48,19 +48,24 @@ void Blur::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            props_.Sync();
+            auto props = props_.Snapshot();
 
             cv::Mat frame;
-            auto bh = props_.Get<float>("blur_amt_h");
-            auto bv = props_.Get<float>("blur_amt_v");
-            auto bm = props_.Get<int>("blur_mode");
-            if (props_.Get<bool>("lock_h_v"))
+            auto bh = props->Get<float>("blur_amt_h");
+            auto bv = props->Get<float>("blur_amt_v");
+            auto bm = props->Get<int>("blur_mode");
+            if (props->Get<bool>("lock_h_v"))
                 bv = bh;
-            if (bm == 0) {
-                cv::blur(*in1, frame, cv::Size((int)bh, (int)bv), cv::Point(-1, -1));
-            }
-            else if (bm == 1) {
-                cv::GaussianBlur(*in1, frame, cv::Size(0, 0), bh, bv);
+            if (bm == 0 || bm == 1) {
+                // Filtering a stripe of rows reads the rows around it from the input itself, so stripes need no extra border
+                frame.create(in1->size(), in1->type());
+                ProcessTiles_(in1->rows, [&](int firstRow, int lastRow) {
+                    cv::Mat tile = frame.rowRange(firstRow, lastRow);
+                    if (bm == 0)
+                        cv::blur(in1->rowRange(firstRow, lastRow), tile, cv::Size((int)bh, (int)bv), cv::Point(-1, -1));
+                    else
+                        cv::GaussianBlur(in1->rowRange(firstRow, lastRow), tile, cv::Size(0, 0), bh, bv);
+                });
             }
             else if (bm == 2) {
                 int kSize = (int)bh;
@@ -88,6 +93,16 @@ bool Blur::HasGui(int interface)
     return false;
 }
 
+void Blur::UpdateTiling_()
+{
+    // Called whenever the properties are edited, never from Process_(), which may be running on more than one buffer.
+    // The halo is only a hint for how tall stripes should be, so it's fine for it to lead the snapshot being processed.
+    auto bh = props_.GetW<float>("blur_amt_h");
+    auto bv = props_.GetW<bool>("lock_h_v") ? bh : props_.GetW<float>("blur_amt_v");
+    auto bm = props_.GetW<int>("blur_mode");
+    SetTileable_(bm == 0 || bm == 1, bm == 0 ? (int)bv / 2 + 1 : (int)std::ceil(bv * 4.0f));
+}
+
 void Blur::UpdateGui(void *context, int interface)
 {
     auto *imCurContext = (ImGuiContext *)context;
@@ -126,10 +141,11 @@ void Blur::UpdateGui(void *context, int interface)
             else
                 props_.SetVisibility("blur_amt_v", true);
         }
+        UpdateTiling_();
     }
 }
 
-std::string Blur::GetState()
+nlohmann::json Blur::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -137,18 +153,15 @@ std::string Blur::GetState()
 
     props_.ToJson(state);
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Blur::SetState(std::string &&json_serialized)
+void Blur::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     props_.FromJson(state);
+    UpdateTiling_();
 }
 
 }  // End Namespace DSPatch::DSPatchables
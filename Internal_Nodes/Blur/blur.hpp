@@ -6,6 +6,7 @@
 #define FLOWCV_BLUR_HPP_
 #include <DSPatch.h>
 #include <FlowCV_Types.hpp>
+#include <FlowCV_JsonState.hpp>
 #include <FlowCV_Properties.hpp>
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
@@ -14,20 +15,21 @@
 namespace DSPatch::DSPatchables
 {
 
-class Blur final : public Component
+class Blur final : public FlowCV::JsonState
 {
   public:
     Blur();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
 
   private:
-    std::mutex mutex_lock_;
+    void UpdateTiling_();
+
     FlowCV::FlowCV_Properties props_;
 };
 
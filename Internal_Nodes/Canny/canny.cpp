@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-CannyFilter::CannyFilter() : Component(ProcessOrder::OutOfOrder)
+CannyFilter::CannyFilter() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Canny");
@@ -34,6 +34,8 @@ CannyFilter::CannyFilter() : Component(ProcessOrder::OutOfOrder)
     props_.AddFloat("low_thresh", "Low Threshold", 50.0f, 1.0f, 5000.0f, 0.1f);
     props_.AddFloat("high_thresh", "High Threshold", 150.0f, 1.0f, 5000.0f, 0.1f);
 
+    SetChangeProbe_([this] { return props_.HasChanges(); });
+    SetEvaluationMode(EvaluationMode::OnChange);
     SetEnabled(true);
 }
 
@@ -47,7 +49,7 @@ void CannyFilter::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            props_.Sync();
+            auto props = props_.Snapshot();
 
             // Process Image
             cv::Mat tmp, frame;
@@ -56,15 +58,15 @@ void CannyFilter::Process_(SignalBus const &inputs, SignalBus &outputs)
             else
                 tmp = *in1;
 
-            auto low_thresh = props_.Get<float>("low_thresh");
-            auto high_thresh = props_.Get<float>("high_thresh");
-            if (props_.Get<int>("thresh_mode") == 1) {
+            auto low_thresh = props->Get<float>("low_thresh");
+            auto high_thresh = props->Get<float>("high_thresh");
+            if (props->Get<int>("thresh_mode") == 1) {
                 cv::Scalar mean, dev;
                 cv::meanStdDev(tmp, mean, dev);
                 low_thresh = (float)(mean[0] - dev[0]);
                 high_thresh = (float)(mean[0] + dev[0]);
             }
-            cv::Canny(tmp, frame, low_thresh, high_thresh, props_.Get<int>("kernel_size"), (bool)props_.Get<int>("norm_type"));
+            cv::Canny(tmp, frame, low_thresh, high_thresh, props->Get<int>("kernel_size"), (bool)props->Get<int>("norm_type"));
             if (!frame.empty())
                 outputs.SetValue(0, frame);
         }
@@ -116,7 +118,7 @@ void CannyFilter::UpdateGui(void *context, int interface)
     }
 }
 
-std::string CannyFilter::GetState()
+nlohmann::json CannyFilter::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -124,17 +126,13 @@ std::string CannyFilter::GetState()
 
     props_.ToJson(state);
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void CannyFilter::SetState(std::string &&json_serialized)
+void CannyFilter::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     props_.FromJson(state);
 }
 
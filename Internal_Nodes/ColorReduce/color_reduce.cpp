@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-ColorReduce::ColorReduce() : Component(ProcessOrder::OutOfOrder)
+ColorReduce::ColorReduce() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Color_Reduce");
@@ -30,6 +30,7 @@ ColorReduce::ColorReduce() : Component(ProcessOrder::OutOfOrder)
 
     div_ = 64;
 
+    SetTileable_(true);
     SetEnabled(true);
 }
 
@@ -43,21 +44,12 @@ void ColorReduce::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat frame;
+            cv::Mat frame(in1->size(), in1->type());
             // Process Image
-            in1->copyTo(frame);
-
-            int nl = frame.rows;
-            int nc = frame.cols * frame.channels();
-
-            if (div_ < 1)
-                div_ = 1;
-            for (int j = 0; j < nl; j++) {
-                uchar *data = frame.ptr<uchar>(j);
-                for (int i = 0; i < nc; i++) {
-                    data[i] = data[i] / div_ * div_ + div_ / 2;
-                }
-            }
+            ProcessTiles_(in1->rows, [&](int firstRow, int lastRow) {
+                cv::Mat tile = frame.rowRange(firstRow, lastRow);
+                ProcessElements({in1->rowRange(firstRow, lastRow)}, tile);
+            });
             if (!frame.empty())
                 outputs.SetValue(0, frame);
         }
@@ -67,6 +59,27 @@ void ColorReduce::Process_(SignalBus const &inputs, SignalBus &outputs)
     }
 }
 
+bool ColorReduce::ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output)
+{
+    if (inputs[0].empty())
+        return false;
+
+    int div = std::max(div_, 1);
+    inputs[0].copyTo(output);
+
+    int nl = output.rows;
+    int nc = output.cols * output.channels();
+
+    for (int j = 0; j < nl; j++) {
+        uchar *data = output.ptr<uchar>(j);
+        for (int i = 0; i < nc; i++) {
+            data[i] = data[i] / div * div + div / 2;
+        }
+    }
+
+    return true;
+}
+
 bool ColorReduce::HasGui(int interface)
 {
     // This is where you tell the system if your node has any of the following interfaces: Main, Control or Other
@@ -93,22 +106,19 @@ void ColorReduce::UpdateGui(void *context, int interface)
     }
 }
 
-std::string ColorReduce::GetState()
+nlohmann::json ColorReduce::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void ColorReduce::SetState(std::string &&json_serialized)
+void ColorReduce::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
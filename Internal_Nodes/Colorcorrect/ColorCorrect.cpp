@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Colorcorrect::Colorcorrect() : Component(ProcessOrder::OutOfOrder)
+Colorcorrect::Colorcorrect() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Color_Correct");
@@ -41,6 +41,7 @@ Colorcorrect::Colorcorrect() : Component(ProcessOrder::OutOfOrder)
     color_range_high_.z = 1.0f;
     UpdateLUT();
 
+    SetTileable_(true);
     SetEnabled(true);
 }
 
@@ -80,63 +81,65 @@ void Colorcorrect::Process_(SignalBus const &inputs, SignalBus &outputs)
                 cv::Mat matFrame = cv::Mat(in1->rows, in1->cols, in1->type());
                 float low[3] = {color_range_low_.z, color_range_low_.y, color_range_low_.x};
                 float high[3] = {color_range_high_.z, color_range_high_.y, color_range_high_.x};
-                for (int y = 0; y < in1->rows; y++) {
-                    for (int x = 0; x < in1->cols; x++) {
-                        cv::Vec3b rgb;
-                        cv::Vec4b rgba;
-                        float lum = 0.0f;
-                        if (matFrame.type() == CV_8UC3) {
-                            rgb = in1->at<cv::Vec3b>(y, x);
-                            lum = ((float)(rgb[0] + rgb[1] + rgb[2]) / 3.0f) / 255.0f;
-                        }
-                        else if (matFrame.type() == CV_8UC4) {
-                            rgba = in1->at<cv::Vec4b>(y, x);
-                            lum = ((float)(rgba[0] + rgba[1] + rgba[2]) / 3.0f) / 255.0f;
-                        }
-                        for (int c = 0; c < matFrame.channels(); c++) {
-                            float val = 0.0f;
-                            if (c < 3) {
-                                if (matFrame.type() == CV_8UC3)
-                                    val = (float)in1->at<cv::Vec3b>(y, x)[c] / 255.0f;
-                                else if (matFrame.type() == CV_8UC4)
-                                    val = (float)in1->at<cv::Vec4b>(y, x)[c] / 255.0f;
-                                if (matMask.at<uchar>(y, x) == 255) {
-                                    if (val >= low[c] && val <= high[c]) {
-                                        // Saturation
-                                        if (saturation_ > 1.0f || saturation_ < 1.0f)
-                                            val = (1.0f - saturation_) * lum + saturation_ * val;
-
-                                        // Gamma
-                                        if (gamma_ > 1.0f || gamma_ < 1.0f) {
-                                            // Use Cached LUT for faster calculation
-                                            uint8_t tmpVal = cv::saturate_cast<uchar>(val * 255.0f);
-                                            val = (float)lut_cache_[tmpVal] / 255.0f;
+                ProcessTiles_(in1->rows, [&](int firstRow, int lastRow) {
+                    for (int y = firstRow; y < lastRow; y++) {
+                        for (int x = 0; x < in1->cols; x++) {
+                            cv::Vec3b rgb;
+                            cv::Vec4b rgba;
+                            float lum = 0.0f;
+                            if (matFrame.type() == CV_8UC3) {
+                                rgb = in1->at<cv::Vec3b>(y, x);
+                                lum = ((float)(rgb[0] + rgb[1] + rgb[2]) / 3.0f) / 255.0f;
+                            }
+                            else if (matFrame.type() == CV_8UC4) {
+                                rgba = in1->at<cv::Vec4b>(y, x);
+                                lum = ((float)(rgba[0] + rgba[1] + rgba[2]) / 3.0f) / 255.0f;
+                            }
+                            for (int c = 0; c < matFrame.channels(); c++) {
+                                float val = 0.0f;
+                                if (c < 3) {
+                                    if (matFrame.type() == CV_8UC3)
+                                        val = (float)in1->at<cv::Vec3b>(y, x)[c] / 255.0f;
+                                    else if (matFrame.type() == CV_8UC4)
+                                        val = (float)in1->at<cv::Vec4b>(y, x)[c] / 255.0f;
+                                    if (matMask.at<uchar>(y, x) == 255) {
+                                        if (val >= low[c] && val <= high[c]) {
+                                            // Saturation
+                                            if (saturation_ > 1.0f || saturation_ < 1.0f)
+                                                val = (1.0f - saturation_) * lum + saturation_ * val;
+
+                                            // Gamma
+                                            if (gamma_ > 1.0f || gamma_ < 1.0f) {
+                                                // Use Cached LUT for faster calculation
+                                                uint8_t tmpVal = cv::saturate_cast<uchar>(val * 255.0f);
+                                                val = (float)lut_cache_[tmpVal] / 255.0f;
+                                            }
+
+                                            // Contrast
+                                            if (contrast_ > 1.0f || contrast_ < 1.0f)
+                                                val = contrast_ * (val - 0.5f) + 0.5f;
+
+                                            // Gain
+                                            if (gain_ > 1.0f || gain_ < 1.0f)
+                                                val *= gain_;
+
+                                            // Brightness
+                                            if (brightness_ > 0.0f || brightness_ < 0.0f)
+                                                val += brightness_;
                                         }
-
-                                        // Contrast
-                                        if (contrast_ > 1.0f || contrast_ < 1.0f)
-                                            val = contrast_ * (val - 0.5f) + 0.5f;
-
-                                        // Gain
-                                        if (gain_ > 1.0f || gain_ < 1.0f)
-                                            val *= gain_;
-
-                                        // Brightness
-                                        if (brightness_ > 0.0f || brightness_ < 0.0f)
-                                            val += brightness_;
                                     }
+                                    if (matFrame.type() == CV_8UC3)
+                                        matFrame.at<cv::Vec3b>(y, x)[c] = cv::saturate_cast<uchar>(val * 255.0f);
+                                    else if (matFrame.type() == CV_8UC4)
+                                        matFrame.at<cv::Vec4b>(y, x)[c] = cv::saturate_cast<uchar>(val * 255.0f);
+                                }
+                                else {
+                                    matFrame.at<cv::Vec4b>(y, x)[c] = in1->at<cv::Vec4b>(y, x)[c];
                                 }
-                                if (matFrame.type() == CV_8UC3)
-                                    matFrame.at<cv::Vec3b>(y, x)[c] = cv::saturate_cast<uchar>(val * 255.0f);
-                                else if (matFrame.type() == CV_8UC4)
-                                    matFrame.at<cv::Vec4b>(y, x)[c] = cv::saturate_cast<uchar>(val * 255.0f);
-                            }
-                            else {
-                                matFrame.at<cv::Vec4b>(y, x)[c] = in1->at<cv::Vec4b>(y, x)[c];
                             }
                         }
                     }
-                }
+                });
                 if (!matFrame.empty())
                     outputs.SetValue(0, matFrame);
             }
@@ -200,7 +203,7 @@ void Colorcorrect::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Colorcorrect::GetState()
+nlohmann::json Colorcorrect::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -222,17 +225,13 @@ std::string Colorcorrect::GetState()
     highColor["B"] = color_range_high_.z;
     state["high_color"] = highColor;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Colorcorrect::SetState(std::string &&json_serialized)
+void Colorcorrect::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("brightness"))
         brightness_ = state["brightness"].get<float>();
 
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Combine::Combine() : Component(ProcessOrder::OutOfOrder)
+Combine::Combine() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Combine");
@@ -92,22 +92,19 @@ void Combine::UpdateGui(void *context, int interface)
     ImGui::SetCurrentContext(imCurContext);
 }
 
-std::string Combine::GetState()
+nlohmann::json Combine::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Combine::SetState(std::string &&json_serialized)
+void Combine::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
@@ -3,6 +3,7 @@
 //
 
 #include "contours.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -12,7 +13,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Contours::Contours() : Component(ProcessOrder::OutOfOrder)
+Contours::Contours() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Contours");
@@ -39,6 +40,7 @@ Contours::Contours() : Component(ProcessOrder::OutOfOrder)
     contour_color_ = ImVec4(0.0f, 1.0f, 0.0f, 0.0f);
     bbox_color_ = ImVec4(0.0f, 0.0f, 1.0f, 0.0f);
 
+    SetEvaluationMode(EvaluationMode::OnChange);
     SetEnabled(true);
 }
 
@@ -70,7 +72,7 @@ void Contours::Process_(SignalBus const &inputs, SignalBus &outputs)
                 frame = cv::Mat(in1->rows, in1->cols, CV_8UC3, cv::Scalar(0, 0, 0));
             }
             else {
-                in2->copyTo(frame);
+                frame = std::move(*inputs.TakeMutable<cv::Mat>(0));
             }
 
             try {
@@ -159,6 +161,11 @@ void Contours::Process_(SignalBus const &inputs, SignalBus &outputs)
     }
 }
 
+bool Contours::HasChanges_()
+{
+    return changed_.exchange(false);
+}
+
 bool Contours::HasGui(int interface)
 {
     // When Creating Strings for Controls use: CreateControlString("Text Here", GetInstanceCount()).c_str()
@@ -175,33 +182,36 @@ void Contours::UpdateGui(void *context, int interface)
     auto *imCurContext = (ImGuiContext *)context;
     ImGui::SetCurrentContext(imCurContext);
     if (interface == (int)FlowCV::GuiInterfaceType_Controls) {
+        bool changed = false;
         ImGui::SetNextItemWidth(100);
-        ImGui::Combo(CreateControlString("Contour Mode", GetInstanceName()).c_str(), &mode_, "External\0List\0COMP\0Tree\0\0");
+        changed |= ImGui::Combo(CreateControlString("Contour Mode", GetInstanceName()).c_str(), &mode_, "External\0List\0COMP\0Tree\0\0");
         ImGui::SetNextItemWidth(100);
-        ImGui::Combo(CreateControlString("Contour Method", GetInstanceName()).c_str(), &method_, "None\0Simple\0TC89_L1\0TC89_KCOS\0\0");
+        changed |= ImGui::Combo(CreateControlString("Contour Method", GetInstanceName()).c_str(), &method_, "None\0Simple\0TC89_L1\0TC89_KCOS\0\0");
         ImGui::Separator();
-        ImGui::Checkbox(CreateControlString("Filter by Area", GetInstanceName()).c_str(), &filter_by_area_);
+        changed |= ImGui::Checkbox(CreateControlString("Filter by Area", GetInstanceName()).c_str(), &filter_by_area_);
         if (filter_by_area_) {
             ImGui::SetNextItemWidth(100);
-            ImGui::DragFloat(CreateControlString("Min Area", GetInstanceName()).c_str(), &area_min_, 0.1f, 1, 1000);
+            changed |= ImGui::DragFloat(CreateControlString("Min Area", GetInstanceName()).c_str(), &area_min_, 0.1f, 1, 1000);
             ImGui::SetNextItemWidth(100);
-            ImGui::DragFloat(CreateControlString("Max Area", GetInstanceName()).c_str(), &area_max_, 0.1f, 1, 5000);
+            changed |= ImGui::DragFloat(CreateControlString("Max Area", GetInstanceName()).c_str(), &area_max_, 0.1f, 1, 5000);
         }
         ImGui::Separator();
-        ImGui::Checkbox(CreateControlString("Draw Contours", GetInstanceName()).c_str(), &draw_contours_);
+        changed |= ImGui::Checkbox(CreateControlString("Draw Contours", GetInstanceName()).c_str(), &draw_contours_);
         if (draw_contours_) {
-            ImGui::Checkbox(CreateControlString("Fill Contours", GetInstanceName()).c_str(), &fill_contours_);
-            ImGui::ColorEdit3(CreateControlString("Contour Color", GetInstanceName()).c_str(), (float *)&contour_color_);
+            changed |= ImGui::Checkbox(CreateControlString("Fill Contours", GetInstanceName()).c_str(), &fill_contours_);
+            changed |= ImGui::ColorEdit3(CreateControlString("Contour Color", GetInstanceName()).c_str(), (float *)&contour_color_);
         }
         ImGui::Separator();
-        ImGui::Checkbox(CreateControlString("Draw BBox", GetInstanceName()).c_str(), &draw_bbox_);
+        changed |= ImGui::Checkbox(CreateControlString("Draw BBox", GetInstanceName()).c_str(), &draw_bbox_);
         if (draw_bbox_) {
-            ImGui::ColorEdit3(CreateControlString("BBox Color", GetInstanceName()).c_str(), (float *)&bbox_color_);
+            changed |= ImGui::ColorEdit3(CreateControlString("BBox Color", GetInstanceName()).c_str(), (float *)&bbox_color_);
         }
+        if (changed)
+            changed_ = true;
     }
 }
 
-std::string Contours::GetState()
+nlohmann::json Contours::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -226,16 +236,13 @@ std::string Contours::GetState()
     bboxColor["B"] = bbox_color_.z;
     state["bbox_color"] = bboxColor;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Contours::SetState(std::string &&json_serialized)
+void Contours::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
     if (state.contains("contour_color")) {
         contour_color_.x = state["contour_color"]["R"].get<float>();
         contour_color_.y = state["contour_color"]["G"].get<float>();
@@ -262,6 +269,7 @@ void Contours::SetState(std::string &&json_serialized)
         fill_contours_ = state["fill_contours"].get<bool>();
     if (state.contains("draw_bbox"))
         draw_bbox_ = state["draw_bbox"].get<bool>();
+    changed_ = true;
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
@@ -6,24 +6,27 @@
 #define FLOWCV_PLUGIN_CONTOURS_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
+#include <atomic>
 
 namespace DSPatch::DSPatchables
 {
 
-class Contours final : public Component
+class Contours final : public FlowCV::JsonState
 {
   public:
     Contours();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
+    bool HasChanges_() override;
 
   private:
     int mode_;
@@ -36,6 +39,7 @@ class Contours final : public Component
     bool draw_bbox_;
     ImVec4 contour_color_;
     ImVec4 bbox_color_;
+    std::atomic<bool> changed_{};
 };
 
 }  // namespace DSPatch::DSPatchables
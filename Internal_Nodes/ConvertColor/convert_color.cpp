@@ -13,7 +13,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-ConvertColor::ConvertColor() : Component(ProcessOrder::OutOfOrder)
+ConvertColor::ConvertColor() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Convert_Color");
@@ -97,7 +97,7 @@ void ConvertColor::UpdateGui(void *context, int interface)
     }
 }
 
-std::string ConvertColor::GetState()
+nlohmann::json ConvertColor::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -105,17 +105,13 @@ std::string ConvertColor::GetState()
 
     state["conv_code"] = cvt_mode_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void ConvertColor::SetState(std::string &&json_serialized)
+void ConvertColor::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("conv_code"))
         cvt_mode_ = state["conv_code"].get<int>();
 }
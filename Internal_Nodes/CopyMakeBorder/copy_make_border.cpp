@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-CopyMakeBorder::CopyMakeBorder() : Component(ProcessOrder::OutOfOrder)
+CopyMakeBorder::CopyMakeBorder() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Copy_Make_Border");
@@ -128,7 +128,7 @@ void CopyMakeBorder::UpdateGui(void *context, int interface)
     }
 }
 
-std::string CopyMakeBorder::GetState()
+nlohmann::json CopyMakeBorder::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -144,17 +144,13 @@ std::string CopyMakeBorder::GetState()
     state["border_color"] = borderColor;
     state["center"] = center_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void CopyMakeBorder::SetState(std::string &&json_serialized)
+void CopyMakeBorder::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("add_width"))
         add_width_ = state["add_width"].get<int>();
     if (state.contains("center"))
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Crop::Crop() : Component(ProcessOrder::OutOfOrder)
+Crop::Crop() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Crop");
@@ -52,9 +52,8 @@ void Crop::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat frame;
+            const cv::Mat &frame = *in1;
             nlohmann::json json_data;
-            in1->copyTo(frame);
 
             if (in2) {
                 json_data = *in2;
@@ -187,7 +186,7 @@ void Crop::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Crop::GetState()
+nlohmann::json Crop::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -204,17 +203,13 @@ std::string Crop::GetState()
     state["adjust_size_x"] = adjust_size_x_;
     state["adjust_size_y"] = adjust_size_y_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Crop::SetState(std::string &&json_serialized)
+void Crop::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("bbox")) {
         crop_area_.x = state["bbox"]["X"].get<int>();
         crop_area_.y = state["bbox"]["Y"].get<int>();
@@ -16,7 +16,8 @@ DnnBackendListHelper::DnnBackendListHelper()
 {
     const std::vector<const char *> backends = {"Default", "Halide", "Inference Engine", "OpenCV", "VkCom", "Cuda"};
 
-    auto backendList = cv::dnn::getAvailableBackends();
+    // Probing backends is slow and their availability doesn't change while running, so probe once for every node
+    static const auto backendList = cv::dnn::getAvailableBackends();
     backend_list_.emplace_back(backends[0], cv::dnn::DNN_BACKEND_DEFAULT);
     for (const auto &b : backendList) {
         if ((int)b.first == 1000000 || b.first == cv::dnn::DNN_BACKEND_INFERENCE_ENGINE) {
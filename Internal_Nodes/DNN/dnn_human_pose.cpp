@@ -3,6 +3,7 @@
 //
 
 #include "dnn_human_pose.hpp"
+#include "FlowCV_MatSignal.hpp"
 #include "dnn_human_pose_helper.hpp"
 #include <fstream>
 
@@ -14,7 +15,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-HumanPose::HumanPose() : Component(ProcessOrder::OutOfOrder)
+HumanPose::HumanPose() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Human_Pose");
@@ -51,12 +52,11 @@ HumanPose::HumanPose() : Component(ProcessOrder::OutOfOrder)
 void HumanPose::InitDnn_()
 {
     try {
-        net_ = std::make_unique<cv::dnn::Net>(cv::dnn::readNet(model_path_, config_path_, ""));
-        net_->setPreferableBackend(current_backend_);
-        net_->setPreferableTarget(current_target_);
-        out_names_ = net_->getLayerNames();
+        net_pool_ = SharedDnnNetCache::GetPool(model_path_, config_path_, current_backend_, current_target_, share_net_);
+        auto net = net_pool_->Acquire();
+        out_names_ = net.Net().getLayerNames();
         std::vector<std::string> layer_types;
-        net_->getLayerTypes(layer_types);
+        net.Net().getLayerTypes(layer_types);
         has_concat_output_ = false;
         has_paf_output_ = true;
         for (const auto &lt : layer_types) {
@@ -91,7 +91,7 @@ void HumanPose::Process_(SignalBus const &inputs, SignalBus &outputs)
             // Process Image
             cv::Mat orig, frame, blob, result;
             std::vector<cv::Mat> netOutputParts;
-            in1->copyTo(orig);
+            orig = std::move(*inputs.TakeMutable<cv::Mat>(0));
             cv::Size modelSize = cv::Size(model_res_[0], model_res_[1]);
             std::vector<cv::Mat> outs;
             PoseSizeInfo poseInfo = getPoseInfo(dataset_mode_);
@@ -102,7 +102,7 @@ void HumanPose::Process_(SignalBus const &inputs, SignalBus &outputs)
 
             if (pre_proc_resize_) {
                 if (model_res_[0] > 0 && model_res_[1] > 0) {
-                    cv::resize(*in1, frame, modelSize);
+                    cv::resize(orig, frame, modelSize);
                 }
                 else
                     frame = orig;
@@ -112,17 +112,19 @@ void HumanPose::Process_(SignalBus const &inputs, SignalBus &outputs)
 
             try {
                 blob = cv::dnn::blobFromImage(frame, scale_, modelSize, cv::Scalar(mean_[0], mean_[1], mean_[2]), swap_rb_, false);
-                net_->setInput(blob);
+                // Held until the outputs are split (and so copied) into parts, result is copied as it's used further down
+                auto net = net_pool_->Acquire();
+                net.Net().setInput(blob);
                 if (has_concat_output_) {
-                    result = net_->forward();
+                    result = net.Net().forward().clone();
                     splitNetOutputBlobToParts(result, cv::Size(frame.cols, frame.rows), netOutputParts);
                 }
                 else {
                     if (out_names_.size() == 2) {
                         std::vector<cv::Mat> netOutTmp;
                         std::vector<std::vector<cv::Mat>> outBlobArray;
-                        net_->forward(outBlobArray, out_names_);
-                        result = outBlobArray.at(1).at(0);
+                        net.Net().forward(outBlobArray, out_names_);
+                        result = outBlobArray.at(1).at(0).clone();
                         splitNetOutputBlobToParts(outBlobArray.at(1).at(0), cv::Size(frame.cols, frame.rows), netOutputParts);
                         splitNetOutputBlobToParts(outBlobArray.at(0).at(0), cv::Size(frame.cols, frame.rows), netOutTmp);
                         for (auto &img : netOutTmp) {
@@ -280,7 +282,7 @@ void HumanPose::Process_(SignalBus const &inputs, SignalBus &outputs)
                 }
             }
             if (pre_proc_resize_) {
-                cv::resize(frame, orig, cv::Size(in1->cols, in1->rows));
+                cv::resize(frame, orig, cv::Size(orig.cols, orig.rows));
             }
             if (!jPoses.empty())
                 json_out["data"] = jPoses;
@@ -355,6 +357,8 @@ void HumanPose::UpdateGui(void *context, int interface)
                 current_target_ = target_list_.at(dnn_target_idx_).second;
                 needs_reinit_ = true;
             }
+            if (ImGui::Checkbox(CreateControlString("Share Network", GetInstanceName()).c_str(), &share_net_))
+                needs_reinit_ = true;
         }
         if (!model_path_.empty() || !config_path_.empty()) {
             ImGui::Separator();
@@ -426,7 +430,7 @@ void HumanPose::UpdateGui(void *context, int interface)
     }
 }
 
-std::string HumanPose::GetState()
+nlohmann::json HumanPose::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -448,18 +452,15 @@ std::string HumanPose::GetState()
     state["swap_rb"] = swap_rb_;
     state["backend"] = (int)current_backend_;
     state["target"] = (int)current_target_;
+    state["share_net"] = share_net_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void HumanPose::SetState(std::string &&json_serialized)
+void HumanPose::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("model_path")) {
         if (!state["model_path"].empty())
             model_path_ = state["model_path"].get<std::string>();
@@ -507,6 +508,9 @@ void HumanPose::SetState(std::string &&json_serialized)
     if (state.contains("target"))
         current_target_ = (cv::dnn::Target)state["target"].get<int>();
 
+    if (state.contains("share_net"))
+        share_net_ = state["share_net"].get<bool>();
+
     // Check Backend and Target
     backend_list_ = dnn_backend_helper_.GetBackEndList();
     bool backendMatch = false;
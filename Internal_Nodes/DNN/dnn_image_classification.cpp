@@ -3,6 +3,7 @@
 //
 
 #include "dnn_image_classification.hpp"
+#include "FlowCV_MatSignal.hpp"
 #include <fstream>
 #include <sstream>
 
@@ -14,7 +15,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Classification::Classification() : Component(ProcessOrder::OutOfOrder)
+Classification::Classification() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Classification");
@@ -67,9 +68,9 @@ void Classification::InitDnn_()
     }
 
     try {
-        net_ = std::make_unique<cv::dnn::Net>(cv::dnn::readNet(model_path_, config_path_, ""));
-        net_->setPreferableBackend(current_backend_);
-        net_->setPreferableTarget(current_target_);
+        net_pool_ = SharedDnnNetCache::GetPool(model_path_, config_path_, current_backend_, current_target_, share_net_);
+        // Loads the first copy, so that a model that won't load is reported here rather than on every frame
+        net_pool_->Acquire();
     }
     catch (...) {
         std::cerr << "DNN Initialization Error" << std::endl;
@@ -95,12 +96,12 @@ void Classification::Process_(SignalBus const &inputs, SignalBus &outputs)
         if (IsEnabled() && !net_load_error && is_initialized_) {
             // Process Image
             cv::Mat orig, frame, blob, prob;
-            in1->copyTo(orig);
+            orig = std::move(*inputs.TakeMutable<cv::Mat>(0));
             cv::Size modelSize = cv::Size(model_res_[0], model_res_[1]);
 
             if (pre_proc_resize_) {
                 if (model_res_[0] > 0 && model_res_[1] > 0) {
-                    cv::resize(*in1, frame, modelSize);
+                    cv::resize(orig, frame, modelSize);
                 }
                 else
                     frame = orig;
@@ -113,8 +114,9 @@ void Classification::Process_(SignalBus const &inputs, SignalBus &outputs)
                 if (std_dev_[0] != 0.0 && std_dev_[1] != 0.0 && std_dev_[2] != 0.0) {
                     cv::divide(blob, cv::Scalar(std_dev_[0], std_dev_[1], std_dev_[2]), blob);
                 }
-                net_->setInput(blob);
-                prob = net_->forward();
+                auto net = net_pool_->Acquire();
+                net.Net().setInput(blob);
+                prob = net.Net().forward().clone();
             }
             catch (std::exception &e) {
                 std::cerr << GetInstanceName() << ", Error Computing DNN" << std::endl;
@@ -235,6 +237,8 @@ void Classification::UpdateGui(void *context, int interface)
                 current_target_ = target_list_.at(dnn_target_idx_).second;
                 needs_reinit_ = true;
             }
+            if (ImGui::Checkbox(CreateControlString("Share Network", GetInstanceName()).c_str(), &share_net_))
+                needs_reinit_ = true;
         }
         if (!model_path_.empty() || !config_path_.empty() || !classes_path_.empty()) {
             ImGui::Separator();
@@ -341,7 +345,7 @@ void Classification::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Classification::GetState()
+nlohmann::json Classification::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -377,18 +381,15 @@ std::string Classification::GetState()
     state["softmax"] = needs_soft_max_;
     state["backend"] = (int)current_backend_;
     state["target"] = (int)current_target_;
+    state["share_net"] = share_net_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Classification::SetState(std::string &&json_serialized)
+void Classification::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     draw_class_ = false;
 
     if (state.contains("model_path")) {
@@ -462,6 +463,9 @@ void Classification::SetState(std::string &&json_serialized)
     if (state.contains("target"))
         current_target_ = (cv::dnn::Target)state["target"].get<int>();
 
+    if (state.contains("share_net"))
+        share_net_ = state["share_net"].get<bool>();
+
     // Check Backend and Target
     backend_list_ = dnn_backend_helper_.GetBackEndList();
     bool backendMatch = false;
@@ -3,6 +3,7 @@
 //
 
 #include "dnn_image_processing.hpp"
+#include "FlowCV_MatSignal.hpp"
 #include <fstream>
 #include <sstream>
 
@@ -14,7 +15,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-ImageProcessing::ImageProcessing() : Component(ProcessOrder::OutOfOrder)
+ImageProcessing::ImageProcessing() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Image_Processing");
@@ -52,9 +53,9 @@ ImageProcessing::ImageProcessing() : Component(ProcessOrder::OutOfOrder)
 void ImageProcessing::InitDnn_()
 {
     try {
-        net_ = std::make_unique<cv::dnn::Net>(cv::dnn::readNet(model_path_, config_path_, ""));
-        net_->setPreferableBackend(current_backend_);
-        net_->setPreferableTarget(current_target_);
+        net_pool_ = SharedDnnNetCache::GetPool(model_path_, config_path_, current_backend_, current_target_, share_net_);
+        // Loads the first copy, so that a model that won't load is reported here rather than on every frame
+        net_pool_->Acquire();
         img_proc_init_mode_ = img_proc_mode_;
         model_init_res_[0] = model_res_[0];
         model_init_res_[1] = model_res_[1];
@@ -83,13 +84,17 @@ void ImageProcessing::Process_(SignalBus const &inputs, SignalBus &outputs)
             // Process Image
             cv::Mat orig, frame, blob;
             cv::Size modelSize = cv::Size(model_init_res_[0], model_init_res_[1]);
-            in1->copyTo(orig);
+            orig = std::move(*inputs.TakeMutable<cv::Mat>(0));
 
             try {
                 if (img_proc_init_mode_ == 0) {  // Style Transfer
                     blob = cv::dnn::blobFromImage(orig, scale_, modelSize, cv::Scalar(mean_[0], mean_[1], mean_[2]), swap_rb_, false);
-                    net_->setInput(blob);
-                    cv::Mat result = net_->forward();
+                    cv::Mat result;
+                    {
+                        auto net = net_pool_->Acquire();
+                        net.Net().setInput(blob);
+                        result = net.Net().forward().clone();
+                    }
                     int C = result.size[1];
                     int H = result.size[2];
                     int W = result.size[3];
@@ -182,6 +187,8 @@ void ImageProcessing::UpdateGui(void *context, int interface)
                 current_target_ = target_list_.at(dnn_target_idx_).second;
                 needs_reinit_ = true;
             }
+            if (ImGui::Checkbox(CreateControlString("Share Network", GetInstanceName()).c_str(), &share_net_))
+                needs_reinit_ = true;
         }
         ImGui::SetNextItemWidth(120);
         if (ImGui::Combo(CreateControlString("Processing Mode", GetInstanceName()).c_str(), &img_proc_mode_, "Style Transfer\0\0")) {
@@ -252,7 +259,7 @@ void ImageProcessing::UpdateGui(void *context, int interface)
     }
 }
 
-std::string ImageProcessing::GetState()
+nlohmann::json ImageProcessing::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -269,18 +276,15 @@ std::string ImageProcessing::GetState()
     state["swap_rb"] = swap_rb_;
     state["backend"] = (int)current_backend_;
     state["target"] = (int)current_target_;
+    state["share_net"] = share_net_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void ImageProcessing::SetState(std::string &&json_serialized)
+void ImageProcessing::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("model_path")) {
         if (!state["model_path"].empty())
             model_path_ = state["model_path"].get<std::string>();
@@ -314,6 +318,9 @@ void ImageProcessing::SetState(std::string &&json_serialized)
     if (state.contains("target"))
         current_target_ = (cv::dnn::Target)state["target"].get<int>();
 
+    if (state.contains("share_net"))
+        share_net_ = state["share_net"].get<bool>();
+
     // Check Backend and Target
     backend_list_ = dnn_backend_helper_.GetBackEndList();
     bool backendMatch = false;
@@ -6,22 +6,24 @@
 #define FLOWCV_PLUGIN_DNN_IMAGE_PROCESSING_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
 #include <ImGuiFileBrowser.h>
 #include "dnn_backend_helper.hpp"
+#include "dnn_shared_net.hpp"
 
 namespace DSPatch::DSPatchables
 {
-class ImageProcessing final : public Component
+class ImageProcessing final : public FlowCV::JsonState
 {
   public:
     ImageProcessing();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
@@ -43,7 +45,7 @@ class ImageProcessing final : public Component
     cv::dnn::Backend current_backend_;
     int dnn_target_idx_;
     cv::dnn::Target current_target_;
-    std::unique_ptr<cv::dnn::Net> net_;
+    std::shared_ptr<DnnNetPool> net_pool_;
     int img_proc_mode_{};
     int img_proc_init_mode_{};
     float mean_[3]{};
@@ -51,6 +53,7 @@ class ImageProcessing final : public Component
     int model_res_[2]{};
     int model_init_res_[2]{};
     bool net_load_error{};
+    bool share_net_{};
     bool needs_reinit_{};
     bool swap_rb_{};
 };
@@ -3,6 +3,7 @@
 //
 
 #include "dnn_object_detection.hpp"
+#include "FlowCV_MatSignal.hpp"
 #include <fstream>
 #include <sstream>
 
@@ -14,7 +15,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-ObjectDetection::ObjectDetection() : Component(ProcessOrder::OutOfOrder)
+ObjectDetection::ObjectDetection() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Object_Detection");
@@ -71,10 +72,10 @@ void ObjectDetection::InitDnn_()
     }
 
     try {
-        net_ = std::make_unique<cv::dnn::Net>(cv::dnn::readNet(model_path_, config_path_, ""));
-        net_->setPreferableBackend(current_backend_);
-        net_->setPreferableTarget(current_target_);
-        out_names_ = net_->getUnconnectedOutLayersNames();
+        net_pool_ = SharedDnnNetCache::GetPool(model_path_, config_path_, current_backend_, current_target_, share_net_);
+        auto net = net_pool_->Acquire();
+        out_names_ = net.Net().getUnconnectedOutLayersNames();
+        out_layer_type_ = net.Net().getLayer(net.Net().getUnconnectedOutLayers()[0])->type;
     }
     catch (...) {
         std::cerr << "DNN Initialization Error" << std::endl;
@@ -126,13 +127,13 @@ void ObjectDetection::Process_(SignalBus const &inputs, SignalBus &outputs)
         if (IsEnabled() && !net_load_error && is_initialized_) {
             // Process Image
             cv::Mat orig, frame, blob, prob;
-            in1->copyTo(orig);
+            orig = std::move(*inputs.TakeMutable<cv::Mat>(0));
             cv::Size modelSize = cv::Size(model_res_[0], model_res_[1]);
             std::vector<cv::Mat> outs;
 
             if (pre_proc_resize_) {
                 if (model_res_[0] > 0 && model_res_[1] > 0) {
-                    cv::resize(*in1, frame, modelSize);
+                    cv::resize(orig, frame, modelSize);
                 }
                 else
                     frame = orig;
@@ -142,14 +143,18 @@ void ObjectDetection::Process_(SignalBus const &inputs, SignalBus &outputs)
 
             try {
                 cv::dnn::blobFromImage(frame, blob, 1.0, modelSize, cv::Scalar(), swap_rb_, crop_, CV_8U);
-                net_->setInput(blob, "", scale_, cv::Scalar(mean_[0], mean_[1], mean_[2]));
-                if (net_->getLayer(0)->outputNameToIndex("im_info") != -1) {  // Faster-RCNN or R-FCN
+                auto net = net_pool_->Acquire();
+                net.Net().setInput(blob, "", scale_, cv::Scalar(mean_[0], mean_[1], mean_[2]));
+                if (net.Net().getLayer(0)->outputNameToIndex("im_info") != -1) {  // Faster-RCNN or R-FCN
                     cv::resize(frame, frame, modelSize);
                     cv::Mat imInfo = (cv::Mat_<float>(1, 3) << modelSize.height, modelSize.width, 1.6f);
-                    net_->setInput(imInfo, "im_info");
+                    net.Net().setInput(imInfo, "im_info");
                 }
 
-                net_->forward(outs, out_names_);
+                net.Net().forward(outs, out_names_);
+                // The outputs refer to the network's own buffers, which the next node to lease it overwrites
+                for (auto &out : outs)
+                    out = out.clone();
             }
             catch (std::exception &e) {
                 std::cerr << GetInstanceName() << ", Error Computing DNN" << std::endl;
@@ -157,8 +162,7 @@ void ObjectDetection::Process_(SignalBus const &inputs, SignalBus &outputs)
                 return;
             }
 
-            std::vector<int> outLayers = net_->getUnconnectedOutLayers();
-            std::string outLayerType = net_->getLayer(outLayers[0])->type;
+            const std::string &outLayerType = out_layer_type_;
             std::vector<int> classIds;
             std::vector<float> confidences;
             std::vector<cv::Rect> boxes;
@@ -342,6 +346,8 @@ void ObjectDetection::UpdateGui(void *context, int interface)
                 current_target_ = target_list_.at(dnn_target_idx_).second;
                 needs_reinit_ = true;
             }
+            if (ImGui::Checkbox(CreateControlString("Share Network", GetInstanceName()).c_str(), &share_net_))
+                needs_reinit_ = true;
         }
         if (!model_path_.empty() || !config_path_.empty() || !classes_path_.empty()) {
             ImGui::Separator();
@@ -456,7 +462,7 @@ void ObjectDetection::UpdateGui(void *context, int interface)
     }
 }
 
-std::string ObjectDetection::GetState()
+nlohmann::json ObjectDetection::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -490,18 +496,15 @@ std::string ObjectDetection::GetState()
     state["swap_rb"] = swap_rb_;
     state["backend"] = (int)current_backend_;
     state["target"] = (int)current_target_;
+    state["share_net"] = share_net_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void ObjectDetection::SetState(std::string &&json_serialized)
+void ObjectDetection::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     draw_class_ = false;
 
     if (state.contains("model_path")) {
@@ -566,6 +569,9 @@ void ObjectDetection::SetState(std::string &&json_serialized)
     if (state.contains("target"))
         current_target_ = (cv::dnn::Target)state["target"].get<int>();
 
+    if (state.contains("share_net"))
+        share_net_ = state["share_net"].get<bool>();
+
     // Check Backend and Target
     backend_list_ = dnn_backend_helper_.GetBackEndList();
     bool backendMatch = false;
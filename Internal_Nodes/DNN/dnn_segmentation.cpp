@@ -3,6 +3,7 @@
 //
 
 #include "dnn_segmentation.hpp"
+#include "FlowCV_MatSignal.hpp"
 #include <fstream>
 #include <sstream>
 
@@ -14,7 +15,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Segmentation::Segmentation() : Component(ProcessOrder::OutOfOrder)
+Segmentation::Segmentation() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Segmentation");
@@ -86,13 +87,9 @@ void Segmentation::InitDnn_()
     }
 
     try {
-        if (!config_path_.empty())
-            net_ = std::make_unique<cv::dnn::Net>(cv::dnn::readNet(model_path_, config_path_, ""));
-        else
-            net_ = std::make_unique<cv::dnn::Net>(cv::dnn::readNet(model_path_, "", ""));
-        net_->setPreferableBackend(current_backend_);
-        net_->setPreferableTarget(current_target_);
-        out_names_ = net_->getUnconnectedOutLayersNames();
+        net_pool_ = SharedDnnNetCache::GetPool(model_path_, config_path_, current_backend_, current_target_, share_net_);
+        auto net = net_pool_->Acquire();
+        out_names_ = net.Net().getUnconnectedOutLayersNames();
     }
     catch (...) {
         std::cerr << "DNN Initialization Error" << std::endl;
@@ -165,12 +162,12 @@ void Segmentation::Process_(SignalBus const &inputs, SignalBus &outputs)
         if (IsEnabled() && !net_load_error && is_initialized_) {
             // Process Image
             cv::Mat orig, frame, blob, prob;
-            in1->copyTo(orig);
+            orig = std::move(*inputs.TakeMutable<cv::Mat>(0));
             cv::Size modelSize = cv::Size(model_res_[0], model_res_[1]);
 
             if (pre_proc_resize_) {
                 if (model_res_[0] > 0 && model_res_[1] > 0) {
-                    cv::resize(*in1, frame, modelSize);
+                    cv::resize(orig, frame, modelSize);
                 }
                 else
                     frame = orig;
@@ -188,8 +185,12 @@ void Segmentation::Process_(SignalBus const &inputs, SignalBus &outputs)
 
             try {
                 cv::dnn::blobFromImage(frame, blob, scale_, modelSize, cv::Scalar(mean_[0], mean_[1], mean_[2]), swap_rb_, false);
-                net_->setInput(blob);
-                cv::Mat score = net_->forward();
+                cv::Mat score;
+                {
+                    auto net = net_pool_->Acquire();
+                    net.Net().setInput(blob);
+                    score = net.Net().forward().clone();
+                }
                 cv::Mat segm;
                 ColorizeSegmentation_(score, segm);
                 resize(segm, frame, orig.size(), 0, 0, cv::INTER_NEAREST);
@@ -285,6 +286,8 @@ void Segmentation::UpdateGui(void *context, int interface)
                 current_target_ = target_list_.at(dnn_target_idx_).second;
                 needs_reinit_ = true;
             }
+            if (ImGui::Checkbox(CreateControlString("Share Network", GetInstanceName()).c_str(), &share_net_))
+                needs_reinit_ = true;
         }
         if (!model_path_.empty() || !config_path_.empty() || !classes_path_.empty()) {
             ImGui::Separator();
@@ -407,7 +410,7 @@ void Segmentation::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Segmentation::GetState()
+nlohmann::json Segmentation::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -427,18 +430,15 @@ std::string Segmentation::GetState()
     state["swap_rb"] = swap_rb_;
     state["backend"] = (int)current_backend_;
     state["target"] = (int)current_target_;
+    state["share_net"] = share_net_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Segmentation::SetState(std::string &&json_serialized)
+void Segmentation::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("model_path")) {
         if (!state["model_path"].empty())
             model_path_ = state["model_path"].get<std::string>();
@@ -482,6 +482,9 @@ void Segmentation::SetState(std::string &&json_serialized)
     if (state.contains("target"))
         current_target_ = (cv::dnn::Target)state["target"].get<int>();
 
+    if (state.contains("share_net"))
+        share_net_ = state["share_net"].get<bool>();
+
     // Check Backend and Target
     backend_list_ = dnn_backend_helper_.GetBackEndList();
     bool backendMatch = false;
@@ -6,22 +6,24 @@
 #define FLOWCV_PLUGIN_DNN_SEGMENTATION_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
 #include <ImGuiFileBrowser.h>
 #include "dnn_backend_helper.hpp"
+#include "dnn_shared_net.hpp"
 
 namespace DSPatch::DSPatchables
 {
-class Segmentation final : public Component
+class Segmentation final : public FlowCV::JsonState
 {
   public:
     Segmentation();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
@@ -54,11 +56,12 @@ class Segmentation final : public Component
     cv::dnn::Backend current_backend_;
     int dnn_target_idx_;
     cv::dnn::Target current_target_;
-    std::unique_ptr<cv::dnn::Net> net_;
+    std::shared_ptr<DnnNetPool> net_pool_;
     float mean_[3]{};
     float scale_;
     int model_res_[2]{};
     bool net_load_error{};
+    bool share_net_{};
     bool needs_reinit_{};
     bool swap_rb_{};
 };
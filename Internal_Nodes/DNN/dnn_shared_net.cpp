@@ -0,0 +1,88 @@
+//
+// Shared DNN Networks
+//
+
+#include "dnn_shared_net.hpp"
+#include <algorithm>
+
+DnnNetPool::Lease::Lease(DnnNetPool *pool, std::unique_ptr<cv::dnn::Net> &&net) : pool_(pool), net_(std::move(net))
+{
+}
+
+DnnNetPool::Lease::~Lease()
+{
+    if (net_ != nullptr)
+        pool_->Release_(std::move(net_));
+}
+
+DnnNetPool::DnnNetPool(std::string model_path, std::string config_path, cv::dnn::Backend backend, cv::dnn::Target target, size_t max_nets)
+    : model_path_(std::move(model_path)), config_path_(std::move(config_path)), backend_(backend), target_(target), max_nets_(std::max<size_t>(max_nets, 1))
+{
+}
+
+DnnNetPool::Lease DnnNetPool::Acquire()
+{
+    std::unique_lock<std::mutex> lk(mutex_);
+    released_.wait(lk, [this] { return !idle_.empty() || net_count_ < max_nets_; });
+    if (!idle_.empty()) {
+        auto net = std::move(idle_.back());
+        idle_.pop_back();
+        return Lease(this, std::move(net));
+    }
+
+    // Load another copy without holding up nodes returning or taking the others
+    net_count_++;
+    lk.unlock();
+    try {
+        auto net = std::make_unique<cv::dnn::Net>(cv::dnn::readNet(model_path_, config_path_, ""));
+        net->setPreferableBackend(backend_);
+        net->setPreferableTarget(target_);
+        return Lease(this, std::move(net));
+    }
+    catch (...) {
+        lk.lock();
+        net_count_--;
+        lk.unlock();
+        released_.notify_one();
+        throw;
+    }
+}
+
+void DnnNetPool::Release_(std::unique_ptr<cv::dnn::Net> &&net)
+{
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        idle_.emplace_back(std::move(net));
+    }
+    released_.notify_one();
+}
+
+std::mutex SharedDnnNetCache::mutex_;
+std::map<SharedDnnNetCache::Key, std::weak_ptr<DnnNetPool>> SharedDnnNetCache::pools_;
+
+std::shared_ptr<DnnNetPool> SharedDnnNetCache::GetPool(const std::string &model_path, const std::string &config_path, cv::dnn::Backend backend,
+                                                       cv::dnn::Target target, bool shared)
+{
+    if (!shared)
+        return std::make_shared<DnnNetPool>(model_path, config_path, backend, target, 1);
+
+    // Pools load their networks when first leased, so this lock is only held for the lookup
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    // Forget pools no node uses any more
+    for (auto pool = pools_.begin(); pool != pools_.end();) {
+        if (pool->second.expired())
+            pool = pools_.erase(pool);
+        else
+            ++pool;
+    }
+
+    Key key(model_path, config_path, (int)backend, (int)target);
+    auto pool = pools_[key].lock();
+    if (pool == nullptr) {
+        pool = std::make_shared<DnnNetPool>(model_path, config_path, backend, target, max_shared_nets);
+        pools_[key] = pool;
+    }
+
+    return pool;
+}
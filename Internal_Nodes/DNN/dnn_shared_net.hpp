@@ -0,0 +1,80 @@
+//
+// Shared DNN Networks
+//
+
+#ifndef DNN_SHARED_NET_HPP_
+#define DNN_SHARED_NET_HPP_
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <opencv2/dnn.hpp>
+
+// Up to max_nets copies of one network (model, config, backend and target). A cv::dnn::Net can't run on several threads
+// at once, so a node leases a copy for each forward pass, and nodes sharing the pool run side by side as long as there
+// are copies free. Copies are loaded when first needed, outside the pool's lock.
+class DnnNetPool
+{
+  public:
+    class Lease
+    {
+      public:
+        Lease(Lease &&) = default;
+        Lease &operator=(Lease &&) = delete;
+        ~Lease();
+
+        cv::dnn::Net &Net()
+        {
+            return *net_;
+        }
+
+      private:
+        friend class DnnNetPool;
+        Lease(DnnNetPool *pool, std::unique_ptr<cv::dnn::Net> &&net);
+
+        DnnNetPool *pool_;
+        std::unique_ptr<cv::dnn::Net> net_;
+    };
+
+    DnnNetPool(std::string model_path, std::string config_path, cv::dnn::Backend backend, cv::dnn::Target target, size_t max_nets);
+
+    // Waits for a free copy if max_nets are in use. Throws as cv::dnn::readNet() does if a copy can't be loaded
+    Lease Acquire();
+
+  private:
+    void Release_(std::unique_ptr<cv::dnn::Net> &&net);
+
+    const std::string model_path_;
+    const std::string config_path_;
+    const cv::dnn::Backend backend_;
+    const cv::dnn::Target target_;
+    const size_t max_nets_;
+
+    std::mutex mutex_;
+    std::condition_variable released_;
+    std::vector<std::unique_ptr<cv::dnn::Net>> idle_;
+    size_t net_count_ = 0;  // Copies loaded or loading, idle or leased
+};
+
+// Pools of networks for DNN nodes. Sharing is opt in (the node's "Share Network" option, which subgraph instances get
+// from their definition): nodes that share get the one pool for their model, config, backend and target, so that memory
+// and load time stay bounded however many instances there are. Other nodes get a pool of their own.
+class SharedDnnNetCache
+{
+  public:
+    static constexpr size_t max_shared_nets = 4;
+
+    static std::shared_ptr<DnnNetPool> GetPool(const std::string &model_path, const std::string &config_path, cv::dnn::Backend backend, cv::dnn::Target target,
+                                               bool shared);
+
+  private:
+    using Key = std::tuple<std::string, std::string, int, int>;
+
+    static std::mutex mutex_;
+    static std::map<Key, std::weak_ptr<DnnNetPool>> pools_;
+};
+
+#endif  // DNN_SHARED_NET_HPP_
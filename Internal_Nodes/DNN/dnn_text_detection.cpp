@@ -3,6 +3,7 @@
 //
 
 #include "dnn_text_detection.hpp"
+#include "FlowCV_MatSignal.hpp"
 #include <fstream>
 #include <sstream>
 
@@ -14,7 +15,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-TextDetection::TextDetection() : Component(ProcessOrder::OutOfOrder)
+TextDetection::TextDetection() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Text_Detection");
@@ -88,13 +89,13 @@ void TextDetection::Process_(SignalBus const &inputs, SignalBus &outputs)
         if (IsEnabled() && !net_load_error && is_initialized_) {
             // Process Image
             cv::Mat orig, frame;
-            in1->copyTo(orig);
+            orig = std::move(*inputs.TakeMutable<cv::Mat>(0));
             cv::Size modelSize = cv::Size(model_res_[0], model_res_[1]);
             std::vector<std::vector<cv::Point>> results;
 
             if (pre_proc_resize_) {
                 if (model_res_[0] > 0 && model_res_[1] > 0) {
-                    cv::resize(*in1, frame, modelSize);
+                    cv::resize(orig, frame, modelSize);
                 }
                 else
                     frame = orig;
@@ -127,8 +128,8 @@ void TextDetection::Process_(SignalBus const &inputs, SignalBus &outputs)
                 for (const auto &p : res) {
                     nlohmann::json jPoint;
                     if (pre_proc_resize_) {
-                        float SX = (float)in1->cols / float(frame.cols);
-                        float SY = (float)in1->rows / float(frame.rows);
+                        float SX = (float)orig.cols / float(frame.cols);
+                        float SY = (float)orig.rows / float(frame.rows);
                         jPoint["x"] = (int)((float)p.x * SX);
                         jPoint["y"] = (int)((float)p.y * SY);
                     }
@@ -146,7 +147,7 @@ void TextDetection::Process_(SignalBus const &inputs, SignalBus &outputs)
                 polylines(frame, results, true, cv::Scalar(bbox_color_.z * 255, bbox_color_.y * 255, bbox_color_.x * 255), bbox_thickness_);
 
             if (pre_proc_resize_) {
-                cv::resize(frame, orig, cv::Size(in1->cols, in1->rows));
+                cv::resize(frame, orig, cv::Size(orig.cols, orig.rows));
             }
 
             if (!detected.empty())
@@ -285,7 +286,7 @@ void TextDetection::UpdateGui(void *context, int interface)
     }
 }
 
-std::string TextDetection::GetState()
+nlohmann::json TextDetection::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -315,17 +316,13 @@ std::string TextDetection::GetState()
     state["backend"] = (int)current_backend_;
     state["target"] = (int)current_target_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void TextDetection::SetState(std::string &&json_serialized)
+void TextDetection::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("model_path")) {
         if (!state["model_path"].empty())
             model_path_ = state["model_path"].get<std::string>();
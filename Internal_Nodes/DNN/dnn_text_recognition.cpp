@@ -3,6 +3,7 @@
 //
 
 #include "dnn_text_recognition.hpp"
+#include "FlowCV_MatSignal.hpp"
 #include <fstream>
 #include <sstream>
 
@@ -25,7 +26,7 @@ void fourPointsTransform(const cv::Mat &frame, const std::vector<cv::Point2f> &v
 namespace DSPatch::DSPatchables
 {
 
-TextRecognition::TextRecognition() : Component(ProcessOrder::OutOfOrder)
+TextRecognition::TextRecognition() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Text_Recognition");
@@ -114,12 +115,12 @@ void TextRecognition::Process_(SignalBus const &inputs, SignalBus &outputs)
         if (IsEnabled() && !net_load_error && is_initialized_) {
             // Process Image
             cv::Mat orig, frame;
-            in1->copyTo(orig);
+            orig = std::move(*inputs.TakeMutable<cv::Mat>(0));
             cv::Size modelSize = cv::Size(model_res_[0], model_res_[1]);
 
             if (pre_proc_resize_) {
                 if (model_res_[0] > 0 && model_res_[1] > 0) {
-                    cv::resize(*in1, frame, modelSize);
+                    cv::resize(orig, frame, modelSize);
                 }
                 else
                     frame = orig;
@@ -193,7 +194,7 @@ void TextRecognition::Process_(SignalBus const &inputs, SignalBus &outputs)
             }
 
             if (pre_proc_resize_) {
-                cv::resize(frame, orig, cv::Size(in1->cols, in1->rows));
+                cv::resize(frame, orig, cv::Size(orig.cols, orig.rows));
             }
 
             if (!detected.empty())
@@ -354,7 +355,7 @@ void TextRecognition::UpdateGui(void *context, int interface)
     }
 }
 
-std::string TextRecognition::GetState()
+nlohmann::json TextRecognition::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -386,17 +387,13 @@ std::string TextRecognition::GetState()
     state["backend"] = (int)current_backend_;
     state["target"] = (int)current_target_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void TextRecognition::SetState(std::string &&json_serialized)
+void TextRecognition::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("model_path")) {
         if (!state["model_path"].empty())
             model_path_ = state["model_path"].get<std::string>();
@@ -54,7 +54,7 @@ static const char *fragShaderSource =
 namespace DSPatch::DSPatchables
 {
 
-DepthViewer3D::DepthViewer3D() : Component(ProcessOrder::OutOfOrder)
+DepthViewer3D::DepthViewer3D() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Depth_Viewer_3D");
@@ -391,7 +391,7 @@ void DepthViewer3D::UpdateGui(void *context, int interface)
     }
 }
 
-std::string DepthViewer3D::GetState()
+nlohmann::json DepthViewer3D::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -456,17 +456,13 @@ std::string DepthViewer3D::GetState()
         state["bg_color"] = jBgCol;
     }
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void DepthViewer3D::SetState(std::string &&json_serialized)
+void DepthViewer3D::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("diff_shading"))
         diff_shading_ = state["diff_shading"].get<bool>();
     if (state.contains("diff_color")) {
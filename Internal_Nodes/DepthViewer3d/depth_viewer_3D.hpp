@@ -6,6 +6,7 @@
 #define FLOWCV_PLUGIN_DEPTH_VIEWER_3D_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "imgui_3d_opengl.hpp"
@@ -28,14 +29,14 @@ struct colorVertNorm
 namespace DSPatch::DSPatchables
 {
 
-class DepthViewer3D final : public Component
+class DepthViewer3D final : public FlowCV::JsonState
 {
   public:
     DepthViewer3D();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
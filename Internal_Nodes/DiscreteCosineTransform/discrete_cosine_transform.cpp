@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-DiscreteCosineTransform::DiscreteCosineTransform() : Component(ProcessOrder::OutOfOrder)
+DiscreteCosineTransform::DiscreteCosineTransform() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("DCT");
@@ -49,7 +49,7 @@ void DiscreteCosineTransform::Process_(SignalBus const &inputs, SignalBus &outpu
                 cv::cvtColor(*in1, dctFrame, cv::COLOR_BGR2GRAY);
             }
             else {
-                in1->copyTo(dctFrame);
+                dctFrame = *in1;
             }
 
             int dft_mode = mode_;
@@ -92,22 +92,19 @@ void DiscreteCosineTransform::UpdateGui(void *context, int interface)
     }
 }
 
-std::string DiscreteCosineTransform::GetState()
+nlohmann::json DiscreteCosineTransform::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void DiscreteCosineTransform::SetState(std::string &&json_serialized)
+void DiscreteCosineTransform::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
@@ -3,6 +3,7 @@
 //
 
 #include "discrete_fourier_transform.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -12,7 +13,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-DiscreteFourierTransform::DiscreteFourierTransform() : Component(ProcessOrder::OutOfOrder)
+DiscreteFourierTransform::DiscreteFourierTransform() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("DFT");
@@ -52,7 +53,7 @@ void DiscreteFourierTransform::Process_(SignalBus const &inputs, SignalBus &outp
                 cv::cvtColor(*in1, dftFrame, cv::COLOR_BGR2GRAY);
             }
             else {
-                in1->copyTo(dftFrame);
+                dftFrame = std::move(*inputs.TakeMutable<cv::Mat>(0));
             }
 
             int dft_mode = mode_;
@@ -149,7 +150,7 @@ void DiscreteFourierTransform::UpdateGui(void *context, int interface)
     }
 }
 
-std::string DiscreteFourierTransform::GetState()
+nlohmann::json DiscreteFourierTransform::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -159,17 +160,13 @@ std::string DiscreteFourierTransform::GetState()
     state["shift_center"] = shift_dc_center_;
     state["op_mode"] = mode_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void DiscreteFourierTransform::SetState(std::string &&json_serialized)
+void DiscreteFourierTransform::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("log_view"))
         log_view_ = state["log_view"].get<bool>();
     if (state.contains("shift_center"))
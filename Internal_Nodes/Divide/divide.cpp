@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Divide::Divide() : Component(ProcessOrder::OutOfOrder)
+Divide::Divide() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Divide");
@@ -30,6 +30,7 @@ Divide::Divide() : Component(ProcessOrder::OutOfOrder)
 
     scale_ = 1.0f;
 
+    SetTileable_(true);
     SetEnabled(true);
 }
 
@@ -45,8 +46,12 @@ void Divide::Process_(SignalBus const &inputs, SignalBus &outputs)
         if (IsEnabled()) {
             // Process Image
             if (in1->type() == in2->type() && in1->channels() == in2->channels() && in1->size == in2->size) {
-                cv::Mat frame;
-                cv::divide(*in1, *in2, frame, scale_);
+                cv::Mat frame(in1->size(), in1->type());
+                std::vector<cv::Mat> frames = {*in1, *in2};
+                ProcessTiles_(in1->rows, [&](int firstRow, int lastRow) {
+                    cv::Mat tile = frame.rowRange(firstRow, lastRow);
+                    ProcessElements(SliceRows(frames, firstRow, lastRow), tile);
+                });
 
                 if (!frame.empty())
                     outputs.SetValue(0, frame);
@@ -58,6 +63,18 @@ void Divide::Process_(SignalBus const &inputs, SignalBus &outputs)
     }
 }
 
+bool Divide::ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output)
+{
+    const cv::Mat &in1 = inputs[0];
+    const cv::Mat &in2 = inputs[1];
+    if (in1.empty() || in2.empty() || in1.type() != in2.type() || in1.size != in2.size)
+        return false;
+
+    cv::divide(in1, in2, output, scale_);
+
+    return true;
+}
+
 bool Divide::HasGui(int interface)
 {
     // This is where you tell the system if your node has any of the following interfaces: Main, Control or Other
@@ -81,7 +98,7 @@ void Divide::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Divide::GetState()
+nlohmann::json Divide::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -89,17 +106,13 @@ std::string Divide::GetState()
 
     state["scale"] = scale_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Divide::SetState(std::string &&json_serialized)
+void Divide::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("scale"))
         scale_ = state["scale"].get<float>();
 }
@@ -3,6 +3,7 @@
 //
 
 #include "draw_datetime.hpp"
+#include "FlowCV_MatSignal.hpp"
 #include <ctime>
 
 using namespace DSPatch;
@@ -25,7 +26,7 @@ static void HelpMarker(const char *desc)
     }
 }
 
-DrawDateTime::DrawDateTime() : Component(ProcessOrder::OutOfOrder)
+DrawDateTime::DrawDateTime() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Draw_Date_Time");
@@ -75,8 +76,7 @@ void DrawDateTime::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat frame;
-            in1->copyTo(frame);
+            cv::Mat frame = std::move(*inputs.TakeMutable<cv::Mat>(0));
             std::string outStr;
             time_t now = time(nullptr);
             struct tm tstruct
@@ -208,7 +208,7 @@ void DrawDateTime::UpdateGui(void *context, int interface)
     }
 }
 
-std::string DrawDateTime::GetState()
+nlohmann::json DrawDateTime::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -233,17 +233,13 @@ std::string DrawDateTime::GetState()
     if (draw_time_)
         state["time_fmt"] = time_format_str_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void DrawDateTime::SetState(std::string &&json_serialized)
+void DrawDateTime::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("color")) {
         text_color_.x = state["color"]["R"].get<float>();
         text_color_.y = state["color"]["G"].get<float>();
@@ -3,6 +3,7 @@
 //
 
 #include "draw_json.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -24,7 +25,7 @@ static void HelpMarker(const char *desc)
     }
 }
 
-DrawJson::DrawJson() : Component(ProcessOrder::OutOfOrder)
+DrawJson::DrawJson() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Draw_JSON");
@@ -93,8 +94,7 @@ void DrawJson::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat frame;
-            in1->copyTo(frame);
+            cv::Mat frame = std::move(*inputs.TakeMutable<cv::Mat>(0));
             cv::Point2i start_pos = text_pos_;
             int txt_offset = 14;
             if (in2) {
@@ -312,7 +312,7 @@ void DrawJson::UpdateGui(void *context, int interface)
     }
 }
 
-std::string DrawJson::GetState()
+nlohmann::json DrawJson::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -343,17 +343,13 @@ std::string DrawJson::GetState()
     }
     state["out_list"] = outList;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void DrawJson::SetState(std::string &&json_serialized)
+void DrawJson::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("color")) {
         text_color_.x = state["color"]["R"].get<float>();
         text_color_.y = state["color"]["G"].get<float>();
@@ -3,6 +3,7 @@
 //
 
 #include "draw_number.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -12,7 +13,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-DrawNumber::DrawNumber() : Component(ProcessOrder::OutOfOrder)
+DrawNumber::DrawNumber() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Draw_Number");
@@ -50,8 +51,7 @@ void DrawNumber::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat frame;
-            in1->copyTo(frame);
+            cv::Mat frame = std::move(*inputs.TakeMutable<cv::Mat>(0));
             std::string outStr;
 
             if (in2) {
@@ -116,7 +116,7 @@ void DrawNumber::UpdateGui(void *context, int interface)
     }
 }
 
-std::string DrawNumber::GetState()
+nlohmann::json DrawNumber::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -135,17 +135,13 @@ std::string DrawNumber::GetState()
     tColor["B"] = text_color_.z;
     state["color"] = tColor;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void DrawNumber::SetState(std::string &&json_serialized)
+void DrawNumber::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("color")) {
         text_color_.x = state["color"]["R"].get<float>();
         text_color_.y = state["color"]["G"].get<float>();
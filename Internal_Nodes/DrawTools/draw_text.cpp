@@ -3,6 +3,7 @@
 //
 
 #include "draw_text.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -12,7 +13,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-DrawText::DrawText() : Component(ProcessOrder::OutOfOrder)
+DrawText::DrawText() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Draw_Text");
@@ -55,8 +56,7 @@ void DrawText::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat frame;
-            in1->copyTo(frame);
+            cv::Mat frame = std::move(*inputs.TakeMutable<cv::Mat>(0));
 
             if (has_str_input_) {
                 cv::putText(frame, *in2, text_pos_, text_font_, text_scale_, cv::Scalar(text_color_.z * 255, text_color_.y * 255, text_color_.x * 255),
@@ -119,7 +119,7 @@ void DrawText::UpdateGui(void *context, int interface)
     }
 }
 
-std::string DrawText::GetState()
+nlohmann::json DrawText::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -141,17 +141,13 @@ std::string DrawText::GetState()
     tColor["B"] = text_color_.z;
     state["color"] = tColor;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void DrawText::SetState(std::string &&json_serialized)
+void DrawText::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     memset(text_, '\0', 128);
 
     if (state.contains("text")) {
@@ -0,0 +1,63 @@
+//
+// Element-Wise Node Interface
+//
+
+#ifndef FLOWCV_ELEMENT_WISE_HPP_
+#define FLOWCV_ELEMENT_WISE_HPP_
+#include <opencv2/core.hpp>
+#include <vector>
+
+namespace DSPatch::DSPatchables
+{
+
+// Implemented by internal nodes whose output pixels depend only on the input pixels at the same position, so that
+// chains of them can be fused into a single pass over the frame (see FusedChain).
+//
+// ProcessElements() applies the node to one input per input index (unconnected inputs are passed as empty Mats), which
+// are either whole frames or the same rows of each. It writes into output in place when output already has the right
+// size and type, and returns false where the node would output nothing. IsElementWise() returns false while the node's
+// settings make it depend on the whole frame (E.g. Otsu thresholding), in which case it must be given whole frames.
+class ElementWise
+{
+  public:
+    virtual ~ElementWise() = default;
+
+    virtual bool IsElementWise()
+    {
+        return true;
+    }
+
+    virtual bool ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output) = 0;
+
+    // True if every connected input is the size of the first, so that the inputs can be processed in row stripes
+    static bool SameSize(std::vector<cv::Mat> const &inputs)
+    {
+        for (const auto &input : inputs) {
+            if (!input.empty() && input.size() != inputs.front().size())
+                return false;
+        }
+        return true;
+    }
+
+    // The mask if it is connected and the size of frame, else an empty Mat: a mask of any other size is treated as absent
+    static cv::Mat MaskFor(const cv::Mat *mask, const cv::Mat &frame)
+    {
+        if (mask == nullptr || mask->empty() || mask->size() != frame.size())
+            return {};
+        return *mask;
+    }
+
+    static std::vector<cv::Mat> SliceRows(std::vector<cv::Mat> const &inputs, int firstRow, int lastRow)
+    {
+        std::vector<cv::Mat> slices(inputs.size());
+        for (size_t i = 0; i < inputs.size(); i++) {
+            if (!inputs[i].empty())
+                slices[i] = inputs[i].rowRange(firstRow, lastRow);
+        }
+        return slices;
+    }
+};
+
+}  // namespace DSPatch::DSPatchables
+
+#endif  // FLOWCV_ELEMENT_WISE_HPP_
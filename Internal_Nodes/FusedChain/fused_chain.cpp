@@ -0,0 +1,198 @@
+//
+// Fused Chain Of Element-Wise Nodes
+//
+
+#include "fused_chain.hpp"
+#include <algorithm>
+#include <atomic>
+
+using namespace DSPatch;
+using namespace DSPatchables;
+
+namespace
+{
+// Rows per stripe are picked so that a stripe of the widest input fits in this many bytes, hence every member's
+// intermediate stripe is still in cache when the next member reads it
+constexpr size_t stripeBytes = 64 * 1024;
+
+Component::ProcessOrder ChainProcessOrder(std::vector<std::shared_ptr<Component>> const &members)
+{
+    for (const auto &member : members) {
+        if (member->GetProcessOrder() == Component::ProcessOrder::InOrder)
+            return Component::ProcessOrder::InOrder;
+    }
+    return Component::ProcessOrder::OutOfOrder;
+}
+}  // namespace
+
+namespace DSPatch::DSPatchables
+{
+
+FusedChain::FusedChain(std::vector<std::shared_ptr<Component>> members, std::vector<int> chained_inputs) : Component(ChainProcessOrder(members))
+{
+    // Name and Category
+    SetComponentName_("Fused_Chain");
+    SetComponentCategory_(DSPatch::Category::Category_Utility);
+    SetComponentAuthor_("Richard");
+    SetComponentVersion_("0.1.0");
+
+    std::vector<std::string> inputNames;
+    std::vector<IoType> inputTypes;
+    for (size_t i = 0; i < members.size(); i++) {
+        Member member;
+        member.node = members[i];
+        member.kernel = dynamic_cast<ElementWise *>(members[i].get());
+        member.chained_input = chained_inputs[i];
+        for (int j = 0; j < member.node->GetInputCount(); j++) {
+            if (j == member.chained_input) {
+                member.fused_inputs.emplace_back(-1);
+                continue;
+            }
+            member.fused_inputs.emplace_back((int)inputNames.size());
+            inputNames.emplace_back(std::string(member.node->GetInstanceName()) + " " + member.node->GetInputName(j));
+            inputTypes.emplace_back(member.node->GetInputType(j));
+        }
+        members_.emplace_back(std::move(member));
+    }
+
+    SetInputCount_((int)inputNames.size(), inputNames, inputTypes);
+
+    // 1 outputs
+    SetOutputCount_(1, {"out"}, {IoType::Io_Type_CvMat});
+
+    SetTileable_(true);
+    SetEnabled(true);
+}
+
+int FusedChain::GetFusedInput(size_t member, int input) const
+{
+    if (member < members_.size() && input >= 0 && input < (int)members_[member].fused_inputs.size())
+        return members_[member].fused_inputs[input];
+
+    return -1;
+}
+
+void FusedChain::Process_(SignalBus const &inputs, SignalBus &outputs)
+{
+    // Gather each member's external inputs, and whether it is enabled for this frame
+    std::vector<std::vector<cv::Mat>> frames(members_.size());
+    std::vector<bool> enabled(members_.size());
+    bool striped = true;
+    for (size_t m = 0; m < members_.size(); m++) {
+        const auto &member = members_[m];
+        frames[m].resize(member.fused_inputs.size());
+        for (size_t i = 0; i < member.fused_inputs.size(); i++) {
+            if (member.fused_inputs[i] == -1)
+                continue;
+            auto in = inputs.GetValue<cv::Mat>(member.fused_inputs[i]);
+            if (in)
+                frames[m][i] = *in;
+        }
+        enabled[m] = member.node->IsEnabled();
+        if (enabled[m] && !member.kernel->IsElementWise())
+            striped = false;
+    }
+
+    const cv::Mat &head = frames[0][0];
+    if (head.empty())
+        return;
+
+    size_t rowBytes = 0;
+    for (const auto &memberFrames : frames) {
+        for (const auto &frame : memberFrames) {
+            if (!frame.empty() && frame.size() != head.size())
+                striped = false;
+            if (!frame.empty())
+                rowBytes = std::max(rowBytes, frame.step[0]);
+        }
+    }
+
+    std::vector<cv::Mat> scratch(members_.size());
+    if (!striped) {
+        cv::Mat frame;
+        if (ProcessStripe_(frames, enabled, scratch, frame))
+            outputs.SetValue(0, frame);
+        return;
+    }
+
+    auto sliceRows = [&frames](int firstRow, int lastRow) {
+        std::vector<std::vector<cv::Mat>> slices;
+        slices.reserve(frames.size());
+        for (const auto &memberFrames : frames)
+            slices.emplace_back(ElementWise::SliceRows(memberFrames, firstRow, lastRow));
+        return slices;
+    };
+
+    int rowCount = head.rows;
+    int stripeRows = std::clamp((int)(stripeBytes / std::max(rowBytes, (size_t)1)), 1, rowCount);
+
+    // The first stripe tells us the chain's output type, every other stripe is written straight into the output
+    cv::Mat firstStripe;
+    auto firstFrames = sliceRows(0, stripeRows);
+    if (!ProcessStripe_(firstFrames, enabled, scratch, firstStripe))
+        return;
+
+    cv::Mat frame(rowCount, firstStripe.cols, firstStripe.type());
+    firstStripe.copyTo(frame.rowRange(0, stripeRows));
+
+    std::atomic<bool> complete(true);
+    ProcessTiles_(rowCount - stripeRows, [&](int firstRow, int lastRow) {
+        std::vector<cv::Mat> tileScratch(members_.size());
+        for (int row = stripeRows + firstRow; row < stripeRows + lastRow && complete; row += stripeRows) {
+            int endRow = std::min(row + stripeRows, stripeRows + lastRow);
+            auto stripeFrames = sliceRows(row, endRow);
+            cv::Mat stripe = frame.rowRange(row, endRow);
+            const uchar *stripeData = stripe.data;
+            // a member that outputs nothing, or a stripe of a different type or size, can't be assembled into the output
+            if (!ProcessStripe_(stripeFrames, enabled, tileScratch, stripe) || stripe.data != stripeData)
+                complete = false;
+        }
+    });
+
+    if (complete)
+        outputs.SetValue(0, frame);
+}
+
+bool FusedChain::ProcessStripe_(std::vector<std::vector<cv::Mat>> &frames, std::vector<bool> const &enabled, std::vector<cv::Mat> &scratch, cv::Mat &output)
+{
+    for (size_t m = 0; m < members_.size(); m++) {
+        const auto &member = members_[m];
+        if (m > 0)
+            frames[m][member.chained_input] = scratch[m - 1];
+
+        cv::Mat &out = m + 1 == members_.size() ? output : scratch[m];
+        if (!enabled[m]) {
+            if (frames[m][0].empty())
+                return false;
+            if (&out == &output)
+                frames[m][0].copyTo(out);
+            else
+                out = frames[m][0];
+        }
+        else if (!member.kernel->ProcessElements(frames[m], out)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FusedChain::HasGui(int interface)
+{
+    return false;
+}
+
+void FusedChain::UpdateGui(void *context, int interface)
+{
+}
+
+std::string FusedChain::GetState()
+{
+    return {};
+}
+
+void FusedChain::SetState(std::string &&json_serialized)
+{
+}
+
+}  // End Namespace DSPatch::DSPatchables
@@ -0,0 +1,51 @@
+//
+// Fused Chain Of Element-Wise Nodes
+//
+
+#ifndef FLOWCV_FUSED_CHAIN_HPP_
+#define FLOWCV_FUSED_CHAIN_HPP_
+#include <DSPatch.h>
+#include "FlowCV_Types.hpp"
+#include "element_wise.hpp"
+
+namespace DSPatch::DSPatchables
+{
+
+// Stands in for a linear chain of element-wise nodes within a circuit, where each member's output only feeds the next
+// member. Rather than pass whole frames from member to member, each frame is processed in cache sized row stripes that
+// go through every member in turn, with the last member writing straight into the chain's output. The chain takes the
+// external inputs of every member (in member then input order) and outputs the last member's output.
+//
+// Members keep their own settings and GUI, and are only ever asked to ProcessElements(). A disabled member passes its
+// first input through, as its Process_() would.
+class FusedChain final : public Component
+{
+  public:
+    // chained_inputs[i] is the input of members[i] fed by members[i - 1] (-1 for members[0])
+    FusedChain(std::vector<std::shared_ptr<Component>> members, std::vector<int> chained_inputs);
+    void UpdateGui(void *context, int interface) override;
+    bool HasGui(int interface) override;
+    std::string GetState() override;
+    void SetState(std::string &&json_serialized) override;
+    [[nodiscard]] int GetFusedInput(size_t member, int input) const;
+
+  protected:
+    void Process_(SignalBus const &inputs, SignalBus &outputs) override;
+
+  private:
+    struct Member
+    {
+        std::shared_ptr<Component> node;
+        ElementWise *kernel;
+        int chained_input;
+        std::vector<int> fused_inputs;  // chain input for each of the member's inputs (-1 for the chained input)
+    };
+
+    bool ProcessStripe_(std::vector<std::vector<cv::Mat>> &frames, std::vector<bool> const &enabled, std::vector<cv::Mat> &scratch, cv::Mat &output);
+
+    std::vector<Member> members_;
+};
+
+}  // namespace DSPatch::DSPatchables
+
+#endif  // FLOWCV_FUSED_CHAIN_HPP_
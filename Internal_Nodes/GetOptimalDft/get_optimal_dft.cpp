@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-GetOptimalDft::GetOptimalDft() : Component(ProcessOrder::OutOfOrder)
+GetOptimalDft::GetOptimalDft() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Get_Optimal_DFT_Size");
@@ -99,22 +99,19 @@ void GetOptimalDft::UpdateGui(void *context, int interface)
     ImGui::SetCurrentContext(imCurContext);
 }
 
-std::string GetOptimalDft::GetState()
+nlohmann::json GetOptimalDft::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void GetOptimalDft::SetState(std::string &&json_serialized)
+void GetOptimalDft::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
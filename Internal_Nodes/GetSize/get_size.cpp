@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-GetSize::GetSize() : Component(ProcessOrder::OutOfOrder)
+GetSize::GetSize() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Get_Size");
@@ -58,22 +58,19 @@ void GetSize::UpdateGui(void *context, int interface)
     ImGui::SetCurrentContext(imCurContext);
 }
 
-std::string GetSize::GetState()
+nlohmann::json GetSize::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void GetSize::SetState(std::string &&json_serialized)
+void GetSize::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-HistogramViewer::HistogramViewer() : Component(ProcessOrder::OutOfOrder)
+HistogramViewer::HistogramViewer() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Histogram");
@@ -135,22 +135,19 @@ void HistogramViewer::UpdateGui(void *context, int interface)
     }
 }
 
-std::string HistogramViewer::GetState()
+nlohmann::json HistogramViewer::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void HistogramViewer::SetState(std::string &&json_serialized)
+void HistogramViewer::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
@@ -3,6 +3,7 @@
 //
 
 #include "hough_circles.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -12,7 +13,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-HCircles::HCircles() : Component(ProcessOrder::OutOfOrder)
+HCircles::HCircles() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Hough_Circles");
@@ -62,9 +63,8 @@ void HCircles::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat cannyImg, visImg;
-
-            in1->copyTo(cannyImg);
+            cv::Mat cannyImg = *in1;
+            cv::Mat visImg;
 
             // Process Image
             if (cannyImg.type() == CV_8UC3 && cannyImg.channels() == 3) {
@@ -75,7 +75,7 @@ void HCircles::Process_(SignalBus const &inputs, SignalBus &outputs)
 
             if (in2) {
                 if (!in2->empty()) {
-                    in2->copyTo(visImg);
+                    visImg = std::move(*inputs.TakeMutable<cv::Mat>(0));
                 }
                 else {
                     visImg = cv::Mat(cannyImg.rows, cannyImg.cols, CV_8UC3, cv::Scalar(0, 0, 0));
@@ -172,7 +172,7 @@ void HCircles::UpdateGui(void *context, int interface)
     }
 }
 
-std::string HCircles::GetState()
+nlohmann::json HCircles::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -207,17 +207,13 @@ std::string HCircles::GetState()
     txtColor["B"] = text_color_.z;
     state["text_color"] = txtColor;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void HCircles::SetState(std::string &&json_serialized)
+void HCircles::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("dp")) {
         dp_ = state["dp"].get<float>();
     }
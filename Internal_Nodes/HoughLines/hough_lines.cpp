@@ -109,7 +109,7 @@ static std::optional<Line> GetInsideLine(const Line &l1, int width, int height)
 namespace DSPatch::DSPatchables
 {
 
-HoughLines::HoughLines() : Component(ProcessOrder::OutOfOrder)
+HoughLines::HoughLines() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Hough_Lines");
@@ -163,8 +163,8 @@ void HoughLines::Process_(SignalBus const &inputs, SignalBus &outputs)
                 valid_format_ = false;
 
             if (valid_format_) {
-                cv::Mat frame, outFrame;
-                in1->copyTo(frame);
+                const cv::Mat &frame = *in1;
+                cv::Mat outFrame;
                 std::vector<cv::Vec2f> found_lines;
                 std::vector<cv::Vec4i> found_p_lines;
 
@@ -287,7 +287,7 @@ void HoughLines::UpdateGui(void *context, int interface)
     }
 }
 
-std::string HoughLines::GetState()
+nlohmann::json HoughLines::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -308,17 +308,13 @@ std::string HoughLines::GetState()
     state["line_color"] = lineColor;
     state["line_thickness"] = line_thickness_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void HoughLines::SetState(std::string &&json_serialized)
+void HoughLines::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("draw_lines"))
         draw_lines_ = state["draw_lines"].get<bool>();
     if (state.contains("rho"))
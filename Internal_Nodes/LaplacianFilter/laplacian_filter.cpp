@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-LaplacianFilter::LaplacianFilter() : Component(ProcessOrder::OutOfOrder)
+LaplacianFilter::LaplacianFilter() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Laplacian");
@@ -114,7 +114,7 @@ void LaplacianFilter::UpdateGui(void *context, int interface)
     }
 }
 
-std::string LaplacianFilter::GetState()
+nlohmann::json LaplacianFilter::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -125,17 +125,13 @@ std::string LaplacianFilter::GetState()
     state["delta"] = delta_;
     state["ksize"] = ksize_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void LaplacianFilter::SetState(std::string &&json_serialized)
+void LaplacianFilter::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("depth_out"))
         out_depth_ = state["depth_out"].get<int>();
     if (state.contains("scale"))
@@ -3,6 +3,7 @@
 //
 
 #include "line_intersect.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -14,7 +15,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-LineIntersect::LineIntersect() : Component(ProcessOrder::OutOfOrder)
+LineIntersect::LineIntersect() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Line_Intersections");
@@ -77,7 +78,7 @@ void LineIntersect::Process_(SignalBus const &inputs, SignalBus &outputs)
     cv::Mat ref_frame;
     if (in_img) {
         if (!in_img->empty())
-            in_img->copyTo(ref_frame);
+            ref_frame = std::move(*inputs.TakeMutable<cv::Mat>(0));
     }
 
     if (!in_json->empty()) {
@@ -205,7 +206,7 @@ void LineIntersect::UpdateGui(void *context, int interface)
     }
 }
 
-std::string LineIntersect::GetState()
+nlohmann::json LineIntersect::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -223,17 +224,13 @@ std::string LineIntersect::GetState()
     pntColor["B"] = point_color_.z;
     state["point_color"] = pntColor;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void LineIntersect::SetState(std::string &&json_serialized)
+void LineIntersect::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("min_angle"))
         min_angle_ = state["min_angle"].get<float>();
     if (state.contains("min_dist"))
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Magnitude::Magnitude() : Component(ProcessOrder::OutOfOrder)
+Magnitude::Magnitude() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Magnitude");
@@ -70,22 +70,19 @@ void Magnitude::UpdateGui(void *context, int interface)
     ImGui::SetCurrentContext(imCurContext);
 }
 
-std::string Magnitude::GetState()
+nlohmann::json Magnitude::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Magnitude::SetState(std::string &&json_serialized)
+void Magnitude::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Mean::Mean() : Component(ProcessOrder::OutOfOrder)
+Mean::Mean() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Mean");
@@ -111,7 +111,7 @@ void Mean::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Mean::GetState()
+nlohmann::json Mean::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -121,17 +121,13 @@ std::string Mean::GetState()
     state["calc_mean"] = calc_mean_;
     state["calc_std_dev"] = calc_std_dev_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Mean::SetState(std::string &&json_serialized)
+void Mean::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("scale"))
         scale_ = state["scale"].get<float>();
     if (state.contains("calc_mean"))
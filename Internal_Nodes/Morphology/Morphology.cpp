@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Morphology::Morphology() : Component(ProcessOrder::OutOfOrder)
+Morphology::Morphology() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Morphology");
@@ -102,7 +102,7 @@ void Morphology::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Morphology::GetState()
+nlohmann::json Morphology::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -118,17 +118,13 @@ std::string Morphology::GetState()
     borderColor["G"] = border_color_.y;
     borderColor["B"] = border_color_.z;
     state["border_color"] = borderColor;
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Morphology::SetState(std::string &&json_serialized)
+void Morphology::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("operation"))
         op_ = state["operation"].get<int>();
     if (state.contains("shape"))
@@ -14,7 +14,7 @@ namespace DSPatch::DSPatchables
 
 static int NormTypeValues[9] = {1, 2, 4, 32};
 
-Normalize::Normalize() : Component(ProcessOrder::OutOfOrder)
+Normalize::Normalize() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Normalize");
@@ -99,7 +99,7 @@ void Normalize::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Normalize::GetState()
+nlohmann::json Normalize::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -109,17 +109,13 @@ std::string Normalize::GetState()
     state["alpha"] = alpha_;
     state["beta"] = beta_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Normalize::SetState(std::string &&json_serialized)
+void Normalize::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("norm_type"))
         norm_type_ = state["norm_type"].get<int>();
     if (state.contains("alpha"))
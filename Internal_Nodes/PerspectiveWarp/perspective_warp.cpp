@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-PerspectiveWarp::PerspectiveWarp() : Component(ProcessOrder::OutOfOrder)
+PerspectiveWarp::PerspectiveWarp() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Perspective_Warp");
@@ -181,7 +181,7 @@ void PerspectiveWarp::UpdateGui(void *context, int interface)
     }
 }
 
-std::string PerspectiveWarp::GetState()
+nlohmann::json PerspectiveWarp::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -194,17 +194,13 @@ std::string PerspectiveWarp::GetState()
         state["fixed_width"] = fixed_width_;
         state["fixed_height"] = fixed_height_;
     }
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void PerspectiveWarp::SetState(std::string &&json_serialized)
+void PerspectiveWarp::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("aspect_ratio_adj"))
         ratio_adjustment_ = state["aspect_ratio_adj"].get<float>();
     if (state.contains("interp_mode"))
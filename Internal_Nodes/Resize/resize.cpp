@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Resize::Resize() : Component(ProcessOrder::OutOfOrder)
+Resize::Resize() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Resize");
@@ -135,7 +135,7 @@ void Resize::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Resize::GetState()
+nlohmann::json Resize::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -145,17 +145,13 @@ std::string Resize::GetState()
     state["height"] = height_;
     state["mode"] = interp_mode_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Resize::SetState(std::string &&json_serialized)
+void Resize::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("width"))
         width_ = state["width"].get<int>();
     if (state.contains("height"))
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-RndNoise::RndNoise() : Component(ProcessOrder::OutOfOrder)
+RndNoise::RndNoise() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Rnd_Noise");
@@ -47,12 +47,10 @@ void RndNoise::Process_(SignalBus const &inputs, SignalBus &outputs)
 {
 
     if (io_mutex_.try_lock()) {  // Try lock so other threads will skip if locked instead of waiting
-        bool should_wait = true;
-        while (should_wait) {
-            std::chrono::steady_clock::time_point current_time_ = std::chrono::steady_clock::now();
-            auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(current_time_ - last_time_).count();
-            if (delta >= (uint32_t)fps_time_)
-                should_wait = false;
+        // Sleep (or request a tick) until the next frame is due instead of spinning
+        if (!PaceTick_(last_time_, std::chrono::microseconds((int64_t)(fps_time_ * 1000.0f)))) {
+            io_mutex_.unlock();
+            return;
         }
         if (change_settings_) {
             width_ = tmp_width_;
@@ -74,7 +72,6 @@ void RndNoise::Process_(SignalBus const &inputs, SignalBus &outputs)
 
         if (!frame.empty())
             outputs.SetValue(0, frame);
-        last_time_ = std::chrono::steady_clock::now();
 
         io_mutex_.unlock();
     }
@@ -113,7 +110,7 @@ void RndNoise::UpdateGui(void *context, int interface)
     }
 }
 
-std::string RndNoise::GetState()
+nlohmann::json RndNoise::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -125,17 +122,13 @@ std::string RndNoise::GetState()
     state["fps"] = fps_;
     state["fps_index"] = fps_index_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void RndNoise::SetState(std::string &&json_serialized)
+void RndNoise::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("mode"))
         mode_ = state["mode"].get<int>();
     if (state.contains("width"))
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-ScaleAbs::ScaleAbs() : Component(ProcessOrder::OutOfOrder)
+ScaleAbs::ScaleAbs() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Scale_Abs");
@@ -31,6 +31,7 @@ ScaleAbs::ScaleAbs() : Component(ProcessOrder::OutOfOrder)
     alpha_ = 1.0;
     beta_ = 0.0;
 
+    SetTileable_(true);
     SetEnabled(true);
 }
 
@@ -44,9 +45,12 @@ void ScaleAbs::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            cv::Mat frame;
+            cv::Mat frame(in1->size(), CV_8UC(in1->channels()));
             // Process Image
-            cv::convertScaleAbs(*in1, frame, alpha_, beta_);
+            ProcessTiles_(in1->rows, [&](int firstRow, int lastRow) {
+                cv::Mat tile = frame.rowRange(firstRow, lastRow);
+                ProcessElements({in1->rowRange(firstRow, lastRow)}, tile);
+            });
             if (!frame.empty())
                 outputs.SetValue(0, frame);
         }
@@ -56,6 +60,16 @@ void ScaleAbs::Process_(SignalBus const &inputs, SignalBus &outputs)
     }
 }
 
+bool ScaleAbs::ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output)
+{
+    if (inputs[0].empty())
+        return false;
+
+    cv::convertScaleAbs(inputs[0], output, alpha_, beta_);
+
+    return true;
+}
+
 bool ScaleAbs::HasGui(int interface)
 {
     // This is where you tell the system if your node has any of the following interfaces: Main, Control or Other
@@ -81,7 +95,7 @@ void ScaleAbs::UpdateGui(void *context, int interface)
     }
 }
 
-std::string ScaleAbs::GetState()
+nlohmann::json ScaleAbs::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -90,17 +104,13 @@ std::string ScaleAbs::GetState()
     state["alpha"] = alpha_;
     state["beta"] = beta_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void ScaleAbs::SetState(std::string &&json_serialized)
+void ScaleAbs::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("alpha"))
         alpha_ = state["alpha"].get<float>();
     if (state.contains("beta"))
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-ScharrFilter::ScharrFilter() : Component(ProcessOrder::OutOfOrder)
+ScharrFilter::ScharrFilter() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Scharr");
@@ -110,7 +110,7 @@ void ScharrFilter::UpdateGui(void *context, int interface)
     }
 }
 
-std::string ScharrFilter::GetState()
+nlohmann::json ScharrFilter::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -121,17 +121,13 @@ std::string ScharrFilter::GetState()
     state["scale"] = scale_;
     state["delta"] = delta_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void ScharrFilter::SetState(std::string &&json_serialized)
+void ScharrFilter::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("derivative_order"))
         derivative_order_ = state["derivative_order"].get<int>();
     if (state.contains("depth_out"))
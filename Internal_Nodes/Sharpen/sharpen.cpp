@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Sharpen::Sharpen() : Component(ProcessOrder::OutOfOrder)
+Sharpen::Sharpen() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Sharpen");
@@ -31,6 +31,8 @@ Sharpen::Sharpen() : Component(ProcessOrder::OutOfOrder)
     props_.AddOption("sharpen_mode", "Sharpen Mode", 0, {"Mode 1", "Mode 2"});
     props_.AddInt("sharpen_amt", "Sharpen", 0, 0, 3, 0.25f);
 
+    SetChangeProbe_([this] { return props_.HasChanges(); });
+    SetEvaluationMode(EvaluationMode::OnChange);
     SetEnabled(true);
 }
 
@@ -46,11 +48,11 @@ void Sharpen::Process_(SignalBus const &inputs, SignalBus &outputs)
         cv::Mat frame;
 
         if (IsEnabled()) {
-            props_.Sync();
+            auto props = props_.Snapshot();
 
             // Process Image
-            int amt = props_.Get<int>("sharpen_amt");
-            if (props_.Get<int>("sharpen_mode") == 0) {
+            int amt = props->Get<int>("sharpen_amt");
+            if (props->Get<int>("sharpen_mode") == 0) {
                 cv::Mat kernel3 = cv::Mat_<double>(3, 3);
                 if (amt >= 1) {
                     if (amt == 1) {
@@ -89,7 +91,7 @@ void Sharpen::Process_(SignalBus const &inputs, SignalBus &outputs)
                     filter2D(*in1, frame, -1, kernel3, cv::Point(-1, -1), 0, cv::BORDER_DEFAULT);
                 }
                 else {
-                    in1->copyTo(frame);
+                    frame = *in1;
                 }
             }
             else {
@@ -108,7 +110,7 @@ void Sharpen::Process_(SignalBus const &inputs, SignalBus &outputs)
             }
         }
         else {
-            in1->copyTo(frame);
+            frame = *in1;
         }
 
         if (!frame.empty())
@@ -144,7 +146,7 @@ void Sharpen::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Sharpen::GetState()
+nlohmann::json Sharpen::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -152,17 +154,13 @@ std::string Sharpen::GetState()
 
     props_.ToJson(state);
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Sharpen::SetState(std::string &&json_serialized)
+void Sharpen::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     props_.FromJson(state);
 }
 
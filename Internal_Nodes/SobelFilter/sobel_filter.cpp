@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-SobelFilter::SobelFilter() : Component(ProcessOrder::OutOfOrder)
+SobelFilter::SobelFilter() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Sobel");
@@ -121,7 +121,7 @@ void SobelFilter::UpdateGui(void *context, int interface)
     }
 }
 
-std::string SobelFilter::GetState()
+nlohmann::json SobelFilter::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -133,17 +133,13 @@ std::string SobelFilter::GetState()
     state["delta"] = delta_;
     state["ksize"] = ksize_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void SobelFilter::SetState(std::string &&json_serialized)
+void SobelFilter::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("derivative_order"))
         derivative_order_ = state["derivative_order"].get<int>();
     if (state.contains("depth_out"))
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Solid::Solid() : Component(ProcessOrder::InOrder)
+Solid::Solid() : FlowCV::JsonState(ProcessOrder::InOrder)
 {
     // Name and Category
     SetComponentName_("Solid");
@@ -39,6 +39,7 @@ Solid::Solid() : Component(ProcessOrder::InOrder)
     last_time_ = std::chrono::steady_clock::now();
     fps_time_ = (1.0f / (float)fps_) * 1000.0f;
 
+    SetEvaluationMode(EvaluationMode::OnChange);
     SetEnabled(true);
 }
 
@@ -46,12 +47,15 @@ void Solid::Process_(SignalBus const &inputs, SignalBus &outputs)
 {
 
     if (io_mutex_.try_lock()) {  // Try lock so other threads will skip if locked instead of waiting
-        bool should_wait = true;
-        while (should_wait) {
-            std::chrono::steady_clock::time_point current_time_ = std::chrono::steady_clock::now();
-            auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(current_time_ - last_time_).count();
-            if (delta >= (uint32_t)fps_time_)
-                should_wait = false;
+        // Sleep (or request a tick) until the next frame is due instead of spinning
+        if (!PaceTick_(last_time_, std::chrono::microseconds((int64_t)(fps_time_ * 1000.0f)))) {
+            io_mutex_.unlock();
+            return;
+        }
+        // Re-emit the last frame unless a setting has changed since
+        if (!changed_.exchange(false) && ReuseOutputs_(outputs)) {
+            io_mutex_.unlock();
+            return;
         }
         cv::Mat frame;
         if (is_color_) {
@@ -64,7 +68,6 @@ void Solid::Process_(SignalBus const &inputs, SignalBus &outputs)
             frame = cv::Mat(height_, width_, CV_8UC1, cv::Scalar(grey_value_));
         }
         outputs.SetValue(0, frame);
-        last_time_ = std::chrono::steady_clock::now();
 
         io_mutex_.unlock();
     }
@@ -86,41 +89,47 @@ void Solid::UpdateGui(void *context, int interface)
     ImGui::SetCurrentContext(imCurContext);
 
     if (interface == (int)FlowCV::GuiInterfaceType_Controls) {
+        bool changed = false;
         ImGui::SetNextItemWidth(100);
-        ImGui::Checkbox(CreateControlString("Color", GetInstanceName()).c_str(), &is_color_);
+        changed |= ImGui::Checkbox(CreateControlString("Color", GetInstanceName()).c_str(), &is_color_);
         if (is_color_) {
             ImGui::SetNextItemWidth(100);
-            ImGui::Checkbox(CreateControlString("Has Alpha", GetInstanceName()).c_str(), &has_alpha_);
+            changed |= ImGui::Checkbox(CreateControlString("Has Alpha", GetInstanceName()).c_str(), &has_alpha_);
             // ImGui::SetNextItemWidth(300);
             if (has_alpha_)
-                ImGui::ColorEdit4(CreateControlString("Solid Color", GetInstanceName()).c_str(), (float *)&color_);
+                changed |= ImGui::ColorEdit4(CreateControlString("Solid Color", GetInstanceName()).c_str(), (float *)&color_);
             else
-                ImGui::ColorEdit3(CreateControlString("Solid Color", GetInstanceName()).c_str(), (float *)&color_);
+                changed |= ImGui::ColorEdit3(CreateControlString("Solid Color", GetInstanceName()).c_str(), (float *)&color_);
         }
         else {
             // ImGui::SetNextItemWidth(100);
-            ImGui::SliderInt(CreateControlString("Solid Value", GetInstanceName()).c_str(), &grey_value_, 0, 255);
+            changed |= ImGui::SliderInt(CreateControlString("Solid Value", GetInstanceName()).c_str(), &grey_value_, 0, 255);
         }
         ImGui::SetNextItemWidth(100);
         if (ImGui::DragInt(CreateControlString("Width", GetInstanceName()).c_str(), &width_, 0.5, 1, 10000)) {
+            changed = true;
             if (width_ < 2)
                 width_ = 2;
         }
         ImGui::SetNextItemWidth(100);
         if (ImGui::DragInt(CreateControlString("Height", GetInstanceName()).c_str(), &height_, 0.5, 1, 10000)) {
+            changed = true;
             if (height_ < 2)
                 height_ = 2;
         }
         ImGui::SetNextItemWidth(80);
         const int fpsValues[] = {1, 3, 5, 10, 15, 20, 25, 30, 60, 120};
         if (ImGui::Combo(CreateControlString("Output FPS", GetInstanceName()).c_str(), &fps_index_, " 1\0 3\0 5\0 10\0 15\0 20\0 25\0 30\0 60\0 120\0\0")) {
+            changed = true;
             fps_ = fpsValues[fps_index_];
             fps_time_ = (1.0f / (float)fps_) * 1000.0f;
         }
+        if (changed)
+            changed_ = true;
     }
 }
 
-std::string Solid::GetState()
+nlohmann::json Solid::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -140,17 +149,13 @@ std::string Solid::GetState()
     state["is_color"] = is_color_;
     state["has_alpha"] = has_alpha_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Solid::SetState(std::string &&json_serialized)
+void Solid::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("width"))
         width_ = state["width"].get<int>();
     if (state.contains("height"))
@@ -171,6 +176,7 @@ void Solid::SetState(std::string &&json_serialized)
         is_color_ = state["is_color"].get<int>();
     if (state.contains("has_alpha"))
         has_alpha_ = state["has_alpha"].get<int>();
+    changed_ = true;
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
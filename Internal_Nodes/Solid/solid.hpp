@@ -6,21 +6,23 @@
 #define FLOWCV_PLUGIN_SOLID_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
+#include <atomic>
 
 namespace DSPatch::DSPatchables
 {
 
-class Solid final : public Component
+class Solid final : public FlowCV::JsonState
 {
   public:
     Solid();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
@@ -37,6 +39,7 @@ class Solid final : public Component
     std::chrono::steady_clock::time_point last_time_;
     bool is_color_;
     bool has_alpha_;
+    std::atomic<bool> changed_{true};
 };
 
 }  // namespace DSPatch::DSPatchables
@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Split::Split() : Component(ProcessOrder::OutOfOrder)
+Split::Split() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Split");
@@ -83,22 +83,19 @@ void Split::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Split::GetState()
+nlohmann::json Split::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Split::SetState(std::string &&json_serialized)
+void Split::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
 }
 
 }  // End Namespace DSPatch::DSPatchables
\ No newline at end of file
@@ -6,6 +6,7 @@
 #define FLOWCV_PLUGIN_SPLIT_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "FlowCV_Properties.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
@@ -14,14 +15,14 @@
 namespace DSPatch::DSPatchables
 {
 
-class Split final : public Component
+class Split final : public FlowCV::JsonState
 {
   public:
     Split();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
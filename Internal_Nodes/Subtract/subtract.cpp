@@ -12,7 +12,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Subtract::Subtract() : Component(ProcessOrder::OutOfOrder)
+Subtract::Subtract() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Subtract");
@@ -28,9 +28,9 @@ Subtract::Subtract() : Component(ProcessOrder::OutOfOrder)
     // 1 outputs
     SetOutputCount_(1, {"out"}, {IoType::Io_Type_CvMat});
 
-    has_mask_ = false;
     mask_mode_ = 0;
 
+    SetTileable_(true);
     SetEnabled(true);
 }
 
@@ -43,29 +43,16 @@ void Subtract::Process_(SignalBus const &inputs, SignalBus &outputs)
         return;
     }
 
-    has_mask_ = false;
-    if (mask)
-        if (!mask->empty())
-            if (mask->channels() == 1)
-                has_mask_ = true;
-
     if (!in1->empty() && !in2->empty()) {
         if (IsEnabled()) {
             // Process Image
             if (in1->type() == in2->type() && in1->channels() == in2->channels() && in1->size == in2->size) {
-                cv::Mat frame;
-                if (has_mask_) {
-                    if (mask_mode_ == 1)
-                        in1->copyTo(frame);
-                    else if (mask_mode_ == 2)
-                        in2->copyTo(frame);
-                }
-
-                if (has_mask_) {
-                    cv::subtract(*in1, *in2, frame, *mask);
-                }
-                else
-                    cv::subtract(*in1, *in2, frame);
+                cv::Mat frame(in1->size(), in1->type());
+                std::vector<cv::Mat> frames = {*in1, *in2, MaskFor(mask, *in1)};
+                ProcessTiles_(in1->rows, [&](int firstRow, int lastRow) {
+                    cv::Mat tile = frame.rowRange(firstRow, lastRow);
+                    ProcessElements(SliceRows(frames, firstRow, lastRow), tile);
+                });
 
                 if (!frame.empty())
                     outputs.SetValue(0, frame);
@@ -77,6 +64,32 @@ void Subtract::Process_(SignalBus const &inputs, SignalBus &outputs)
     }
 }
 
+bool Subtract::ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output)
+{
+    const cv::Mat &in1 = inputs[0];
+    const cv::Mat &in2 = inputs[1];
+    const cv::Mat &mask = inputs[2];
+    if (in1.empty() || in2.empty() || in1.type() != in2.type() || in1.size != in2.size)
+        return false;
+
+    bool has_mask = !mask.empty() && mask.channels() == 1 && mask.size == in1.size;
+
+    output.create(in1.size(), in1.type());
+    if (has_mask) {
+        if (mask_mode_ == 1)
+            in1.copyTo(output);
+        else if (mask_mode_ == 2)
+            in2.copyTo(output);
+        else
+            output.setTo(cv::Scalar(0, 0, 0));
+        cv::subtract(in1, in2, output, mask);
+    }
+    else
+        cv::subtract(in1, in2, output);
+
+    return true;
+}
+
 bool Subtract::HasGui(int interface)
 {
     // This is where you tell the system if your node has any of the following interfaces: Main, Control or Other
@@ -99,7 +112,7 @@ void Subtract::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Subtract::GetState()
+nlohmann::json Subtract::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -107,17 +120,13 @@ std::string Subtract::GetState()
 
     state["mask_mode"] = mask_mode_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Subtract::SetState(std::string &&json_serialized)
+void Subtract::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("mask_mode"))
         mask_mode_ = state["mask_mode"].get<int>();
 }
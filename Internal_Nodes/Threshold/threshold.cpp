@@ -3,6 +3,7 @@
 //
 
 #include "threshold.hpp"
+#include <atomic>
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -12,7 +13,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Threshold::Threshold() : Component(ProcessOrder::OutOfOrder)
+Threshold::Threshold() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Threshold");
@@ -37,6 +38,7 @@ Threshold::Threshold() : Component(ProcessOrder::OutOfOrder)
     hsv_low_ = ImVec4(0, 0, 0, 0);
     hsv_high_ = ImVec4(1, 1, 1, 0);
 
+    SetTileable_(true);
     SetEnabled(true);
 }
 
@@ -50,41 +52,24 @@ void Threshold::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
+            Settings settings = Settings_();
             cv::Mat frame;
             // Process Image
-            if (thresh_method_ == 0) {  // Simple
-                cv::threshold(*in1, frame, thresh_amt_, 255, thresh_type_);
+            if (IsElementWise_(settings)) {
+                frame.create(in1->size(), settings.thresh_method == 0 ? in1->type() : CV_8UC1);
+                // A stripe that comes out another type or size is written somewhere else, leaving its rows of frame unset
+                std::atomic<bool> complete(true);
+                ProcessTiles_(in1->rows, [&](int firstRow, int lastRow) {
+                    cv::Mat tile = frame.rowRange(firstRow, lastRow);
+                    const uchar *tileData = tile.data;
+                    if (!ProcessElements_(settings, {in1->rowRange(firstRow, lastRow)}, tile) || tile.data != tileData)
+                        complete = false;
+                });
+                if (!complete)
+                    frame.release();
             }
-            else if (thresh_method_ == 1) {  // Color Range
-                ImVec4 hsv1, hsv2;
-                ImGui::ColorConvertRGBtoHSV(hsv_low_.x, hsv_low_.y, hsv_low_.z, hsv1.x, hsv1.y, hsv1.z);
-                ImGui::ColorConvertRGBtoHSV(hsv_high_.x, hsv_high_.y, hsv_high_.z, hsv2.x, hsv2.y, hsv2.z);
-                if (in1->channels() > 1)
-                    cv::cvtColor(*in1, frame, cv::COLOR_BGR2HSV);
-                else {
-                    cv::cvtColor(*in1, frame, cv::COLOR_GRAY2BGR);
-                    cv::cvtColor(frame, frame, cv::COLOR_BGR2HSV);
-                }
-                // OpenCV Hue is scaled to half 360 range (0 - 179)
-                cv::inRange(frame, cv::Scalar(hsv1.x * 179, hsv1.y * 255, hsv1.z * 255), cv::Scalar(hsv2.x * 179, hsv2.y * 255, hsv2.z * 255), frame);
-            }
-            else if (thresh_method_ == 2) {  // Adaptive
-                if (in1->channels() > 1)
-                    cv::cvtColor(*in1, frame, cv::COLOR_BGR2GRAY);
-                else
-                    in1->copyTo(frame);
-
-                int aThreshType = thresh_type_;
-                if (aThreshType > 1)
-                    aThreshType = 1;
-                cv::adaptiveThreshold(frame, frame, 255, adapt_type_, aThreshType, adapt_block_, adapt_thresh_);
-            }
-            else if (thresh_method_ == 3) {  // Otsu
-                if (in1->channels() > 1)
-                    cv::cvtColor(*in1, frame, cv::COLOR_BGR2GRAY);
-                else
-                    in1->copyTo(frame);
-                cv::threshold(frame, frame, 0, 255, thresh_type_ + cv::THRESH_OTSU);
+            else {
+                ProcessElements_(settings, {*in1}, frame);
             }
 
             if (!frame.empty())
@@ -96,6 +81,76 @@ void Threshold::Process_(SignalBus const &inputs, SignalBus &outputs)
     }
 }
 
+Threshold::Settings Threshold::Settings_()
+{
+    std::lock_guard<std::mutex> lk(settings_mutex_);
+    return {thresh_method_, thresh_amt_, thresh_type_, adapt_type_, adapt_thresh_, adapt_block_, hsv_low_, hsv_high_};
+}
+
+bool Threshold::IsElementWise()
+{
+    return IsElementWise_(Settings_());
+}
+
+bool Threshold::IsElementWise_(const Settings &settings)
+{
+    // Adaptive and Otsu thresholds depend on the pixels around (or the histogram of) the whole frame
+    return settings.thresh_method == 0 || settings.thresh_method == 1;
+}
+
+bool Threshold::ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output)
+{
+    return ProcessElements_(Settings_(), inputs, output);
+}
+
+bool Threshold::ProcessElements_(const Settings &settings, std::vector<cv::Mat> const &inputs, cv::Mat &output)
+{
+    const cv::Mat &in1 = inputs[0];
+    if (in1.empty())
+        return false;
+
+    if (settings.thresh_method == 0) {  // Simple
+        cv::threshold(in1, output, settings.thresh_amt, 255, settings.thresh_type);
+    }
+    else if (settings.thresh_method == 1) {  // Color Range
+        ImVec4 hsv1, hsv2;
+        ImGui::ColorConvertRGBtoHSV(settings.hsv_low.x, settings.hsv_low.y, settings.hsv_low.z, hsv1.x, hsv1.y, hsv1.z);
+        ImGui::ColorConvertRGBtoHSV(settings.hsv_high.x, settings.hsv_high.y, settings.hsv_high.z, hsv2.x, hsv2.y, hsv2.z);
+        cv::Mat hsv;
+        if (in1.channels() > 1)
+            cv::cvtColor(in1, hsv, cv::COLOR_BGR2HSV);
+        else {
+            cv::cvtColor(in1, hsv, cv::COLOR_GRAY2BGR);
+            cv::cvtColor(hsv, hsv, cv::COLOR_BGR2HSV);
+        }
+        // OpenCV Hue is scaled to half 360 range (0 - 179)
+        cv::inRange(hsv, cv::Scalar(hsv1.x * 179, hsv1.y * 255, hsv1.z * 255), cv::Scalar(hsv2.x * 179, hsv2.y * 255, hsv2.z * 255), output);
+    }
+    else if (settings.thresh_method == 2) {  // Adaptive
+        if (in1.channels() > 1)
+            cv::cvtColor(in1, output, cv::COLOR_BGR2GRAY);
+        else
+            in1.copyTo(output);
+
+        int aThreshType = settings.thresh_type;
+        if (aThreshType > 1)
+            aThreshType = 1;
+        cv::adaptiveThreshold(output, output, 255, settings.adapt_type, aThreshType, settings.adapt_block, settings.adapt_thresh);
+    }
+    else if (settings.thresh_method == 3) {  // Otsu
+        if (in1.channels() > 1)
+            cv::cvtColor(in1, output, cv::COLOR_BGR2GRAY);
+        else
+            in1.copyTo(output);
+        cv::threshold(output, output, 0, 255, settings.thresh_type + cv::THRESH_OTSU);
+    }
+    else {
+        return false;
+    }
+
+    return true;
+}
+
 bool Threshold::HasGui(int interface)
 {
     // When Creating Strings for Controls use: CreateControlString("Text Here", GetInstanceCount()).c_str()
@@ -113,6 +168,7 @@ void Threshold::UpdateGui(void *context, int interface)
     ImGui::SetCurrentContext(imCurContext);
 
     if (interface == (int)FlowCV::GuiInterfaceType_Controls) {
+        std::lock_guard<std::mutex> lk(settings_mutex_);
         ImGui::SetNextItemWidth(120);
         ImGui::Combo(CreateControlString("Method", GetInstanceName()).c_str(), &thresh_method_, "Simple\0Color Range\0Adaptive\0Otsu\0\0");
         ImGui::SetNextItemWidth(120);
@@ -144,12 +200,13 @@ void Threshold::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Threshold::GetState()
+nlohmann::json Threshold::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
+    std::lock_guard<std::mutex> lk(settings_mutex_);
     state["thresh_method"] = thresh_method_;
     state["thresh_amt"] = thresh_amt_;
     state["thresh_type"] = thresh_type_;
@@ -167,17 +224,14 @@ std::string Threshold::GetState()
     highColor["B"] = hsv_high_.z;
     state["high_range"] = highColor;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Threshold::SetState(std::string &&json_serialized)
+void Threshold::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
+    std::lock_guard<std::mutex> lk(settings_mutex_);
     if (state.contains("low_range")) {
         hsv_low_.x = state["low_range"]["R"].get<float>();
         hsv_low_.y = state["low_range"]["G"].get<float>();
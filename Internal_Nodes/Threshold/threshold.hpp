@@ -5,27 +5,50 @@
 #ifndef FLOWCV_PLUGIN_THRESHOLD_HPP_
 #define FLOWCV_PLUGIN_THRESHOLD_HPP_
 #include <DSPatch.h>
+#include <mutex>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
+#include "FusedChain/element_wise.hpp"
 
 namespace DSPatch::DSPatchables
 {
 
-class Threshold final : public Component
+class Threshold final : public FlowCV::JsonState, public ElementWise
 {
   public:
     Threshold();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
+    bool IsElementWise() override;
+    bool ProcessElements(std::vector<cv::Mat> const &inputs, cv::Mat &output) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
 
   private:
+    // The settings a frame is processed with, copied once per frame so that every stripe is processed the same way
+    struct Settings
+    {
+        int thresh_method;
+        int thresh_amt;
+        int thresh_type;
+        int adapt_type;
+        int adapt_thresh;
+        int adapt_block;
+        ImVec4 hsv_low;
+        ImVec4 hsv_high;
+    };
+
+    Settings Settings_();
+    static bool IsElementWise_(const Settings &settings);
+    static bool ProcessElements_(const Settings &settings, std::vector<cv::Mat> const &inputs, cv::Mat &output);
+
+    std::mutex settings_mutex_;  // Guards the settings below, which the GUI and SetStateJson() change while frames are processed
     int thresh_method_;
     int thresh_amt_;
     int thresh_type_;
@@ -3,6 +3,7 @@
 //
 
 #include "transform.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -12,7 +13,7 @@ static int32_t global_inst_counter = 0;
 namespace DSPatch::DSPatchables
 {
 
-Transform::Transform() : Component(ProcessOrder::OutOfOrder)
+Transform::Transform() : FlowCV::JsonState(ProcessOrder::OutOfOrder)
 {
     // Name and Category
     SetComponentName_("Transform");
@@ -57,18 +58,17 @@ void Transform::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (!in1->empty()) {
         if (IsEnabled()) {
-            // Thread safe sync properties from UI
-            props_.Sync();
+            // Snapshot properties from UI, other buffers may be processing with their own
+            auto props = props_.Snapshot();
 
             // Process Image
-            cv::Mat frame_;
-            in1->copyTo(frame_);
+            cv::Mat frame_ = std::move(*inputs.TakeMutable<cv::Mat>(0));
             props_.Set("res_x", frame_.cols);
             props_.Set("res_y", frame_.rows);
             props_.Set("aspect_ratio", (float)frame_.rows / (float)frame_.cols);
 
             // Flip
-            switch (props_.Get<int>("flip_mode")) {
+            switch (props->Get<int>("flip_mode")) {
                 case 1:  // Horizontal
                     cv::flip(frame_, frame_, 0);
                     break;
@@ -81,7 +81,7 @@ void Transform::Process_(SignalBus const &inputs, SignalBus &outputs)
             }
 
             // Rotate
-            switch (props_.Get<int>("rot_mode")) {
+            switch (props->Get<int>("rot_mode")) {
                 case 1:
                     cv::rotate(frame_, frame_, cv::ROTATE_90_CLOCKWISE);
                     break;
@@ -92,7 +92,7 @@ void Transform::Process_(SignalBus const &inputs, SignalBus &outputs)
                     cv::rotate(frame_, frame_, cv::ROTATE_180);
                     break;
                 case 4:
-                    auto ang = props_.Get<float>("angle");
+                    auto ang = props->Get<float>("angle");
                     if (ang > 0 || ang < 0) {
                         cv::Point2f center((float)(frame_.cols - 1) / 2.0f, (float)(frame_.rows - 1) / 2.0f);
                         cv::Mat rotation_matix = getRotationMatrix2D(center, ang, 1.0);
@@ -101,7 +101,7 @@ void Transform::Process_(SignalBus const &inputs, SignalBus &outputs)
             }
 
             // Translate
-            cv::Point2f trans((float)props_.Get<int>("trans_x"), (float)props_.Get<int>("trans_y"));
+            cv::Point2f trans((float)props->Get<int>("trans_x"), (float)props->Get<int>("trans_y"));
             if (trans.x > 0 || trans.x < 0 || trans.y > 0 || trans.y < 0) {
                 cv::Mat trans_mat = (cv::Mat_<double>(2, 3) << 1, 0, trans.x, 0, 1, trans.y);
                 cv::warpAffine(frame_, frame_, trans_mat, frame_.size());
@@ -109,9 +109,9 @@ void Transform::Process_(SignalBus const &inputs, SignalBus &outputs)
 
             // Scale
             bool applyScale = false;
-            cv::Point2f scale(props_.Get<float>("scale_x"), props_.Get<float>("scale_y"));
+            cv::Point2f scale(props->Get<float>("scale_x"), props->Get<float>("scale_y"));
             cv::Point2f scaleVal;
-            if (props_.Get<int>("scale_mode") == 0) {
+            if (props->Get<int>("scale_mode") == 0) {
                 scaleVal.x = (float)frame_.cols * (scale.x / 100.0f);
                 scaleVal.y = (float)frame_.rows * (scale.y / 100.0f);
 
@@ -133,7 +133,7 @@ void Transform::Process_(SignalBus const &inputs, SignalBus &outputs)
             }
 
             if (applyScale) {
-                switch (props_.Get<int>("interp")) {
+                switch (props->Get<int>("interp")) {
                     case 0:
                         cv::resize(frame_, frame_, cv::Size((int)scaleVal.x, (int)scaleVal.y), 0, 0, cv::INTER_NEAREST);
                         break;
@@ -222,7 +222,7 @@ void Transform::UpdateGui(void *context, int interface)
     }
 }
 
-std::string Transform::GetState()
+nlohmann::json Transform::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -230,17 +230,13 @@ std::string Transform::GetState()
 
     props_.ToJson(state);
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void Transform::SetState(std::string &&json_serialized)
+void Transform::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     props_.FromJson(state);
 
     if (props_.Get<int>("scale_mode") == 0) {
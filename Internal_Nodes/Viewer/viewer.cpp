@@ -3,6 +3,7 @@
 //
 
 #include "viewer.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 static int32_t global_inst_counter = 0;
 
@@ -49,7 +50,7 @@ void Viewer::Process_(SignalBus const &inputs, SignalBus &outputs)
         else {
             try {
                 if (!in1->empty()) {
-                    in1->copyTo(frame_);
+                    frame_ = std::move(*inputs.TakeMutable<cv::Mat>(0));
                     has_update_ = true;
                     last_input_update_ = std::chrono::steady_clock::now();
                 }
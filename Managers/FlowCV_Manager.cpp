@@ -3,18 +3,76 @@
 //
 
 #include "FlowCV_Manager.hpp"
+#include "FlowCV_JsonState.hpp"
+#include "Frame_Pool.hpp"
 #include "FlowLogger.hpp"
+#include "FusedChain/fused_chain.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
 
 namespace FlowCV
 {
 
-FlowCV_Manager::FlowCV_Manager()
+// The merge patch (RFC 7396) that json::merge_patch() applies to from to give to
+static nlohmann::json MergePatchDiff(const nlohmann::json &from, const nlohmann::json &to)
+{
+    if (!from.is_object() || !to.is_object())
+        return to;
+
+    nlohmann::json patch = nlohmann::json::object();
+    for (auto it = from.begin(); it != from.end(); ++it) {
+        if (!to.contains(it.key()))
+            patch[it.key()] = nullptr;
+    }
+    for (auto it = to.begin(); it != to.end(); ++it) {
+        auto from_value = from.find(it.key());
+        if (from_value == from.end())
+            patch[it.key()] = it.value();
+        else if (*from_value != it.value())
+            patch[it.key()] = MergePatchDiff(*from_value, it.value());
+    }
+
+    return patch;
+}
+
+static nlohmann::json HistogramToJson(const DSPatch::Component::Histogram &histogram)
+{
+    auto to_ms = [](std::chrono::nanoseconds ns) { return (double)ns.count() / 1.0e6; };
+
+    nlohmann::json j;
+    j["count"] = histogram.count;
+    j["mean_ms"] = to_ms(histogram.Mean());
+    j["p50_ms"] = to_ms(histogram.Percentile(50.0));
+    j["p90_ms"] = to_ms(histogram.Percentile(90.0));
+    j["p99_ms"] = to_ms(histogram.Percentile(99.0));
+    j["max_ms"] = to_ms(histogram.max);
+
+    return j;
+}
+
+FlowCV_Manager::FlowCV_Manager() : FlowCV_Manager(FlowCV_Resources())
+{
+}
+
+FlowCV_Manager::FlowCV_Manager(const FlowCV_Resources &resources)
 {
     id_counter_ = 1001;
     wire_id_counter_ = 500;
-    circuit_ = std::make_shared<DSPatch::Circuit>();
-    plugin_manager_ = std::make_shared<PluginManager>();
-    internal_node_manager_ = std::make_shared<InternalNodeManager>();
+    max_node_id_ = 0;
+    buffer_auto_tune_ = false;
+    target_fps_ = 30.0f;
+    tune_skip_sample_ = true;
+    tune_last_ticks_ = 0;
+    chain_fusion_ = true;
+    fusion_deferred_ = false;
+    circuit_ = std::make_shared<DSPatch::Circuit>(resources.thread_pool);
+    transaction_ = nullptr;
+    subgraphs_ = nlohmann::json::object();
+    plugin_manager_ = resources.plugin_manager;
+    internal_node_manager_ = resources.internal_node_manager;
 }
 
 FlowCV_Manager::~FlowCV_Manager()
@@ -27,10 +85,8 @@ uint64_t FlowCV_Manager::GetNextId()
 {
     uint64_t nextId = id_counter_;
 
-    for (const auto &node : nodes_) {
-        if (node.id >= nextId)
-            nextId = node.id + 1000;
-    }
+    if (max_node_id_ >= nextId)
+        nextId = max_node_id_ + 1000;
 
     id_counter_ = nextId;
 
@@ -64,13 +120,14 @@ uint64_t FlowCV_Manager::AddNewNodeInstance(const char *name, bool ext, uint64_t
             // GetNextId();
         }
 
-        int res = circuit_->AddComponent(ni.node_ptr);
-        if (res != -1)
-            ret_id = ni.id;
+        CircuitAdd(ni.node_ptr);
+        ret_id = ni.id;
 
         // Check Instance Count in case we have a loaded state causing a duplicate number
         CheckInstCountValue(ni);
 
+        max_node_id_ = std::max(max_node_id_, ni.id);
+        node_index_.emplace(ni.id, nodes_.size());
         nodes_.emplace_back(std::move(ni));
     }
 
@@ -100,17 +157,409 @@ int FlowCV_Manager::GetBufferCount()
     return circuit_->GetBufferCount();
 }
 
-void FlowCV_Manager::CheckInstCountValue(NodeInfo &ni)
+void FlowCV_Manager::SetBufferAutoTune(bool enable, float target_fps)
 {
-    int cur_num = ni.node_ptr->GetInstanceCount();
+    if (enable && !buffer_auto_tune_)
+        tune_skip_sample_ = true;
+    buffer_auto_tune_ = enable;
+    target_fps_ = target_fps > 0.0f ? target_fps : 30.0f;
+}
+
+void FlowCV_Manager::UpdateBufferAutoTune()
+{
+    if (!buffer_auto_tune_)
+        return;
+
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - tune_last_time_).count();
+    if (elapsed < 1.0 && !tune_skip_sample_)
+        return;
+
+    // Sample tick throughput and per-node process times since the last update
+    int64_t ticks = circuit_->GetTotalTicks() - tune_last_ticks_;
+    double stage_sum = 0.0;
+    double stage_max = 0.0;  // slowest in-order node
+    std::string slowest_node;
+    auto sample_stage = [&](const std::shared_ptr<DSPatch::Component> &component, ProcessSample &last_sample) {
+        ProcessSample cur_sample{component->GetTotalProcessCount(), component->GetTotalProcessTime().count()};
+        if (cur_sample.count > last_sample.count) {
+            double stage_time = (double)(cur_sample.time_ns - last_sample.time_ns) / (double)(cur_sample.count - last_sample.count) / 1.0e9;
+            stage_sum += stage_time;
+            if (component->GetProcessOrder() == DSPatch::Component::ProcessOrder::InOrder && stage_time > stage_max) {
+                stage_max = stage_time;
+                slowest_node = component->GetInstanceName();
+            }
+        }
+        last_sample = cur_sample;
+    };
+    // Fused nodes aren't processed themselves, their chain is
+    for (const auto &node : nodes_)
+        sample_stage(node.node_ptr, tune_samples_[node.id]);
+    for (auto &chain : fused_chains_)
+        sample_stage(chain.chain_ptr, chain.tune_sample);
+    tune_last_time_ = now;
+    tune_last_ticks_ += ticks;
+
+    // The first sample after enabling or changing the buffer count isn't representative
+    if (tune_skip_sample_) {
+        tune_skip_sample_ = false;
+        return;
+    }
+    if (ticks <= 0)
+        return;
+
+    double fps = (double)ticks / elapsed;
+    int cur_buffers = std::max(circuit_->GetBufferCount(), 1);
+    int max_buffers = std::max((int)std::thread::hardware_concurrency(), 2);
+
+    // Enough buffers for the flow's total process time to overlap at the target rate, but no more than the slowest
+    // node allows (an in-order node processes one buffer at a time, so it caps the rate no matter the buffer count)
+    int needed = (int)std::ceil(stage_sum * target_fps_);
+    if (stage_max > 0.0 && stage_max * target_fps_ > 1.0)
+        needed = std::min(needed, (int)std::ceil(stage_sum / stage_max));
+    needed = std::clamp(needed, 1, max_buffers);
+
+    int new_buffers = cur_buffers;
+    if (needed > cur_buffers && fps < target_fps_ * 0.95)
+        new_buffers = cur_buffers + 1;
+    else if (needed < cur_buffers)
+        new_buffers = cur_buffers - 1;
+
+    if (new_buffers != cur_buffers) {
+        LOG_INFO("Buffer Auto-Tune: {} -> {} Buffers ({:.1f} FPS, Target {:.1f} FPS, Slowest Node {} {:.2f} ms)", cur_buffers, new_buffers, fps,
+                 target_fps_, slowest_node, stage_max * 1000.0);
+        // A single buffer ticks on the auto-tick thread itself
+        circuit_->SetBufferCount(new_buffers > 1 ? new_buffers : 0);
+        tune_skip_sample_ = true;
+    }
+}
+
+void FlowCV_Manager::SetChainFusion(bool enable)
+{
+    if (enable == chain_fusion_)
+        return;
+
+    UnfuseChains();
+    chain_fusion_ = enable;
+    FuseChains();
+}
+
+bool FlowCV_Manager::GetChainFusion() const
+{
+    return chain_fusion_;
+}
+
+uint64_t FlowCV_Manager::GetFusedChainCount() const
+{
+    return (uint64_t)fused_chains_.size();
+}
+
+bool FlowCV_Manager::GetNodeMetrics(uint64_t id, DSPatch::Component::Metrics &metrics, int buffer)
+{
+    const NodeInfo *ni = GetNodeInfoPtrById(id);
+    if (ni == nullptr)
+        return false;
+
+    // A fused node is processed by its chain
+    std::shared_ptr<DSPatch::Component> component = ni->node_ptr;
+    for (const auto &chain : fused_chains_) {
+        if (std::find(chain.member_ids.begin(), chain.member_ids.end(), id) != chain.member_ids.end())
+            component = chain.chain_ptr;
+    }
+
+    metrics = buffer < 0 ? component->GetMetrics() : component->GetMetrics(buffer);
+
+    return true;
+}
+
+nlohmann::json FlowCV_Manager::GetMetrics()
+{
+    nlohmann::json j;
+    j["ticks"] = circuit_->GetTotalTicks();
+    j["buffers"] = circuit_->GetBufferCount();
+
+    auto poolStats = FramePool::Get().GetStats();
+    j["frame_pool"]["in_use_bytes"] = poolStats.in_use_bytes;
+    j["frame_pool"]["idle_bytes"] = poolStats.idle_bytes;
+    j["frame_pool"]["peak_bytes"] = poolStats.peak_bytes;
+    j["frame_pool"]["allocations"] = poolStats.allocations;
+    j["frame_pool"]["reuses"] = poolStats.reuses;
+
+    nlohmann::json nodes = nlohmann::json::array();
+    for (const auto &node : nodes_) {
+        DSPatch::Component::Metrics metrics;
+        GetNodeMetrics(node.id, metrics);
+        nlohmann::json n;
+        n["id"] = node.id;
+        n["name"] = node.node_ptr->GetInstanceName();
+        for (const auto &chain : fused_chains_) {
+            if (std::find(chain.member_ids.begin(), chain.member_ids.end(), node.id) != chain.member_ids.end())
+                n["fused_with"] = chain.member_ids;
+        }
+        n["ticks"] = metrics.tickCount;
+        n["reused"] = metrics.reuseCount;
+        n["dropped"] = metrics.dropCount;
+        n["process"] = HistogramToJson(metrics.processTime);
+        n["wait"] = HistogramToJson(metrics.waitTime);
+        n["sync"] = HistogramToJson(metrics.syncTime);
+        nodes.emplace_back(n);
+    }
+    j["nodes"] = nodes;
+
+    return j;
+}
+
+void FlowCV_Manager::ResetMetrics()
+{
+    for (const auto &node : nodes_)
+        node.node_ptr->ResetMetrics();
+    for (const auto &chain : fused_chains_)
+        chain.chain_ptr->ResetMetrics();
+}
+
+void FlowCV_Manager::StartTrace(int64_t max_events)
+{
+    circuit_->StartTrace(max_events);
+}
+
+void FlowCV_Manager::StopTrace()
+{
+    circuit_->StopTrace();
+}
+
+bool FlowCV_Manager::SaveTrace(const char *filepath)
+{
+    std::ofstream o(filepath);
+    if (!o.is_open())
+        return false;
+
+    circuit_->WriteTrace(o);
+    o.close();
+    if (circuit_->IsTraceTruncated())
+        LOG_WARN("Trace {} was truncated: it reached its event limit before tracing was stopped", filepath);
+    return !o.fail();
+}
+
+void FlowCV_Manager::FuseChains()
+{
+    if (!chain_fusion_ || fusion_deferred_ || !fused_chains_.empty())
+        return;
+
+    std::unordered_map<uint64_t, size_t> node_index;
+    for (size_t i = 0; i < nodes_.size(); i++)
+        node_index[nodes_.at(i).id] = i;
+
+    std::unordered_map<uint64_t, int> out_wire_count;
+    for (const auto &wire : wiring_)
+        out_wire_count[wire.from.id]++;
+
+    // A chain processes every tick, so an OnChange node (which skips ticks whose inputs haven't changed) stays out of it
+    auto is_element_wise = [&](uint64_t id) {
+        auto index = node_index.find(id);
+        if (index == node_index.end())
+            return false;
+        const auto &node = nodes_.at(index->second);
+        return node.desc.output_count == 1 && node.node_ptr->GetQueuePolicy() == DSPatch::Component::QueuePolicy::Block &&
+               node.node_ptr->GetEvaluationMode() == DSPatch::Component::EvaluationMode::Always &&
+               dynamic_cast<DSPatch::DSPatchables::ElementWise *>(node.node_ptr.get()) != nullptr;
+    };
+
+    // Link each element-wise node to the element-wise node its output solely feeds. A node takes at most one link in (from
+    // whichever node feeds its lowest input), hence links form linear chains.
+    std::unordered_map<uint64_t, const Wire *> link_in;
+    std::unordered_map<uint64_t, const Wire *> link_out;
+    for (const auto &wire : wiring_) {
+        if (wire.from.id == wire.to.id || out_wire_count[wire.from.id] != 1 || !is_element_wise(wire.from.id) || !is_element_wise(wire.to.id))
+            continue;
+        auto link = link_in.find(wire.to.id);
+        if (link == link_in.end() || wire.to.index < link->second->to.index)
+            link_in[wire.to.id] = &wire;
+    }
+    for (const auto &link : link_in)
+        link_out[link.second->from.id] = link.second;
+
+    // Every chain starts at a node linked out but not in
     for (const auto &node : nodes_) {
-        if (ni.desc.name == node.desc.name && ni.id != node.id) {
-            if (cur_num <= node.node_ptr->GetInstanceCount()) {
-                cur_num = node.node_ptr->GetInstanceCount() + 1;
+        if (link_in.count(node.id) != 0 || link_out.count(node.id) == 0)
+            continue;
+        FusedChainInfo chain;
+        std::vector<int> chained_inputs;
+        for (uint64_t id = node.id;;) {
+            chained_inputs.emplace_back(chain.member_ids.empty() ? -1 : (int)link_in.at(id)->to.index);
+            chain.member_ids.emplace_back(id);
+            chain.members.emplace_back(nodes_.at(node_index.at(id)).node_ptr);
+            auto link = link_out.find(id);
+            if (link == link_out.end())
+                break;
+            id = link->second->to.id;
+        }
+        chain.chain_ptr = std::make_shared<DSPatch::DSPatchables::FusedChain>(chain.members, chained_inputs);
+        fused_chains_.emplace_back(std::move(chain));
+    }
+
+    if (fused_chains_.empty())
+        return;
+
+    // Wire up the chains before taking their members out, so that the circuit keeps ticking a complete flow
+    for (const auto &chain : fused_chains_)
+        CircuitAdd(chain.chain_ptr);
+    RewireFusedChains(true);
+    for (const auto &chain : fused_chains_) {
+        for (const auto &member : chain.members)
+            CircuitRemove(member);
+    }
+    LOG_DEBUG("Fused {} Chains Of Element-Wise Nodes", fused_chains_.size());
+}
+
+void FlowCV_Manager::UnfuseChains()
+{
+    if (fused_chains_.empty())
+        return;
+
+    for (const auto &chain : fused_chains_) {
+        for (const auto &member : chain.members)
+            CircuitAdd(member);
+    }
+    RewireFusedChains(false);
+    for (const auto &chain : fused_chains_)
+        CircuitRemove(chain.chain_ptr);
+    fused_chains_.clear();
+}
+
+void FlowCV_Manager::RewireFusedChains(bool fused)
+{
+    // Chain and position within it of each fused node
+    std::unordered_map<uint64_t, std::pair<size_t, size_t>> chain_member;
+    for (size_t c = 0; c < fused_chains_.size(); c++) {
+        for (size_t m = 0; m < fused_chains_.at(c).member_ids.size(); m++)
+            chain_member[fused_chains_.at(c).member_ids.at(m)] = {c, m};
+    }
+
+    for (const auto &wire : wiring_) {
+        auto from = chain_member.find(wire.from.id);
+        auto to = chain_member.find(wire.to.id);
+        if (from == chain_member.end() && to == chain_member.end())
+            continue;
+
+        std::shared_ptr<DSPatch::Component> from_ptr = nodes_.at(GetNodeIndexFromId(wire.from.id)).node_ptr;
+        std::shared_ptr<DSPatch::Component> to_ptr = nodes_.at(GetNodeIndexFromId(wire.to.id)).node_ptr;
+        int from_index = (int)wire.from.index;
+        int to_index = (int)wire.to.index;
+        if (fused) {
+            if (to != chain_member.end()) {
+                auto chain = std::static_pointer_cast<DSPatch::DSPatchables::FusedChain>(fused_chains_.at(to->second.first).chain_ptr);
+                to_index = chain->GetFusedInput(to->second.second, to_index);
+                if (to_index == -1)
+                    continue;  // links one member to the next within the chain
+                to_ptr = chain;
+            }
+            if (from != chain_member.end()) {
+                from_ptr = fused_chains_.at(from->second.first).chain_ptr;
+                from_index = 0;
             }
         }
+        CircuitConnect(from_ptr, from_index, to_ptr, to_index);
     }
+}
+
+void FlowCV_Manager::CircuitAdd(const std::shared_ptr<DSPatch::Component> &component)
+{
+    if (transaction_ != nullptr)
+        transaction_->AddComponent(component);
+    else
+        circuit_->AddComponent(component);
+}
+
+void FlowCV_Manager::CircuitRemove(const std::shared_ptr<DSPatch::Component> &component)
+{
+    if (transaction_ != nullptr)
+        transaction_->RemoveComponent(component);
+    else
+        circuit_->RemoveComponent(component);
+}
+
+bool FlowCV_Manager::CircuitConnect(const std::shared_ptr<DSPatch::Component> &from, int from_index, const std::shared_ptr<DSPatch::Component> &to, int to_index)
+{
+    if (transaction_ == nullptr)
+        return circuit_->ConnectOutToIn(from, from_index, to, to_index);
+
+    // A staged wire is only validated when the transaction is committed, where one bad wire would fail the whole flow, so
+    // leave out any wire that would fail the same check here instead
+    if (!DSPatch::Circuit::CanConnectOutToIn(from, from_index, to, to_index))
+        return false;
+
+    transaction_->ConnectOutToIn(from, from_index, to, to_index);
+    return true;
+}
+
+void FlowCV_Manager::CheckInstCountValue(NodeInfo &ni)
+{
+    // Keep the node's own count unless another node of the same name has it (or a higher one), then follow the highest
+    UnregisterInstCount(ni);
+    auto &counts = inst_counts_[ni.desc.name];
+    int cur_num = ni.node_ptr->GetInstanceCount();
+    if (!counts.empty() && *counts.rbegin() >= cur_num)
+        cur_num = *counts.rbegin() + 1;
     ni.node_ptr->SetInstanceCount(cur_num);
+    counts.insert(cur_num);
+    node_inst_count_[ni.id] = cur_num;
+}
+
+void FlowCV_Manager::UnregisterInstCount(const NodeInfo &ni)
+{
+    auto registered = node_inst_count_.find(ni.id);
+    if (registered == node_inst_count_.end())
+        return;
+
+    auto &counts = inst_counts_[ni.desc.name];
+    auto count = counts.find(registered->second);
+    if (count != counts.end())
+        counts.erase(count);
+    node_inst_count_.erase(registered);
+}
+
+void FlowCV_Manager::ReindexNodes(size_t from)
+{
+    for (size_t i = from; i < nodes_.size(); i++)
+        node_index_[nodes_.at(i).id] = i;
+}
+
+void FlowCV_Manager::AddWire(const Wire &wire)
+{
+    wire_index_[wire.id] = wiring_.size();
+    wiring_.emplace_back(wire);
+    node_wires_[wire.to.id].emplace_back(wire.id);
+    node_wires_[wire.from.id].emplace_back(wire.id);
+}
+
+void FlowCV_Manager::RemoveWires(const std::vector<uint64_t> &wire_ids)
+{
+    std::unordered_set<uint64_t> removed;
+    for (uint64_t wire_id : wire_ids) {
+        auto index = wire_index_.find(wire_id);
+        if (index == wire_index_.end() || !removed.insert(wire_id).second)
+            continue;
+        const Wire &wire = wiring_.at(index->second);
+        auto from_instance = node_instance_.find(wire.from.id);
+        auto to_instance = node_instance_.find(wire.to.id);
+        if (from_instance != node_instance_.end() && to_instance != node_instance_.end() && from_instance->second == to_instance->second)
+            DetachSubgraphInstance(wire.from.id);
+        for (uint64_t node_id : {wire.to.id, wire.from.id}) {
+            auto wires = node_wires_.find(node_id);
+            if (wires == node_wires_.end())
+                continue;
+            wires->second.erase(std::remove(wires->second.begin(), wires->second.end(), wire_id), wires->second.end());
+            if (wires->second.empty())
+                node_wires_.erase(wires);
+        }
+    }
+    if (removed.empty())
+        return;
+
+    wiring_.erase(std::remove_if(wiring_.begin(), wiring_.end(), [&](const Wire &wire) { return removed.count(wire.id) != 0; }), wiring_.end());
+    wire_index_.clear();
+    for (size_t i = 0; i < wiring_.size(); i++)
+        wire_index_[wiring_.at(i).id] = i;
 }
 
 uint64_t FlowCV_Manager::GetNodeCount()
@@ -143,14 +592,29 @@ bool FlowCV_Manager::GetNodeInfoById(uint64_t id, NodeInfo &nInfo)
     return GetNodeInfoByIndex(GetNodeIndexFromId(id), nInfo);
 }
 
+const NodeInfo *FlowCV_Manager::GetNodeInfoPtrByIndex(uint64_t index) const
+{
+    if (index < nodes_.size())
+        return &nodes_.at(index);
+
+    return nullptr;
+}
+
+const NodeInfo *FlowCV_Manager::GetNodeInfoPtrById(uint64_t id) const
+{
+    auto index = node_index_.find(id);
+    if (index != node_index_.end())
+        return &nodes_.at(index->second);
+
+    return nullptr;
+}
+
 int FlowCV_Manager::GetNodeIndexFromId(uint64_t id)
 {
+    auto index = node_index_.find(id);
+    if (index != node_index_.end())
+        return (int)index->second;
 
-    for (int i = 0; i < nodes_.size(); i++) {
-        if (nodes_.at(i).id == id) {
-            return i;
-        }
-    }
     return 0;
 }
 
@@ -169,22 +633,85 @@ nlohmann::json FlowCV_Manager::GetState()
     json nodes;
     json connections;
 
-    for (const auto &node : nodes_) {
+    auto nodeJson = [](const NodeInfo &node) {
         json n;
         n["name"] = node.desc.name;
         n["id"] = node.id;
         n["num"] = node.node_ptr->GetInstanceCount();
         n["enabled"] = node.node_ptr->IsEnabled();
-        std::string state_str = node.node_ptr->GetState();
-        if (!state_str.empty()) {
-            json node_state = json::parse(state_str);
-            n["params"] = node_state;
+        switch (node.node_ptr->GetQueuePolicy()) {
+            case DSPatch::Component::QueuePolicy::LatestOnly:
+                n["queue_policy"] = "latest";
+                break;
+            case DSPatch::Component::QueuePolicy::DropOldest:
+                n["queue_policy"] = "drop_oldest";
+                n["queue_size"] = node.node_ptr->GetQueueSize();
+                break;
+            default:
+                break;
         }
-        nodes.push_back(n);
+        json node_state = GetNodeState(*node.node_ptr);
+        if (!node_state.is_discarded())
+            n["params"] = std::move(node_state);
+        return n;
+    };
+
+    // Nodes of a subgraph instance are saved with the instance, as differences to the subgraph's definition
+    for (const auto &node : nodes_) {
+        if (node_instance_.count(node.id) == 0)
+            nodes.push_back(nodeJson(node));
     }
     state["nodes"] = nodes;
 
+    if (!instances_.empty()) {
+        json subgraphs = subgraphs_;
+        json instances = json::array();
+        std::set<std::string> saved;
+        for (const auto &instance : instances_) {
+            json &definition = subgraphs[instance.subgraph];
+            // The first instance of each subgraph becomes its definition, so files hold one full copy of every node's
+            // params however many instances there are
+            bool first = saved.insert(instance.subgraph).second;
+            json ids = json::object();
+            json overrides = json::object();
+            if (!definition.contains("nodes"))
+                definition["nodes"] = json::array();
+            for (auto &def_node : definition["nodes"]) {
+                auto sub_id = def_node["id"].get<uint64_t>();
+                auto node_id = instance.node_ids.find(sub_id);
+                if (node_id == instance.node_ids.end())
+                    continue;
+                std::string key = std::to_string(sub_id);
+                ids[key] = node_id->second;
+                json n = nodeJson(nodes_.at(node_index_.at(node_id->second)));
+                n.erase("num");
+                n["id"] = sub_id;
+                if (first) {
+                    def_node = std::move(n);
+                    continue;
+                }
+                json patch = MergePatchDiff(def_node, n);
+                if (!patch.empty())
+                    overrides[key] = std::move(patch);
+            }
+            json inst;
+            inst["subgraph"] = instance.subgraph;
+            inst["name"] = instance.name;
+            inst["ids"] = ids;
+            if (!overrides.empty())
+                inst["nodes"] = overrides;
+            instances.push_back(std::move(inst));
+        }
+        state["subgraphs"] = subgraphs;
+        state["instances"] = instances;
+    }
+
+    // Wires within an instance are saved with the subgraph's definition
     for (const auto &wire : wiring_) {
+        auto from_instance = node_instance_.find(wire.from.id);
+        auto to_instance = node_instance_.find(wire.to.id);
+        if (from_instance != node_instance_.end() && to_instance != node_instance_.end() && from_instance->second == to_instance->second)
+            continue;
         json w;
         w["from_id"] = wire.from.id;
         w["from_idx"] = wire.from.index;
@@ -197,52 +724,190 @@ nlohmann::json FlowCV_Manager::GetState()
     return std::move(state);
 }
 
-bool FlowCV_Manager::SetState(nlohmann::json &state)
+uint64_t FlowCV_Manager::AddNodeFromState(nlohmann::json &node, uint64_t id)
 {
+    auto name = node["name"].get<std::string>();
+    bool enabled = true;
+    if (node.contains("enabled"))
+        enabled = node["enabled"].get<bool>();
+    auto queue_policy = DSPatch::Component::QueuePolicy::Block;
+    int queue_size = 1;
+    if (node.contains("queue_policy")) {
+        auto policy = node["queue_policy"].get<std::string>();
+        if (policy == "latest")
+            queue_policy = DSPatch::Component::QueuePolicy::LatestOnly;
+        else if (policy == "drop_oldest")
+            queue_policy = DSPatch::Component::QueuePolicy::DropOldest;
+        else if (policy != "block")
+            LOG_WARN("Unknown Queue Policy: {} for Node {}, Using block", policy, name);
+    }
+    if (node.contains("queue_size"))
+        queue_size = node["queue_size"].get<int>();
+    bool ext = plugin_manager_->HasPlugin(name.c_str());
+    if (!ext && !internal_node_manager_->HasNode(name.c_str())) {
+        LOG_DEBUG("Node Name: {} Not Found", name);
+        return 0;
+    }
+
+    auto index = node_index_.find(AddNewNodeInstance(name.c_str(), ext, id));
+    if (index == node_index_.end())
+        return 0;
+
+    NodeInfo &ni = nodes_.at(index->second);
+    if (node.contains("num"))
+        ni.node_ptr->SetInstanceCount(node["num"].get<uint32_t>());
+    ni.node_ptr->SetEnabled(enabled);
+    ni.node_ptr->SetQueuePolicy(queue_policy, queue_size);
+    CheckInstCountValue(ni);
+    LOG_DEBUG("Adding Node Instance ({}): {}, {}", ext ? "Plugin" : "Internal", name, ni.id);
+    if (node.contains("params")) {
+        SetNodeState(*ni.node_ptr, std::move(node["params"]));
+    }
+
+    return ni.id;
+}
+
+bool FlowCV_Manager::AddSubgraphInstance(const nlohmann::json &instance)
+{
+    auto subgraph = instance["subgraph"].get<std::string>();
+    if (!subgraphs_.contains(subgraph)) {
+        LOG_WARN("Subgraph Not Found: {}", subgraph);
+        return false;
+    }
+
     bool res = true;
+    const auto &definition = subgraphs_[subgraph];
+    SubgraphInstance inst;
+    inst.subgraph = subgraph;
+    inst.name = instance.contains("name") ? instance["name"].get<std::string>() : subgraph;
+
+    // Each node is the definition's, patched with the instance's differences, under the instance's own id
+    if (definition.contains("nodes")) {
+        for (const auto &def_node : definition["nodes"]) {
+            auto sub_id = def_node["id"].get<uint64_t>();
+            std::string key = std::to_string(sub_id);
+            nlohmann::json node = def_node;
+            if (instance.contains("nodes") && instance["nodes"].contains(key))
+                node.merge_patch(instance["nodes"][key]);
+            uint64_t id = 0;
+            if (instance.contains("ids") && instance["ids"].contains(key))
+                id = instance["ids"][key].get<uint64_t>();
+            if (id == 0 || node_index_.count(id) != 0)
+                id = GetNextId();
+            id = AddNodeFromState(node, id);
+            if (id == 0) {
+                res = false;
+                continue;
+            }
+            inst.node_ids[sub_id] = id;
+        }
+    }
+
+    size_t instance_index = instances_.size();
+    for (const auto &ids : inst.node_ids)
+        node_instance_[ids.second] = instance_index;
+    instances_.emplace_back(std::move(inst));
+    const auto &node_ids = instances_.back().node_ids;
+
+    auto connect = [this](const nlohmann::json &conn, uint64_t from_id, uint64_t to_id) {
+        auto from_idx = conn["from_idx"].get<uint32_t>();
+        auto to_idx = conn["to_idx"].get<uint32_t>();
+        if (ConnectNodes(from_id, from_idx, to_id, to_idx))
+            return true;
+        LOG_WARN("Failed To Connect Node {} Output {} To Node {} Input {}", from_id, from_idx, to_id, to_idx);
+        return false;
+    };
+
+    if (definition.contains("connections")) {
+        for (const auto &conn : definition["connections"]) {
+            auto from_id = node_ids.find(conn["from_id"].get<uint64_t>());
+            auto to_id = node_ids.find(conn["to_id"].get<uint64_t>());
+            if (from_id == node_ids.end() || to_id == node_ids.end() || !connect(conn, from_id->second, to_id->second))
+                res = false;
+        }
+    }
+
+    // Connections to the rest of the flow, ids not of the subgraph's nodes are the flow's own
+    if (instance.contains("connections")) {
+        for (const auto &conn : instance["connections"]) {
+            auto from_id = conn["from_id"].get<uint64_t>();
+            auto to_id = conn["to_id"].get<uint64_t>();
+            auto from_node = node_ids.find(from_id);
+            auto to_node = node_ids.find(to_id);
+            if (from_node != node_ids.end() && to_node != node_ids.end()) {
+                LOG_WARN("Subgraph Instance {} Connections Must Be To The Rest Of The Flow, Use The Subgraph's Own Connections", instances_.back().name);
+                res = false;
+                continue;
+            }
+            if (!connect(conn, from_node != node_ids.end() ? from_node->second : from_id, to_node != node_ids.end() ? to_node->second : to_id))
+                res = false;
+        }
+    }
+
+    return res;
+}
+
+void FlowCV_Manager::DetachSubgraphInstance(uint64_t node_id)
+{
+    // The instance's nodes stay as they are, they just become nodes of the flow in their own right
+    auto node_instance = node_instance_.find(node_id);
+    if (node_instance == node_instance_.end())
+        return;
+
+    size_t instance_index = node_instance->second;
+    for (const auto &ids : instances_.at(instance_index).node_ids)
+        node_instance_.erase(ids.second);
+    instances_.erase(instances_.begin() + (ptrdiff_t)instance_index);
+    for (auto &other : node_instance_) {
+        if (other.second > instance_index)
+            other.second--;
+    }
+}
+
+uint64_t FlowCV_Manager::GetSubgraphInstanceCount() const
+{
+    return instances_.size();
+}
+
+FlowCV_Manager::FlowRefs FlowCV_Manager::FlowMembers()
+{
+    return std::tie(nodes_, wiring_, max_node_id_, node_index_, wire_index_, node_wires_, inst_counts_, node_inst_count_, tune_samples_,
+                    fused_chains_, subgraphs_, instances_, node_instance_);
+}
+
+bool FlowCV_Manager::SetState(nlohmann::json &state, std::string *error)
+{
+    bool res = true;
+
+    // Fuse the loaded flow once, rather than after every connection
+    fusion_deferred_ = true;
+
+    // Stage the whole flow (replacing the current one) and apply it to the circuit in one step, so a running circuit goes
+    // straight from ticking the old flow to ticking the new one
+    DSPatch::CircuitTransaction transaction;
+    transaction_ = &transaction;
+
+    // Should the circuit reject the new flow, it carries on ticking the current one, so set the current one aside to put back
+    auto previous_flow = std::apply([](auto &...members) { return std::make_tuple(std::move(members)...); }, FlowMembers());
 
     try {
 
         NewState();
 
         if (state.contains("nodes")) {
-            for (const auto &node : state["nodes"]) {
-                auto id = node["id"].get<uint64_t>();
-                auto name = node["name"].get<std::string>();
-                auto inst_num = node["num"].get<uint32_t>();
-                bool enabled = true;
-                if (node.contains("enabled"))
-                    enabled = node["enabled"].get<bool>();
-                if (plugin_manager_->HasPlugin(name.c_str())) {
-                    uint64_t new_node_id = AddNewNodeInstance(name.c_str(), true, id);
-                    NodeInfo ni;
-                    GetNodeInfoById(new_node_id, ni);
-                    ni.node_ptr->SetInstanceCount(inst_num);
-                    ni.node_ptr->SetEnabled(enabled);
-                    CheckInstCountValue(ni);
-                    LOG_DEBUG("Adding Node Instance (Plugin): {}, {}", name, id);
-                    if (node.contains("params")) {
-                        ni.node_ptr->SetState(node["params"].dump());
-                    }
-                }
-                else {
-                    if (internal_node_manager_->HasNode(name.c_str())) {
-                        uint64_t new_node_id = AddNewNodeInstance(name.c_str(), false, id);
-                        NodeInfo ni;
-                        GetNodeInfoById(new_node_id, ni);
-                        ni.node_ptr->SetInstanceCount(inst_num);
-                        ni.node_ptr->SetEnabled(enabled);
-                        CheckInstCountValue(ni);
-                        LOG_DEBUG("Adding Node Instance (Plugin): {}, {}", name, id);
-                        if (node.contains("params")) {
-                            ni.node_ptr->SetState(node["params"].dump());
-                        }
-                    }
-                    else {
-                        LOG_DEBUG("Node Name: {} Not Found", name);
-                        res = false;
-                    }
-                }
+            for (auto &node : state["nodes"]) {
+                if (AddNodeFromState(node, node["id"].get<uint64_t>()) == 0)
+                    res = false;
+            }
+        }
+
+        // Every instance's nodes join the one circuit, so the scheduler runs instances alongside each other
+        if (state.contains("subgraphs"))
+            subgraphs_ = state["subgraphs"];
+        if (state.contains("instances")) {
+            for (const auto &instance : state["instances"]) {
+                if (!AddSubgraphInstance(instance))
+                    res = false;
             }
         }
 
@@ -252,12 +917,28 @@ bool FlowCV_Manager::SetState(nlohmann::json &state)
                 auto to_idx = conn["to_idx"].get<uint32_t>();
                 auto from_id = conn["from_id"].get<uint64_t>();
                 auto from_idx = conn["from_idx"].get<uint32_t>();
-                ConnectNodes(from_id, from_idx, to_id, to_idx);
+                if (!ConnectNodes(from_id, from_idx, to_id, to_idx)) {
+                    LOG_WARN("Failed To Connect Node {} Output {} To Node {} Input {}", from_id, from_idx, to_id, to_idx);
+                    res = false;
+                }
             }
         }
     }
     catch (const std::exception &e) {
         std::cerr << e.what();
+        res = false;
+    }
+
+    fusion_deferred_ = false;
+    FuseChains();
+
+    transaction_ = nullptr;
+    std::string commit_error;
+    if (!circuit_->Commit(transaction, &commit_error)) {
+        LOG_ERROR("Failed To Apply Flow State: {}", commit_error);
+        FlowMembers() = std::move(previous_flow);
+        if (error != nullptr)
+            *error = commit_error;
         return false;
     }
 
@@ -266,20 +947,60 @@ bool FlowCV_Manager::SetState(nlohmann::json &state)
 
 void FlowCV_Manager::NewState()
 {
-    circuit_->RemoveAllComponents();
+    if (transaction_ != nullptr)
+        transaction_->RemoveAllComponents();
+    else
+        circuit_->RemoveAllComponents();
+    fused_chains_.clear();
     wiring_.clear();
     nodes_.clear();
+    tune_samples_.clear();
+    max_node_id_ = 0;
+    node_index_.clear();
+    wire_index_.clear();
+    node_wires_.clear();
+    inst_counts_.clear();
+    node_inst_count_.clear();
+    subgraphs_ = nlohmann::json::object();
+    instances_.clear();
+    node_instance_.clear();
+}
+
+bool FlowCV_Manager::LoadState(const char *filepath, std::string *error)
+{
+    nlohmann::json state;
+    if (!ReadFlowFile(filepath, state)) {
+        if (error != nullptr)
+            *error = std::string("Failed to read ") + filepath;
+        return false;
+    }
+
+    return SetState(state, error);
 }
 
-bool FlowCV_Manager::LoadState(const char *filepath)
+bool FlowCV_Manager::SaveState(const char *filepath, FlowFileFormat format)
+{
+    return WriteFlowFile(filepath, GetState(), format);
+}
+
+bool FlowCV_Manager::ReadFlowFile(const char *filepath, nlohmann::json &state)
 {
     try {
-        std::fstream i(filepath);
-        nlohmann::json state;
-        i >> state;
+        std::ifstream i(filepath, std::ios::binary);
+        if (!i.is_open()) {
+            std::cerr << "Failed to open " << filepath << std::endl;
+            return false;
+        }
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(i)), std::istreambuf_iterator<char>());
         i.close();
 
-        return SetState(state);
+        // A JSON flow starts with '{' (after any whitespace), a CBOR one with a map header (major type 5)
+        if (!data.empty() && (data[0] & 0xE0) == 0xA0)
+            state = nlohmann::json::from_cbor(data);
+        else
+            state = nlohmann::json::parse(data.begin(), data.end());
+
+        return true;
     }
     catch (const std::exception &e) {
         std::cerr << e.what();
@@ -288,13 +1009,19 @@ bool FlowCV_Manager::LoadState(const char *filepath)
     return false;
 }
 
-bool FlowCV_Manager::SaveState(const char *filepath)
+bool FlowCV_Manager::WriteFlowFile(const char *filepath, const nlohmann::json &state, FlowFileFormat format)
 {
     try {
-        nlohmann::json state = GetState();
-        std::ofstream o(filepath);
-        o << std::setw(4) << state << std::endl;
-        o.close();
+        if (format == FlowFileFormat::Cbor) {
+            std::ofstream o(filepath, std::ios::binary);
+            nlohmann::json::to_cbor(state, o);
+            o.close();
+        }
+        else {
+            std::ofstream o(filepath);
+            o << std::setw(4) << state << std::endl;
+            o.close();
+        }
         return true;
     }
     catch (const std::exception &e) {
@@ -304,6 +1031,27 @@ bool FlowCV_Manager::SaveState(const char *filepath)
     return false;
 }
 
+nlohmann::json FlowCV_Manager::GetNodeState(DSPatch::Component &node)
+{
+    if (auto *jsonState = dynamic_cast<JsonState *>(&node))
+        return jsonState->GetStateJson();
+
+    // Nodes without state return an empty string, which is left out of the flow
+    std::string stateStr = node.GetState();
+    if (stateStr.empty())
+        return nlohmann::json::value_t::discarded;
+
+    return nlohmann::json::parse(stateStr);
+}
+
+void FlowCV_Manager::SetNodeState(DSPatch::Component &node, nlohmann::json &&params)
+{
+    if (auto *jsonState = dynamic_cast<JsonState *>(&node))
+        jsonState->SetStateJson(std::move(params));
+    else
+        node.SetState(params.dump());
+}
+
 bool FlowCV_Manager::NodeHasUI(uint64_t index, GuiInterfaceType interface)
 {
     if (index >= 0 && index < nodes_.size()) {
@@ -340,11 +1088,19 @@ bool FlowCV_Manager::ConnectNodes(uint64_t from_id, uint32_t from_out_idx, uint6
 {
     bool res = false;
 
-    uint64_t from_index = GetNodeIndexFromId(from_id);
-    uint64_t to_index = GetNodeIndexFromId(to_id);
-
-    if (from_id != 0 && to_id != 0) {
-        res = circuit_->ConnectOutToIn(nodes_.at(from_index).node_ptr, from_out_idx, nodes_.at(to_index).node_ptr, to_in_idx);
+    auto from_node = node_index_.find(from_id);
+    auto to_node = node_index_.find(to_id);
+
+    if (from_node != node_index_.end() && to_node != node_index_.end()) {
+        size_t from_index = from_node->second;
+        size_t to_index = to_node->second;
+        // Rewiring an instance within itself (other than while loading it) sets it apart from its subgraph
+        auto from_instance = node_instance_.find(from_id);
+        auto to_instance = node_instance_.find(to_id);
+        if (transaction_ == nullptr && from_instance != node_instance_.end() && to_instance != node_instance_.end() && from_instance->second == to_instance->second)
+            DetachSubgraphInstance(from_id);
+        UnfuseChains();
+        res = CircuitConnect(nodes_.at(from_index).node_ptr, (int)from_out_idx, nodes_.at(to_index).node_ptr, (int)to_in_idx);
         if (res) {
             nodes_.at(to_index).input_conn_map.at(to_in_idx).id = from_id;
             nodes_.at(to_index).input_conn_map.at(to_in_idx).index = from_out_idx;
@@ -355,8 +1111,9 @@ bool FlowCV_Manager::ConnectNodes(uint64_t from_id, uint32_t from_out_idx, uint6
             w.to.index = to_in_idx;
             w.id = wire_id_counter_;
             wire_id_counter_ += 500;
-            wiring_.emplace_back(w);
+            AddWire(w);
         }
+        FuseChains();
     }
 
     return res;
@@ -364,12 +1121,17 @@ bool FlowCV_Manager::ConnectNodes(uint64_t from_id, uint32_t from_out_idx, uint6
 
 bool FlowCV_Manager::DisconnectNodes(uint64_t from_id, uint32_t from_out_idx, uint64_t to_id, uint32_t to_in_idx)
 {
-    for (int i = 0; i < wiring_.size(); i++) {
-        if (wiring_.at(i).from.id == from_id && wiring_.at(i).from.index == from_out_idx && wiring_.at(i).to.id == to_id &&
-            wiring_.at(i).to.index == to_in_idx) {
-            wiring_.erase(wiring_.begin() + i);
-            uint64_t node_idx = GetNodeIndexFromId(to_id);
-            nodes_.at(node_idx).node_ptr->DisconnectInput((int)to_in_idx);
+    auto wires = node_wires_.find(to_id);
+    if (wires == node_wires_.end())
+        return false;
+
+    for (uint64_t wire_id : wires->second) {
+        const Wire &wire = wiring_.at(wire_index_.at(wire_id));
+        if (wire.from.id == from_id && wire.from.index == from_out_idx && wire.to.id == to_id && wire.to.index == to_in_idx) {
+            UnfuseChains();
+            RemoveWires({wire_id});
+            circuit_->DisconnectInput(nodes_.at(GetNodeIndexFromId(to_id)).node_ptr, (int)to_in_idx);
+            FuseChains();
             return true;
         }
     }
@@ -379,22 +1141,19 @@ bool FlowCV_Manager::DisconnectNodes(uint64_t from_id, uint32_t from_out_idx, ui
 
 bool FlowCV_Manager::DisconnectNodeInput(uint64_t node_id, uint32_t in_index)
 {
-    int node_idx = GetNodeIndexFromId(node_id);
-    NodeInfo ni;
-    if (GetNodeInfoById(node_id, ni)) {
-        if (node_id != 0 && in_index >= 0 && in_index < ni.desc.input_count) {
-            auto it = wiring_.begin();
-            while (it != wiring_.end()) {
-                if (it->to.id == node_id && it->to.index == in_index) {
-                    it = wiring_.erase(it);
-                    circuit_->PauseAutoTick();
-                    nodes_.at(node_idx).node_ptr->DisconnectInput((int)in_index);
-                    circuit_->ResumeAutoTick();
-                    return true;
-                }
-                else
-                    ++it;
-            }
+    const NodeInfo *ni = GetNodeInfoPtrById(node_id);
+    auto wires = node_wires_.find(node_id);
+    if (node_id == 0 || ni == nullptr || (int)in_index >= ni->desc.input_count || wires == node_wires_.end())
+        return false;
+
+    for (uint64_t wire_id : wires->second) {
+        const Wire &wire = wiring_.at(wire_index_.at(wire_id));
+        if (wire.to.id == node_id && wire.to.index == in_index) {
+            UnfuseChains();
+            RemoveWires({wire_id});
+            circuit_->DisconnectInput(ni->node_ptr, (int)in_index);
+            FuseChains();
+            return true;
         }
     }
 
@@ -405,20 +1164,23 @@ bool FlowCV_Manager::RemoveNodeInstance(uint64_t node_id)
 {
     bool res = false;
 
-    int node_idx = GetNodeIndexFromId(node_id);
-    if (node_id != 0 && node_idx < nodes_.size()) {
+    auto index = node_index_.find(node_id);
+    if (node_id != 0 && index != node_index_.end()) {
+        size_t node_idx = index->second;
+        DetachSubgraphInstance(node_id);
+        UnfuseChains();
         circuit_->DisconnectComponent(nodes_.at(node_idx).node_ptr);
         circuit_->RemoveComponent(nodes_.at(node_idx).node_ptr);
-        // Find Wires
-        auto it = wiring_.begin();
-        while (it != wiring_.end()) {
-            if (it->to.id == node_id || it->from.id == node_id) {
-                it = wiring_.erase(it);
-            }
-            else
-                ++it;
-        }
-        nodes_.erase(nodes_.begin() + node_idx);
+        // Remove Wires (copied, as removing them edits the node's list)
+        auto wires = node_wires_.find(node_id);
+        if (wires != node_wires_.end())
+            RemoveWires(std::vector<uint64_t>(wires->second));
+        UnregisterInstCount(nodes_.at(node_idx));
+        node_index_.erase(index);
+        nodes_.erase(nodes_.begin() + (ptrdiff_t)node_idx);
+        ReindexNodes(node_idx);
+        tune_samples_.erase(node_id);
+        FuseChains();
         res = true;
     }
 
@@ -440,19 +1202,58 @@ void FlowCV_Manager::StopAutoTick()
     circuit_->StopAutoTick();
 }
 
+void FlowCV_Manager::SetAutoTickMode(DSPatch::Circuit::AutoTickMode mode, double tick_rate)
+{
+    circuit_->SetAutoTickMode(mode, tick_rate);
+}
+
+bool FlowCV_Manager::CanEndStream() const
+{
+    return circuit_->CanEndStream();
+}
+
+bool FlowCV_Manager::IsEndOfStream() const
+{
+    return circuit_->IsEndOfStream();
+}
+
+int64_t FlowCV_Manager::GetStreamFrameCount() const
+{
+    int64_t frames = 0;
+    for (const auto &node : nodes_) {
+        if (node.node_ptr->IsFiniteSource())
+            frames = std::max(frames, node.node_ptr->GetTotalOutputCount());
+    }
+
+    return frames;
+}
+
+std::vector<std::string> FlowCV_Manager::GetStreamErrors() const
+{
+    std::vector<std::string> errors;
+    for (const auto &node : nodes_) {
+        auto error = node.node_ptr->GetStreamError();
+        if (!error.empty())
+            errors.emplace_back(std::string(node.node_ptr->GetInstanceName()) + ": " + error);
+    }
+
+    return errors;
+}
+
+void FlowCV_Manager::Flush()
+{
+    circuit_->Flush();
+}
+
 std::vector<Wire> FlowCV_Manager::GetNodeConnectionsFromIndex(uint64_t index)
 {
     std::vector<Wire> connections;
-    if (index >= 0 && index < nodes_.size()) {
-        NodeInfo ni;
-        if (GetNodeInfoByIndex(index, ni)) {
-            for (const auto &wire : wiring_) {
-                if (wire.to.id == ni.id)
-                    connections.emplace_back(wire);
-
-                if (wire.from.id == ni.id)
-                    connections.emplace_back(wire);
-            }
+    if (index < nodes_.size()) {
+        auto wires = node_wires_.find(nodes_.at(index).id);
+        if (wires != node_wires_.end()) {
+            connections.reserve(wires->second.size());
+            for (uint64_t wire_id : wires->second)
+                connections.emplace_back(wiring_.at(wire_index_.at(wire_id)));
         }
     }
 
@@ -496,11 +1297,10 @@ uint64_t FlowCV_Manager::GetWireIdFromIndex(uint64_t index)
 
 void FlowCV_Manager::RemoveWireById(uint64_t id)
 {
-    for (auto &wire : wiring_) {
-        if (wire.id == id) {
-            DisconnectNodeInput(wire.to.id, wire.to.index);
-            return;
-        }
+    auto index = wire_index_.find(id);
+    if (index != wire_index_.end()) {
+        const Wire &wire = wiring_.at(index->second);
+        DisconnectNodeInput(wire.to.id, wire.to.index);
     }
 }
 
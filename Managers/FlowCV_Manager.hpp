@@ -4,6 +4,7 @@
 
 #ifndef FLOWCV_MANAGER_HPP_
 #define FLOWCV_MANAGER_HPP_
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -11,6 +12,10 @@
 #include "Internal_Node_Manager.hpp"
 #include "Plugin_Manager.hpp"
 #include "json.hpp"
+#include <map>
+#include <set>
+#include <tuple>
+#include <unordered_map>
 
 namespace FlowCV
 {
@@ -30,6 +35,12 @@ struct NodeInfo
     NodeDescription desc;
 };
 
+struct ProcessSample
+{
+    int64_t count = 0;
+    int64_t time_ns = 0;
+};
+
 struct Wire
 {
     uint64_t id{};
@@ -37,10 +48,45 @@ struct Wire
     IoInfo to;
 };
 
+struct FusedChainInfo
+{
+    std::shared_ptr<DSPatch::Component> chain_ptr;
+    std::vector<std::shared_ptr<DSPatch::Component>> members;
+    std::vector<uint64_t> member_ids;
+    ProcessSample tune_sample;
+};
+
+// A copy of a subgraph (nodes and connections defined once in the flow's "subgraphs") placed in the flow, E.g. one per
+// camera. Its nodes are ordinary nodes of the flow, the instance only records where they came from so that the flow is
+// saved as the definition plus each instance's differences to it.
+struct SubgraphInstance
+{
+    std::string name;
+    std::string subgraph;
+    std::map<uint64_t, uint64_t> node_ids;  // subgraph node id -> node id in the flow
+};
+
+// A flow file is a JSON document, saved as text or, for faster loading, as binary CBOR
+enum class FlowFileFormat
+{
+    Json,
+    Cbor
+};
+
+// Loaded plugins, internal nodes and the thread pool nodes are ticked on. Built once and passed to each manager, for
+// running several flows in one process.
+struct FlowCV_Resources
+{
+    std::shared_ptr<PluginManager> plugin_manager = std::make_shared<PluginManager>();
+    std::shared_ptr<InternalNodeManager> internal_node_manager = std::make_shared<InternalNodeManager>();
+    std::shared_ptr<DSPatch::internal::ThreadPool> thread_pool = DSPatch::Circuit::NewThreadPool();
+};
+
 class FlowCV_Manager
 {
   public:
     FlowCV_Manager();
+    explicit FlowCV_Manager(const FlowCV_Resources &resources);
     ~FlowCV_Manager();
     uint64_t CreateNewNodeInstance(const char *name);
     void SetBufferCount(uint32_t num_buffers);
@@ -48,13 +94,24 @@ class FlowCV_Manager
     uint64_t GetNodeCount();
     bool GetNodeInfoByIndex(uint64_t index, NodeInfo &nInfo);
     bool GetNodeInfoById(uint64_t id, NodeInfo &nInfo);
+    // Non-copying lookups, valid until the next node is added or removed (nullptr if not found)
+    const NodeInfo *GetNodeInfoPtrByIndex(uint64_t index) const;
+    const NodeInfo *GetNodeInfoPtrById(uint64_t id) const;
     int GetNodeIndexFromId(uint64_t id);
     uint64_t GetNodeIdFromIndex(uint64_t index);
     nlohmann::json GetState();
     void NewState();
-    bool SetState(nlohmann::json &state);
-    bool LoadState(const char *filepath);
-    bool SaveState(const char *filepath);
+    // If the flow can't be applied, the current flow is kept (and error, if given, says why). Nodes' params are moved out
+    // of state, into the nodes.
+    bool SetState(nlohmann::json &state, std::string *error = nullptr);
+    bool LoadState(const char *filepath, std::string *error = nullptr);
+    bool SaveState(const char *filepath, FlowFileFormat format = FlowFileFormat::Json);
+    // Read either format, telling them apart by content
+    static bool ReadFlowFile(const char *filepath, nlohmann::json &state);
+    static bool WriteFlowFile(const char *filepath, const nlohmann::json &state, FlowFileFormat format);
+    // Node params, handed over as parsed JSON to nodes that implement JsonState
+    static nlohmann::json GetNodeState(DSPatch::Component &node);
+    static void SetNodeState(DSPatch::Component &node, nlohmann::json &&params);
     bool NodeHasUI(uint64_t index, GuiInterfaceType interface);
     void SetShowUI(uint64_t index, bool show);
     bool *GetShowUiPtr(uint64_t index);
@@ -74,17 +131,77 @@ class FlowCV_Manager
     void Tick(DSPatch::Component::TickMode mode = DSPatch::Component::TickMode::Parallel);
     void StartAutoTick(DSPatch::Component::TickMode mode = DSPatch::Component::TickMode::Parallel);
     void StopAutoTick();
+    void SetAutoTickMode(DSPatch::Circuit::AutoTickMode mode, double tick_rate = 30.0);
+    bool CanEndStream() const;
+    bool IsEndOfStream() const;
+    // Frames output by the flow's finite sources (by whichever has output the most), and their errors as "node: error"
+    int64_t GetStreamFrameCount() const;
+    std::vector<std::string> GetStreamErrors() const;
+    void Flush();
+    void SetBufferAutoTune(bool enable, float target_fps = 30.0f);
+    void UpdateBufferAutoTune();
+    void SetChainFusion(bool enable);
+    bool GetChainFusion() const;
+    uint64_t GetFusedChainCount() const;
+    uint64_t GetSubgraphInstanceCount() const;
+    bool GetNodeMetrics(uint64_t id, DSPatch::Component::Metrics &metrics, int buffer = -1);
+    nlohmann::json GetMetrics();
+    void ResetMetrics();
+    void StartTrace(int64_t max_events = 1000000);
+    void StopTrace();
+    bool SaveTrace(const char *filepath);
 
   protected:
     uint64_t AddNewNodeInstance(const char *name, bool ext = false, uint64_t id = 0);
     uint64_t GetNextId();
+    void FuseChains();
+    void UnfuseChains();
+    void RewireFusedChains(bool fused);
+    void ReindexNodes(size_t from);
+    void AddWire(const Wire &wire);
+    void RemoveWires(const std::vector<uint64_t> &wire_ids);
+    void UnregisterInstCount(const NodeInfo &ni);
+    // Circuit edits, staged in the open transaction (while loading a flow) rather than applied one by one
+    void CircuitAdd(const std::shared_ptr<DSPatch::Component> &component);
+    void CircuitRemove(const std::shared_ptr<DSPatch::Component> &component);
+    bool CircuitConnect(const std::shared_ptr<DSPatch::Component> &from, int from_index, const std::shared_ptr<DSPatch::Component> &to, int to_index);
+    uint64_t AddNodeFromState(nlohmann::json &node, uint64_t id);
+    bool AddSubgraphInstance(const nlohmann::json &instance);
+    void DetachSubgraphInstance(uint64_t node_id);
+    // The members that make up the current flow, for setting it aside while another is staged
+    using FlowRefs = std::tuple<std::vector<NodeInfo> &, std::vector<Wire> &, uint64_t &, std::unordered_map<uint64_t, size_t> &,
+                                std::unordered_map<uint64_t, size_t> &, std::unordered_map<uint64_t, std::vector<uint64_t>> &,
+                                std::unordered_map<std::string, std::multiset<int>> &, std::unordered_map<uint64_t, int> &,
+                                std::unordered_map<uint64_t, ProcessSample> &, std::vector<FusedChainInfo> &, nlohmann::json &,
+                                std::vector<SubgraphInstance> &, std::unordered_map<uint64_t, size_t> &>;
+    FlowRefs FlowMembers();
 
   private:
     uint64_t id_counter_;
     uint64_t wire_id_counter_;
     std::vector<NodeInfo> nodes_;
     std::vector<Wire> wiring_;
+    // Indices kept alongside nodes_ and wiring_, so that large flows don't need scanning on every lookup
+    uint64_t max_node_id_;
+    std::unordered_map<uint64_t, size_t> node_index_;                 // node id -> index in nodes_
+    std::unordered_map<uint64_t, size_t> wire_index_;                 // wire id -> index in wiring_
+    std::unordered_map<uint64_t, std::vector<uint64_t>> node_wires_;  // node id -> ids of wires to and from it, in wiring order
+    std::unordered_map<std::string, std::multiset<int>> inst_counts_;  // node name -> instance counts in use
+    std::unordered_map<uint64_t, int> node_inst_count_;              // node id -> its instance count in inst_counts_
     std::shared_ptr<DSPatch::Circuit> circuit_;
+    DSPatch::CircuitTransaction *transaction_;
+    bool buffer_auto_tune_;
+    float target_fps_;
+    bool tune_skip_sample_;
+    std::chrono::steady_clock::time_point tune_last_time_;
+    int64_t tune_last_ticks_;
+    std::unordered_map<uint64_t, ProcessSample> tune_samples_;
+    bool chain_fusion_;
+    bool fusion_deferred_;
+    std::vector<FusedChainInfo> fused_chains_;
+    nlohmann::json subgraphs_;                            // subgraph name -> definition, as loaded
+    std::vector<SubgraphInstance> instances_;
+    std::unordered_map<uint64_t, size_t> node_instance_;  // node id -> index in instances_
 
   public:
     std::shared_ptr<PluginManager> plugin_manager_;
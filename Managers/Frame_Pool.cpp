@@ -0,0 +1,177 @@
+//
+// FlowCV Frame Buffer Pool
+//
+
+#include "Frame_Pool.hpp"
+#include <algorithm>
+
+namespace FlowCV
+{
+
+FramePool &FramePool::Get()
+{
+    // Never destroyed, as Mats allocated from the pool may well be released during static destruction
+    static auto *pool = new FramePool();
+    return *pool;
+}
+
+void FramePool::Install()
+{
+    static std::once_flag installed;
+    std::call_once(installed, [] { cv::Mat::setDefaultAllocator(&Get()); });
+}
+
+void FramePool::SetMaxIdleBytes(size_t max_idle_bytes)
+{
+    max_idle_bytes_ = max_idle_bytes;
+    EvictIdle();
+}
+
+FramePool::Stats FramePool::GetStats() const
+{
+    Stats stats;
+    stats.in_use_bytes = in_use_bytes_;
+    stats.idle_bytes = idle_bytes_;
+    stats.peak_bytes = peak_bytes_;
+    stats.allocations = allocations_;
+    stats.reuses = reuses_;
+    return stats;
+}
+
+void FramePool::Trim()
+{
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto &bucket : shard.idle) {
+            for (auto buffer : bucket.second.buffers)
+                cv::fastFree(buffer);
+            idle_bytes_ -= (int64_t)(bucket.first * bucket.second.buffers.size());
+        }
+        shard.idle.clear();
+    }
+}
+
+cv::UMatData *FramePool::allocate(int dims, const int *sizes, int type, void *data, size_t *step, cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const
+{
+    // Laid out contiguously, as OpenCV's own allocator would
+    size_t total = CV_ELEM_SIZE(type);
+    for (int i = dims - 1; i >= 0; i--)
+        total *= sizes[i];
+
+    if (data != nullptr || total < minPooledBytes)
+        return cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+
+    if (step != nullptr) {
+        size_t stepBytes = CV_ELEM_SIZE(type);
+        for (int i = dims - 1; i >= 0; i--) {
+            step[i] = stepBytes;
+            stepBytes *= sizes[i];
+        }
+    }
+
+    void *buffer = nullptr;
+    {
+        auto &shard = ShardFor(total);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto bucket = shard.idle.find(total);
+        if (bucket != shard.idle.end() && !bucket->second.buffers.empty()) {
+            buffer = bucket->second.buffers.back();
+            bucket->second.buffers.pop_back();
+            bucket->second.last_used = ++use_count_;
+            idle_bytes_ -= (int64_t)total;
+        }
+    }
+
+    if (buffer == nullptr) {
+        buffer = cv::fastMalloc(total);
+        allocations_++;
+    }
+    else {
+        reuses_++;
+    }
+
+    int64_t held = (in_use_bytes_ += (int64_t)total) + idle_bytes_;
+    int64_t peak = peak_bytes_;
+    while (held > peak && !peak_bytes_.compare_exchange_weak(peak, held)) {
+    }
+
+    auto *u = new cv::UMatData(this);
+    u->data = u->origdata = (uchar *)buffer;
+    u->size = total;
+    return u;
+}
+
+bool FramePool::allocate(cv::UMatData *data, cv::AccessFlag accessflags, cv::UMatUsageFlags usageFlags) const
+{
+    return data != nullptr;
+}
+
+void FramePool::deallocate(cv::UMatData *data) const
+{
+    if (data == nullptr)
+        return;
+
+    CV_Assert(data->urefcount == 0);
+    CV_Assert(data->refcount == 0);
+
+    {
+        auto &shard = ShardFor(data->size);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto &bucket = shard.idle[data->size];
+        bucket.buffers.emplace_back(data->origdata);
+        bucket.last_used = ++use_count_;
+    }
+    in_use_bytes_ -= (int64_t)data->size;
+    idle_bytes_ += (int64_t)data->size;
+
+    if (idle_bytes_ > (int64_t)max_idle_bytes_)
+        EvictIdle();
+
+    delete data;
+}
+
+FramePool::Shard &FramePool::ShardFor(size_t bytes) const
+{
+    // Frame sizes tend to share their low bits (E.g. multiples of a row size), so mix them all into the shard number
+    return shards_[(bytes * 0x9E3779B97F4A7C15ull) >> 60];
+}
+
+void FramePool::EvictIdle() const
+{
+    std::unique_lock<std::mutex> evictLock(evict_mutex_, std::try_to_lock);
+    if (!evictLock.owns_lock())
+        return;
+
+    auto lowWater = (int64_t)(max_idle_bytes_ / 4 * 3);
+    if (idle_bytes_ <= (int64_t)max_idle_bytes_)
+        return;
+
+    // Free the least recently used sizes first, as those are the least likely to be asked for again
+    std::vector<std::pair<uint64_t, size_t>> bySize;
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto &bucket : shard.idle) {
+            if (!bucket.second.buffers.empty())
+                bySize.emplace_back(bucket.second.last_used, bucket.first);
+        }
+    }
+    std::sort(bySize.begin(), bySize.end());
+
+    for (const auto &size : bySize) {
+        if (idle_bytes_ <= lowWater)
+            break;
+
+        auto &shard = ShardFor(size.second);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto bucket = shard.idle.find(size.second);
+        while (bucket != shard.idle.end() && !bucket->second.buffers.empty() && idle_bytes_ > lowWater) {
+            cv::fastFree(bucket->second.buffers.back());
+            bucket->second.buffers.pop_back();
+            idle_bytes_ -= (int64_t)size.second;
+        }
+        if (bucket != shard.idle.end() && bucket->second.buffers.empty())
+            shard.idle.erase(bucket);
+    }
+}
+
+}  // End Namespace FlowCV
@@ -0,0 +1,85 @@
+//
+// FlowCV Frame Buffer Pool
+//
+
+#ifndef FLOWCV_FRAME_POOL_HPP_
+#define FLOWCV_FRAME_POOL_HPP_
+#include <opencv2/core.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace FlowCV
+{
+
+// cv::Mat allocator that recycles large buffers. Nodes allocate a new output frame on every tick, which at high
+// resolutions and frame rates means a large malloc/free (and fresh page faults) per node per tick. Once installed as
+// the default cv::Mat allocator, a released frame's buffer is kept idle and handed to the next Mat of the same byte
+// size instead, so a pipeline in its steady state makes no large allocations at all.
+//
+// Applications install the pool once on startup via Install(), before loading any flow. Buffers under minPooledBytes,
+// and Mats over user data, are left to OpenCV's own allocator. Idle buffers are capped at SetMaxIdleBytes(): once
+// over the cap, the least recently used sizes are freed (E.g. after a change of resolution) down to 3/4 of the cap in
+// one pass, so that a pool at its cap doesn't search for a buffer to free on every release. Idle buffers are sharded
+// by byte size, each shard with its own lock, so that nodes releasing frames of different sizes don't contend.
+class FramePool final : public cv::MatAllocator
+{
+  public:
+    struct Stats
+    {
+        int64_t in_use_bytes{};  // pooled buffers held by Mats
+        int64_t idle_bytes{};    // pooled buffers waiting to be reused
+        int64_t peak_bytes{};    // highest in_use_bytes + idle_bytes
+        int64_t allocations{};   // buffers newly allocated
+        int64_t reuses{};        // buffers handed out again
+    };
+
+    static constexpr size_t minPooledBytes = 64 * 1024;
+
+    // The process wide pool, which outlives every Mat allocated from it
+    static FramePool &Get();
+    static void Install();
+
+    void SetMaxIdleBytes(size_t max_idle_bytes);
+    [[nodiscard]] Stats GetStats() const;
+    void Trim();
+
+    cv::UMatData *allocate(int dims, const int *sizes, int type, void *data, size_t *step, cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override;
+    bool allocate(cv::UMatData *data, cv::AccessFlag accessflags, cv::UMatUsageFlags usageFlags) const override;
+    void deallocate(cv::UMatData *data) const override;
+
+  private:
+    static constexpr int shardCount = 16;
+
+    struct Bucket
+    {
+        std::vector<void *> buffers;
+        uint64_t last_used{};
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<size_t, Bucket> idle;  // idle buffers by byte size
+    };
+
+    FramePool() = default;
+    Shard &ShardFor(size_t bytes) const;
+    void EvictIdle() const;
+
+    mutable std::array<Shard, shardCount> shards_;
+    mutable std::mutex evict_mutex_;  // held by whichever thread is evicting, others leave it to that thread
+    mutable std::atomic<uint64_t> use_count_{};
+    mutable std::atomic<int64_t> in_use_bytes_{};
+    mutable std::atomic<int64_t> idle_bytes_{};
+    mutable std::atomic<int64_t> peak_bytes_{};
+    mutable std::atomic<int64_t> allocations_{};
+    mutable std::atomic<int64_t> reuses_{};
+    std::atomic<size_t> max_idle_bytes_{512 * 1024 * 1024};
+};
+
+}  // End Namespace FlowCV
+#endif  // FLOWCV_FRAME_POOL_HPP_
@@ -5,6 +5,9 @@
 #ifndef FLOWCV_INTERNAL_NODE_MANAGER_HPP_
 #define FLOWCV_INTERNAL_NODE_MANAGER_HPP_
 #include <iostream>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
 
@@ -23,8 +26,14 @@ class InternalNodeManager
     bool HasNode(const char *name);
 
   protected:
+    bool DescribeNode(uint32_t index, NodeDescription &nodeDesc);
+
   private:
+    // Descriptions are filled in on first use, node_list_ is in the registry's (name) order
     std::vector<NodeDescription> node_list_;
+    std::vector<bool> node_described_;
+    std::mutex describe_mutex_;
+    std::unordered_map<std::string_view, uint32_t> node_index_;  // node name -> index in node_list_
 };
 }  // End Namespace FlowCV
 #endif  // FLOWCV_INTERNAL_NODE_MANAGER_HPP_
@@ -16,7 +16,7 @@ class CsvFile
 };
 }  // namespace DSPatch::DSPatchables::internal
 
-CsvFile::CsvFile() : Component(ProcessOrder::OutOfOrder), p(new internal::CsvFile())
+CsvFile::CsvFile() : FlowCV::JsonState(ProcessOrder::InOrder), p(new internal::CsvFile())
 {
     // Name and Category
     SetComponentName_("CSV_File");
@@ -129,6 +129,12 @@ void CsvFile::OpenCsvFile(nlohmann::json &json_data)
     }
 }
 
+void CsvFile::Flush_()
+{
+    if (csv_file_.is_open())
+        csv_file_.flush();
+}
+
 void CsvFile::Process_(SignalBus const &inputs, SignalBus &outputs)
 {
     auto in1 = inputs.GetValue<bool>(0);
@@ -309,7 +315,7 @@ void CsvFile::UpdateGui(void *context, int interface)
     }
 }
 
-std::string CsvFile::GetState()
+nlohmann::json CsvFile::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -323,17 +329,13 @@ std::string CsvFile::GetState()
     state["rotating_files"] = rotating_files_;
     state["num_files"] = num_files_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void CsvFile::SetState(std::string &&json_serialized)
+void CsvFile::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("save_timestamp"))
         save_timestamp_ = state["save_timestamp"].get<bool>();
     if (state.contains("save_counter"))
@@ -6,6 +6,7 @@
 #define FLOWCV_PLUGIN_CSV_FILE_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
@@ -21,20 +22,21 @@ namespace internal
 class CsvFile;
 }
 
-class DLLEXPORT CsvFile final : public Component
+class DLLEXPORT CsvFile final : public FlowCV::JsonState
 {
   public:
     CsvFile();
     ~CsvFile() override;
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
     void OpenCsvFile(nlohmann::json &json_data);
     std::string GetRotateFilePath();
+    void Flush_() override;
 
   private:
     std::unique_ptr<internal::CsvFile> p;
@@ -16,7 +16,7 @@ class OscSend
 };
 }  // namespace DSPatch::DSPatchables::internal
 
-OscSend::OscSend() : Component(ProcessOrder::OutOfOrder), p(new internal::OscSend())
+OscSend::OscSend() : FlowCV::JsonState(ProcessOrder::OutOfOrder), p(new internal::OscSend())
 {
     // Name and Category
     SetComponentName_("OSC_Send");
@@ -256,7 +256,7 @@ void OscSend::UpdateGui(void *context, int interface)
     }
 }
 
-std::string OscSend::GetState()
+nlohmann::json OscSend::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -266,17 +266,13 @@ std::string OscSend::GetState()
     state["port"] = port_;
     state["data_rate"] = transmit_rate_;
     state["osc_addr"] = osc_addr_prefix_;
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void OscSend::SetState(std::string &&json_serialized)
+void OscSend::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("ip_addr")) {
         ip_addr_ = state["ip_addr"].get<std::string>();
         strcpy(tmp_ip_buf, ip_addr_.c_str());
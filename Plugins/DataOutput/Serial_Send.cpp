@@ -16,7 +16,7 @@ class SerialSend
 };
 }  // namespace DSPatch::DSPatchables::internal
 
-SerialSend::SerialSend() : Component(ProcessOrder::OutOfOrder), p(new internal::SerialSend())
+SerialSend::SerialSend() : FlowCV::JsonState(ProcessOrder::OutOfOrder), p(new internal::SerialSend())
 {
     // Name and Category
     SetComponentName_("Serial_Send");
@@ -325,7 +325,7 @@ void SerialSend::UpdateGui(void *context, int interface)
     }
 }
 
-std::string SerialSend::GetState()
+nlohmann::json SerialSend::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -343,17 +343,13 @@ std::string SerialSend::GetState()
     state["eol_seq"] = eol_seq_index_;
     state["send_binary"] = send_as_binary_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void SerialSend::SetState(std::string &&json_serialized)
+void SerialSend::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     std::string portStr;
     if (state.contains("port_str"))
         portStr = state["port_str"].get<std::string>();
@@ -6,6 +6,7 @@
 #define FLOWCV_PLUGIN_SERIAL_SEND_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
@@ -19,14 +20,14 @@ namespace internal
 class SerialSend;
 }
 
-class DLLEXPORT SerialSend final : public Component
+class DLLEXPORT SerialSend final : public FlowCV::JsonState
 {
   public:
     SerialSend();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
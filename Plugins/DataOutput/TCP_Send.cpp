@@ -16,7 +16,7 @@ class TcpSend
 };
 }  // namespace DSPatch::DSPatchables::internal
 
-TcpSend::TcpSend() : Component(ProcessOrder::OutOfOrder), p(new internal::TcpSend())
+TcpSend::TcpSend() : FlowCV::JsonState(ProcessOrder::OutOfOrder), p(new internal::TcpSend())
 {
     // Name and Category
     SetComponentName_("TCP_Send");
@@ -261,7 +261,7 @@ void TcpSend::UpdateGui(void *context, int interface)
     }
 }
 
-std::string TcpSend::GetState()
+nlohmann::json TcpSend::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -274,17 +274,13 @@ std::string TcpSend::GetState()
     state["eol_seq"] = eol_seq_index_;
     state["send_binary"] = send_as_binary_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void TcpSend::SetState(std::string &&json_serialized)
+void TcpSend::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("ip_addr")) {
         ip_addr_ = state["ip_addr"].get<std::string>();
         strcpy(tmp_ip_buf, ip_addr_.c_str());
@@ -16,7 +16,7 @@ class UdpSend
 };
 }  // namespace DSPatch::DSPatchables::internal
 
-UdpSend::UdpSend() : Component(ProcessOrder::OutOfOrder), p(new internal::UdpSend())
+UdpSend::UdpSend() : FlowCV::JsonState(ProcessOrder::OutOfOrder), p(new internal::UdpSend())
 {
     // Name and Category
     SetComponentName_("UDP_Send");
@@ -263,7 +263,7 @@ void UdpSend::UpdateGui(void *context, int interface)
     }
 }
 
-std::string UdpSend::GetState()
+nlohmann::json UdpSend::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -276,17 +276,13 @@ std::string UdpSend::GetState()
     state["eol_seq"] = eol_seq_index_;
     state["send_binary"] = send_as_binary_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void UdpSend::SetState(std::string &&json_serialized)
+void UdpSend::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("ip_addr")) {
         ip_addr_ = state["ip_addr"].get<std::string>();
         strcpy(tmp_ip_buf, ip_addr_.c_str());
@@ -16,7 +16,7 @@ class ImageLoader
 };
 }  // namespace DSPatch::DSPatchables::internal
 
-ImageLoader::ImageLoader() : Component(ProcessOrder::InOrder), p(new internal::ImageLoader())
+ImageLoader::ImageLoader() : FlowCV::JsonState(ProcessOrder::InOrder), p(new internal::ImageLoader())
 {
     // Name and Category
     SetComponentName_("Image_Loader");
@@ -38,6 +38,7 @@ ImageLoader::ImageLoader() : Component(ProcessOrder::InOrder), p(new internal::I
     last_time_ = std::chrono::steady_clock::now();
     fps_time_ = (1.0f / (float)fps_) * 1000.0f;
 
+    SetEvaluationMode(EvaluationMode::OnChange);
     SetEnabled(true);
 }
 
@@ -48,16 +49,17 @@ void ImageLoader::Process_(SignalBus const &inputs, SignalBus &outputs)
 
     if (io_mutex_.try_lock()) {  // Try lock so other threads will skip if locked instead of waiting
         if (!frame_.empty()) {
-            bool should_wait = true;
-            while (should_wait) {
-                std::chrono::steady_clock::time_point current_time_ = std::chrono::steady_clock::now();
-                auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(current_time_ - last_time_).count();
-                if (delta >= (uint32_t)fps_time_)
-                    should_wait = false;
+            // Sleep (or request a tick) until the next frame is due instead of spinning
+            if (!PaceTick_(last_time_, std::chrono::microseconds((int64_t)(fps_time_ * 1000.0f)))) {
+                io_mutex_.unlock();
+                return;
+            }
+            // Re-emit the last frame unless a new image has been loaded since
+            if (frame_changed_ || !ReuseOutputs_(outputs)) {
+                outputs.SetValue(0, frame_);
+                frame_changed_ = false;
             }
-            outputs.SetValue(0, frame_);
         }
-        last_time_ = std::chrono::steady_clock::now();
         io_mutex_.unlock();
     }
 }
@@ -94,6 +96,7 @@ void ImageLoader::UpdateGui(void *context, int interface)
             std::lock_guard<std::mutex> lk(io_mutex_);
             image_file_ = file_dialog_.selected_path;
             frame_ = cv::imread(image_file_, true);
+            frame_changed_ = true;
             show_file_dialog_ = false;
         }
         ImGui::SetNextItemWidth(80);
@@ -105,7 +108,7 @@ void ImageLoader::UpdateGui(void *context, int interface)
     }
 }
 
-std::string ImageLoader::GetState()
+nlohmann::json ImageLoader::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -115,22 +118,19 @@ std::string ImageLoader::GetState()
     state["fps"] = fps_;
     state["fps_index"] = fps_index_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void ImageLoader::SetState(std::string &&json_serialized)
+void ImageLoader::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("image_path")) {
         if (!state["image_path"].empty()) {
             std::lock_guard<std::mutex> lk(io_mutex_);
             image_file_ = state["image_path"].get<std::string>();
             frame_ = cv::imread(image_file_, true);
+            frame_changed_ = true;
         }
     }
     if (state.contains("fps"))
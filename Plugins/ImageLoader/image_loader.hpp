@@ -6,6 +6,7 @@
 #define FLOWCV_IMAGE_LOADER_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
@@ -18,14 +19,14 @@ namespace internal
 class ImageLoader;
 }
 
-class DLLEXPORT ImageLoader final : public Component
+class DLLEXPORT ImageLoader final : public FlowCV::JsonState
 {
   public:
     ImageLoader();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
@@ -33,6 +34,7 @@ class DLLEXPORT ImageLoader final : public Component
   private:
     std::unique_ptr<internal::ImageLoader> p;
     cv::Mat frame_;
+    bool frame_changed_{};
     bool show_file_dialog_;
     std::string image_file_;
     imgui_addons::ImGuiFileBrowser file_dialog_;
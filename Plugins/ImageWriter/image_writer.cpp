@@ -17,7 +17,7 @@ class ImageWriter
 };
 }  // namespace DSPatch::DSPatchables::internal
 
-ImageWriter::ImageWriter() : Component(ProcessOrder::OutOfOrder), p(new internal::ImageWriter())
+ImageWriter::ImageWriter() : FlowCV::JsonState(ProcessOrder::OutOfOrder), p(new internal::ImageWriter())
 {
     // Name and Category
     SetComponentName_("Image_Writer");
@@ -107,20 +107,17 @@ void ImageWriter::UpdateGui(void *context, int interface)
     }
 }
 
-std::string ImageWriter::GetState()
+nlohmann::json ImageWriter::GetStateJson()
 {
     using namespace nlohmann;
 
     json state;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void ImageWriter::SetState(std::string &&json_serialized)
+void ImageWriter::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
 }
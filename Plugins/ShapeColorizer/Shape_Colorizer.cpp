@@ -3,6 +3,7 @@
 //
 
 #include "Shape_Colorizer.hpp"
+#include "FlowCV_MatSignal.hpp"
 #include <math.h>
 
 using namespace DSPatch;
@@ -96,7 +97,7 @@ class ShapeColorizer
 };
 }  // namespace DSPatch::DSPatchables::internal
 
-ShapeColorizer::ShapeColorizer() : Component(ProcessOrder::OutOfOrder), p(new internal::ShapeColorizer())
+ShapeColorizer::ShapeColorizer() : FlowCV::JsonState(ProcessOrder::OutOfOrder), p(new internal::ShapeColorizer())
 {
     // Name and Category
     SetComponentName_("Shape_Colorizer");
@@ -158,7 +159,7 @@ void ShapeColorizer::Process_(SignalBus const &inputs, SignalBus &outputs)
         }
         else {
             cv::Mat frame;
-            in1->copyTo(frame);
+            frame = std::move(*inputs.TakeMutable<cv::Mat>(0));
             cv::Mat matFrame(h, w, CV_8UC3, cv::Scalar(0, 0, 0));
 
             if (!json_data_.empty()) {
@@ -367,7 +368,7 @@ void ShapeColorizer::UpdateGui(void *context, int interface)
     }
 }
 
-std::string ShapeColorizer::GetState()
+nlohmann::json ShapeColorizer::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -393,17 +394,13 @@ std::string ShapeColorizer::GetState()
     if (!colorList.empty())
         state["color_match"] = colorList;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void ShapeColorizer::SetState(std::string &&json_serialized)
+void ShapeColorizer::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("overlay"))
         overlay_ = state["overlay"].get<bool>();
     if (state.contains("ignore_none"))
@@ -3,6 +3,7 @@
 //
 
 #include "Shape_Counter.hpp"
+#include "FlowCV_MatSignal.hpp"
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -16,7 +17,7 @@ class ShapeCounter
 };
 }  // namespace DSPatch::DSPatchables::internal
 
-ShapeCounter::ShapeCounter() : Component(ProcessOrder::OutOfOrder), p(new internal::ShapeCounter())
+ShapeCounter::ShapeCounter() : FlowCV::JsonState(ProcessOrder::OutOfOrder), p(new internal::ShapeCounter())
 {
     // Name and Category
     SetComponentName_("Shape_Counter");
@@ -61,7 +62,7 @@ void ShapeCounter::Process_(SignalBus const &inputs, SignalBus &outputs)
 
             json_data = *in2;
             // Process Image
-            in1->copyTo(frame);
+            frame = std::move(*inputs.TakeMutable<cv::Mat>(0));
 
             nlohmann::json json_out;
             nlohmann::json data;
@@ -270,7 +271,7 @@ void ShapeCounter::UpdateGui(void *context, int interface)
     }
 }
 
-std::string ShapeCounter::GetState()
+nlohmann::json ShapeCounter::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -294,17 +295,13 @@ std::string ShapeCounter::GetState()
     tColor["A"] = text_color_.w;
     state["color"] = tColor;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void ShapeCounter::SetState(std::string &&json_serialized)
+void ShapeCounter::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("size_match"))
         size_match_ = state["size_match"].get<int>();
     if (state.contains("size_thresh"))
@@ -0,0 +1,147 @@
+//
+// Plugin ShmReceive
+//
+
+#include "SHM_Receive.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace DSPatch;
+using namespace DSPatchables;
+
+int32_t global_inst_counter = 0;
+
+namespace DSPatch::DSPatchables::internal
+{
+class ShmReceive
+{
+};
+}  // namespace DSPatch::DSPatchables::internal
+
+ShmReceive::ShmReceive() : FlowCV::JsonState(ProcessOrder::InOrder), p(new internal::ShmReceive())
+{
+    // Name and Category
+    SetComponentName_("SHM_Receive");
+    SetComponentCategory_(Category::Category_Source);
+    SetComponentAuthor_("Richard");
+    SetComponentVersion_("0.1.0");
+    SetInstanceCount(global_inst_counter);
+    global_inst_counter++;
+
+    // 0 inputs
+    SetInputCount_(0);
+
+    // 1 outputs
+    SetOutputCount_(1, {"out"}, {IoType::Io_Type_CvMat});
+
+    latest_only_ = true;
+    reopen_ = false;
+    received_count_ = 0;
+    torn_count_ = 0;
+
+    SetEnabled(true);
+}
+
+void ShmReceive::Process_(SignalBus const &inputs, SignalBus &outputs)
+{
+    if (!IsEnabled())
+        return;
+
+    std::lock_guard<std::mutex> lk(io_mutex_);
+    if (reopen_ || (ring_ != nullptr && ring_->IsStale())) {
+        ring_.reset();
+        reopen_ = false;
+    }
+
+    if (ring_ == nullptr)
+        ring_ = FlowCV::ShmFrameRing::Open(channel_);
+
+    if (ring_ == nullptr) {
+        // Retry opening the channel in a while, the sender may not have created it yet
+        RequestTick_(std::chrono::steady_clock::now() + std::chrono::milliseconds(500));
+        return;
+    }
+
+    // A torn frame was overwritten by the sender while being copied out (E.g. after another receiver took over the channel)
+    cv::Mat frame;
+    auto result = ring_->Read(frame, latest_only_);
+    if (result == FlowCV::ShmFrameRing::ReadResult::Read) {
+        outputs.SetValue(0, frame);
+        received_count_++;
+        RequestTick_();
+    }
+    else if (result == FlowCV::ShmFrameRing::ReadResult::Torn) {
+        torn_count_++;
+        RequestTick_();
+    }
+    else {
+        RequestTick_(std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+    }
+}
+
+bool ShmReceive::HasGui(int interface)
+{
+    // When Creating Strings for Controls use: CreateControlString("Text Here", GetInstanceCount()).c_str()
+    // This will ensure a unique control name for ImGui with multiple instance of the Plugin
+    if (interface == (int)FlowCV::GuiInterfaceType_Controls) {
+        return true;
+    }
+
+    return false;
+}
+
+void ShmReceive::UpdateGui(void *context, int interface)
+{
+    auto *imCurContext = (ImGuiContext *)context;
+    ImGui::SetCurrentContext(imCurContext);
+
+    if (interface == (int)FlowCV::GuiInterfaceType_Controls) {
+        std::lock_guard<std::mutex> lk(io_mutex_);
+        ImGui::SetNextItemWidth(140);
+        // Applied once entered, rather than reconnecting for every partial name typed
+        if (ImGui::InputText(CreateControlString("Channel", GetInstanceName()).c_str(), tmp_channel_buf_, 64, ImGuiInputTextFlags_EnterReturnsTrue) ||
+            ImGui::IsItemDeactivatedAfterEdit()) {
+            if (channel_ != tmp_channel_buf_) {
+                channel_ = tmp_channel_buf_;
+                reopen_ = true;
+            }
+        }
+        ImGui::Checkbox(CreateControlString("Latest Frame Only", GetInstanceName()).c_str(), &latest_only_);
+        ImGui::Separator();
+        if (ring_ != nullptr) {
+            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Connected");
+            ImGui::Text("Slots: %u x %zu MB", ring_->GetSlotCount(), ring_->GetSlotBytes() / (1024 * 1024));
+        }
+        else {
+            ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Not Connected");
+        }
+        ImGui::Text("Received: %lld  Torn: %lld", (long long)received_count_, (long long)torn_count_);
+    }
+}
+
+nlohmann::json ShmReceive::GetStateJson()
+{
+    using namespace nlohmann;
+
+    json state;
+
+    state["channel"] = channel_;
+    state["latest_only"] = latest_only_;
+
+    return state;
+}
+
+void ShmReceive::SetStateJson(nlohmann::json &&state)
+{
+    using namespace nlohmann;
+
+    std::lock_guard<std::mutex> lk(io_mutex_);
+    if (state.contains("channel")) {
+        channel_ = state["channel"].get<std::string>();
+        strncpy(tmp_channel_buf_, channel_.c_str(), sizeof(tmp_channel_buf_) - 1);
+    }
+    if (state.contains("latest_only"))
+        latest_only_ = state["latest_only"].get<bool>();
+
+    reopen_ = true;
+}
@@ -0,0 +1,50 @@
+//
+// Plugin ShmReceive
+//
+
+#ifndef FLOWCV_PLUGIN_SHM_RECEIVE_HPP_
+#define FLOWCV_PLUGIN_SHM_RECEIVE_HPP_
+#include <DSPatch.h>
+#include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
+#include "imgui_wrapper.hpp"
+#include "imgui_opencv.hpp"
+#include "json.hpp"
+#include "shm_frame_ring.hpp"
+
+namespace DSPatch::DSPatchables
+{
+namespace internal
+{
+class ShmReceive;
+}
+
+class DLLEXPORT ShmReceive final : public FlowCV::JsonState
+{
+  public:
+    ShmReceive();
+    void UpdateGui(void *context, int interface) override;
+    bool HasGui(int interface) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
+
+  protected:
+    void Process_(SignalBus const &inputs, SignalBus &outputs) override;
+
+  private:
+    std::unique_ptr<internal::ShmReceive> p;
+    std::mutex io_mutex_;
+    std::shared_ptr<FlowCV::ShmFrameRing> ring_;
+    std::string channel_;
+    char tmp_channel_buf_[64] = {'\0'};
+    bool latest_only_;
+    bool reopen_;
+    int64_t received_count_;
+    int64_t torn_count_;
+};
+
+EXPORT_PLUGIN(ShmReceive)
+
+}  // namespace DSPatch::DSPatchables
+
+#endif  // FLOWCV_PLUGIN_SHM_RECEIVE_HPP_
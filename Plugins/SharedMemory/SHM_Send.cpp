@@ -0,0 +1,156 @@
+//
+// Plugin ShmSend
+//
+
+#include "SHM_Send.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace DSPatch;
+using namespace DSPatchables;
+
+int32_t global_inst_counter = 0;
+
+namespace DSPatch::DSPatchables::internal
+{
+class ShmSend
+{
+};
+}  // namespace DSPatch::DSPatchables::internal
+
+ShmSend::ShmSend() : FlowCV::JsonState(ProcessOrder::InOrder), p(new internal::ShmSend())
+{
+    // Name and Category
+    SetComponentName_("SHM_Send");
+    SetComponentCategory_(Category::Category_Output);
+    SetComponentAuthor_("Richard");
+    SetComponentVersion_("0.1.0");
+    SetInstanceCount(global_inst_counter);
+    global_inst_counter++;
+
+    // 1 inputs
+    SetInputCount_(1, {"in"}, {IoType::Io_Type_CvMat});
+
+    // 0 outputs
+    SetOutputCount_(0);
+
+    slot_count_ = 4;
+    slot_size_mb_ = 8;
+    reopen_ = false;
+    sent_count_ = 0;
+    dropped_count_ = 0;
+    too_large_ = false;
+
+    SetEnabled(true);
+}
+
+void ShmSend::Process_(SignalBus const &inputs, SignalBus &outputs)
+{
+    // Input Handler
+    auto in1 = inputs.GetValue<cv::Mat>(0);
+    if (!in1) {
+        return;
+    }
+
+    if (!in1->empty() && IsEnabled()) {
+        std::lock_guard<std::mutex> lk(io_mutex_);
+        if (reopen_) {
+            // The old ring is unlinked first, in case it is on the same channel
+            ring_.reset();
+            ring_ = FlowCV::ShmFrameRing::Create(channel_, (uint32_t)slot_count_, (size_t)slot_size_mb_ * 1024 * 1024);
+            reopen_ = false;
+        }
+
+        if (ring_ != nullptr) {
+            auto result = ring_->Write(*in1);
+            if (result == FlowCV::ShmFrameRing::WriteResult::Written)
+                sent_count_++;
+            else
+                dropped_count_++;
+            too_large_ = result == FlowCV::ShmFrameRing::WriteResult::TooLarge;
+        }
+    }
+}
+
+bool ShmSend::HasGui(int interface)
+{
+    // When Creating Strings for Controls use: CreateControlString("Text Here", GetInstanceCount()).c_str()
+    // This will ensure a unique control name for ImGui with multiple instance of the Plugin
+    if (interface == (int)FlowCV::GuiInterfaceType_Controls) {
+        return true;
+    }
+
+    return false;
+}
+
+void ShmSend::UpdateGui(void *context, int interface)
+{
+    auto *imCurContext = (ImGuiContext *)context;
+    ImGui::SetCurrentContext(imCurContext);
+
+    if (interface == (int)FlowCV::GuiInterfaceType_Controls) {
+        std::lock_guard<std::mutex> lk(io_mutex_);
+        ImGui::SetNextItemWidth(140);
+        // Applied once entered, rather than creating a ring for every partial name typed
+        if (ImGui::InputText(CreateControlString("Channel", GetInstanceName()).c_str(), tmp_channel_buf_, 64, ImGuiInputTextFlags_EnterReturnsTrue) ||
+            ImGui::IsItemDeactivatedAfterEdit()) {
+            if (channel_ != tmp_channel_buf_) {
+                channel_ = tmp_channel_buf_;
+                reopen_ = true;
+            }
+        }
+        ImGui::SetNextItemWidth(120);
+        if (ImGui::InputInt(CreateControlString("Slots", GetInstanceName()).c_str(), &slot_count_)) {
+            slot_count_ = std::clamp(slot_count_, 1, 64);
+            reopen_ = true;
+        }
+        ImGui::SetNextItemWidth(120);
+        if (ImGui::InputInt(CreateControlString("Slot Size (MB)", GetInstanceName()).c_str(), &slot_size_mb_)) {
+            slot_size_mb_ = std::clamp(slot_size_mb_, 1, 256);
+            reopen_ = true;
+        }
+        ImGui::Separator();
+        if (ring_ != nullptr)
+            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Open");
+        else
+            ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Not Open");
+        ImGui::Text("Sent: %lld  Dropped: %lld", (long long)sent_count_, (long long)dropped_count_);
+        if (too_large_)
+            ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Frames are larger than a slot");
+    }
+}
+
+nlohmann::json ShmSend::GetStateJson()
+{
+    using namespace nlohmann;
+
+    json state;
+
+    state["channel"] = channel_;
+    state["slot_count"] = slot_count_;
+    state["slot_size_mb"] = slot_size_mb_;
+
+    return state;
+}
+
+void ShmSend::SetStateJson(nlohmann::json &&state)
+{
+    using namespace nlohmann;
+
+    std::lock_guard<std::mutex> lk(io_mutex_);
+    std::string channel = channel_;
+    int slotCount = slot_count_;
+    int slotSizeMb = slot_size_mb_;
+    if (state.contains("channel")) {
+        channel_ = state["channel"].get<std::string>();
+        strncpy(tmp_channel_buf_, channel_.c_str(), sizeof(tmp_channel_buf_) - 1);
+    }
+    if (state.contains("slot_count"))
+        slot_count_ = std::clamp(state["slot_count"].get<int>(), 1, 64);
+    if (state.contains("slot_size_mb"))
+        slot_size_mb_ = std::clamp(state["slot_size_mb"].get<int>(), 1, 256);
+
+    // Recreating an unchanged ring would only disconnect its receivers
+    if (ring_ == nullptr || channel != channel_ || slotCount != slot_count_ || slotSizeMb != slot_size_mb_)
+        reopen_ = true;
+}
@@ -0,0 +1,52 @@
+//
+// Plugin ShmSend
+//
+
+#ifndef FLOWCV_PLUGIN_SHM_SEND_HPP_
+#define FLOWCV_PLUGIN_SHM_SEND_HPP_
+#include <DSPatch.h>
+#include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
+#include "imgui_wrapper.hpp"
+#include "imgui_opencv.hpp"
+#include "json.hpp"
+#include "shm_frame_ring.hpp"
+
+namespace DSPatch::DSPatchables
+{
+namespace internal
+{
+class ShmSend;
+}
+
+class DLLEXPORT ShmSend final : public FlowCV::JsonState
+{
+  public:
+    ShmSend();
+    void UpdateGui(void *context, int interface) override;
+    bool HasGui(int interface) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
+
+  protected:
+    void Process_(SignalBus const &inputs, SignalBus &outputs) override;
+
+  private:
+    std::unique_ptr<internal::ShmSend> p;
+    std::mutex io_mutex_;
+    std::shared_ptr<FlowCV::ShmFrameRing> ring_;
+    std::string channel_;
+    char tmp_channel_buf_[64] = {'\0'};
+    int slot_count_;
+    int slot_size_mb_;
+    bool reopen_;
+    int64_t sent_count_;
+    int64_t dropped_count_;
+    bool too_large_;
+};
+
+EXPORT_PLUGIN(ShmSend)
+
+}  // namespace DSPatch::DSPatchables
+
+#endif  // FLOWCV_PLUGIN_SHM_SEND_HPP_
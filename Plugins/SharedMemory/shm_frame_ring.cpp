@@ -0,0 +1,287 @@
+//
+// Shared Memory Frame Ring
+//
+
+#include "shm_frame_ring.hpp"
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace FlowCV
+{
+
+namespace
+{
+constexpr uint32_t ringMagic = 0x52564346;  // "FCVR"
+constexpr uint32_t ringVersion = 2;
+constexpr uint64_t slotWriting = ~0ull;  // a slot's frame_no while the producer writes to it
+constexpr size_t cacheLine = 64;
+
+size_t AlignUp(size_t bytes)
+{
+    return (bytes + cacheLine - 1) & ~(cacheLine - 1);
+}
+}  // namespace
+
+// The indices count frames, not slots, so write_index - read_index is the number of slots in use
+struct ShmFrameRing::Header
+{
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    std::atomic<uint32_t> epoch;  // advanced whenever a producer reinitialises the ring
+    uint32_t slot_count;
+    uint64_t slot_bytes;
+    alignas(cacheLine) std::atomic<uint64_t> write_index;
+    alignas(cacheLine) std::atomic<uint64_t> read_index;
+};
+
+struct ShmFrameRing::Slot
+{
+    std::atomic<uint64_t> frame_no;  // the write index the slot was written at, or slotWriting
+    int32_t rows;
+    int32_t cols;
+    int32_t type;
+    uint64_t step;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free, "Shared memory indices must be lock-free");
+
+std::string ShmFrameRing::ShmName_(const std::string &channel)
+{
+    return "/flowcv_" + channel;
+}
+
+std::shared_ptr<ShmFrameRing> ShmFrameRing::Create(const std::string &channel, uint32_t slot_count, size_t slot_bytes)
+{
+    if (channel.empty() || channel.find('/') != std::string::npos || slot_count == 0 || slot_bytes == 0)
+        return nullptr;
+
+    std::string shmName = ShmName_(channel);
+    int fd = shm_open(shmName.c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd == -1) {
+        std::cerr << "Failed to create shared memory " << shmName << ": " << strerror(errno) << std::endl;
+        return nullptr;
+    }
+
+    size_t slotStride = AlignUp(sizeof(Slot)) + AlignUp(slot_bytes);
+    size_t ringSize = AlignUp(sizeof(Header)) + slot_count * slotStride;
+
+    // The object is only ever grown, a consumer still mapped to the old size must not fault before it sees the new epoch
+    struct stat st = {};
+    if (fstat(fd, &st) == -1 || ((size_t)st.st_size < ringSize && ftruncate(fd, (off_t)ringSize) == -1)) {
+        std::cerr << "Failed to size shared memory " << shmName << ": " << strerror(errno) << std::endl;
+        close(fd);
+        return nullptr;
+    }
+
+    std::shared_ptr<ShmFrameRing> ring(new ShmFrameRing());
+    bool mapped = ring->Map_(fd, ringSize);
+    close(fd);
+    if (!mapped)
+        return nullptr;
+
+    ring->slot_count_ = slot_count;
+    ring->slot_bytes_ = slot_bytes;
+    ring->slot_stride_ = slotStride;
+
+    Header *header = ring->header_;
+    if (header->magic.load(std::memory_order_acquire) != ringMagic || header->version != ringVersion || header->slot_count != slot_count ||
+        header->slot_bytes != slot_bytes) {
+        header->magic.store(0, std::memory_order_relaxed);
+        header->version = ringVersion;
+        header->slot_count = slot_count;
+        header->slot_bytes = slot_bytes;
+        header->write_index.store(0, std::memory_order_relaxed);
+        header->read_index.store(0, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < slot_count; i++)
+            ring->SlotAt_(i).frame_no.store(slotWriting, std::memory_order_relaxed);
+        header->epoch.fetch_add(1, std::memory_order_relaxed);
+        header->magic.store(ringMagic, std::memory_order_release);
+    }
+    ring->epoch_ = header->epoch.load(std::memory_order_relaxed);
+    ring->unlink_name_ = shmName;
+
+    return ring;
+}
+
+std::shared_ptr<ShmFrameRing> ShmFrameRing::Open(const std::string &channel)
+{
+    if (channel.empty() || channel.find('/') != std::string::npos)
+        return nullptr;
+
+    int fd = shm_open(ShmName_(channel).c_str(), O_RDWR, 0600);
+    if (fd == -1)
+        return nullptr;
+
+    struct stat st = {};
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size < AlignUp(sizeof(Header))) {
+        close(fd);
+        return nullptr;
+    }
+
+    std::shared_ptr<ShmFrameRing> ring(new ShmFrameRing());
+    bool mapped = ring->Map_(fd, (size_t)st.st_size);
+    close(fd);
+    if (!mapped)
+        return nullptr;
+
+    // Not yet initialised by a producer
+    Header *header = ring->header_;
+    if (header->magic.load(std::memory_order_acquire) != ringMagic || header->version != ringVersion)
+        return nullptr;
+
+    ring->epoch_ = header->epoch.load(std::memory_order_relaxed);
+    ring->slot_count_ = header->slot_count;
+    ring->slot_bytes_ = header->slot_bytes;
+    ring->slot_stride_ = AlignUp(sizeof(Slot)) + AlignUp(ring->slot_bytes_);
+    // Or grown by a producer between fstat() and reading the header
+    if (ring->slot_count_ == 0 || AlignUp(sizeof(Header)) + ring->slot_count_ * ring->slot_stride_ > ring->map_size_)
+        return nullptr;
+
+    // Start from the newest frame, slots still being read by a previous consumer are given back to the producer (which
+    // that consumer sees as a torn frame, should the producer reuse one before its copy is done)
+    ring->next_read_ = header->write_index.load(std::memory_order_acquire);
+    ring->AdvanceReadIndex_();
+
+    return ring;
+}
+
+bool ShmFrameRing::Map_(int fd, size_t size)
+{
+    void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        std::cerr << "Failed to map shared memory: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    map_ = map;
+    map_size_ = size;
+    header_ = (Header *)map;
+
+    return true;
+}
+
+ShmFrameRing::~ShmFrameRing()
+{
+    if (map_ == nullptr)
+        return;
+
+    // Consumers keep their mapping, but see the ring as stale and go back to opening the channel by name
+    if (!unlink_name_.empty()) {
+        header_->magic.store(0, std::memory_order_release);
+        shm_unlink(unlink_name_.c_str());
+    }
+    munmap(map_, map_size_);
+}
+
+ShmFrameRing::Slot &ShmFrameRing::SlotAt_(uint64_t index) const
+{
+    return *(Slot *)((uchar *)map_ + AlignUp(sizeof(Header)) + (index % slot_count_) * slot_stride_);
+}
+
+uchar *ShmFrameRing::SlotData_(uint64_t index) const
+{
+    return (uchar *)&SlotAt_(index) + AlignUp(sizeof(Slot));
+}
+
+ShmFrameRing::WriteResult ShmFrameRing::Write(const cv::Mat &frame)
+{
+    size_t rowBytes = (size_t)frame.cols * frame.elemSize();
+    if (rowBytes * frame.rows > slot_bytes_)
+        return WriteResult::TooLarge;
+
+    uint64_t writeIndex = header_->write_index.load(std::memory_order_relaxed);
+    if (writeIndex - header_->read_index.load(std::memory_order_acquire) >= slot_count_)
+        return WriteResult::RingFull;
+
+    // Marked as being written before its contents change, so that a consumer still copying the slot sees it torn
+    Slot &slot = SlotAt_(writeIndex);
+    slot.frame_no.store(slotWriting, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uchar *data = SlotData_(writeIndex);
+    if (frame.isContinuous()) {
+        memcpy(data, frame.data, rowBytes * frame.rows);
+    }
+    else {
+        for (int row = 0; row < frame.rows; row++)
+            memcpy(data + row * rowBytes, frame.ptr<uchar>(row), rowBytes);
+    }
+    slot.rows = frame.rows;
+    slot.cols = frame.cols;
+    slot.type = frame.type();
+    slot.step = rowBytes;
+
+    slot.frame_no.store(writeIndex, std::memory_order_release);
+    header_->write_index.store(writeIndex + 1, std::memory_order_release);
+
+    return WriteResult::Written;
+}
+
+ShmFrameRing::ReadResult ShmFrameRing::Read(cv::Mat &frame, bool latest_only)
+{
+    if (IsStale())
+        return ReadResult::NoFrame;
+
+    std::lock_guard<std::mutex> lk(read_mutex_);
+    uint64_t writeIndex = header_->write_index.load(std::memory_order_acquire);
+    if (next_read_ >= writeIndex)
+        return ReadResult::NoFrame;
+
+    // Skipped frames are given back to the producer along with the one read
+    if (latest_only)
+        next_read_ = writeIndex - 1;
+    uint64_t index = next_read_++;
+
+    const Slot &slot = SlotAt_(index);
+    bool torn = slot.frame_no.load(std::memory_order_acquire) != index;
+    if (!torn) {
+        int rows = slot.rows;
+        int cols = slot.cols;
+        int type = slot.type;
+        size_t step = slot.step;
+        torn = rows <= 0 || cols <= 0 || step != (size_t)cols * CV_ELEM_SIZE(type) || step * rows > slot_bytes_;
+        if (!torn) {
+            cv::Mat copy(rows, cols, type);
+            memcpy(copy.data, SlotData_(index), step * rows);
+            // Whatever the producer wrote over the slot while it was being copied, it marked the slot first
+            std::atomic_thread_fence(std::memory_order_acquire);
+            torn = slot.frame_no.load(std::memory_order_relaxed) != index;
+            if (!torn)
+                frame = copy;
+        }
+    }
+
+    AdvanceReadIndex_();
+
+    return torn ? ReadResult::Torn : ReadResult::Read;
+}
+
+void ShmFrameRing::AdvanceReadIndex_()
+{
+    // Only ever forwards, a previous consumer that was overtaken mustn't take back slots the producer has since reused
+    uint64_t readIndex = header_->read_index.load(std::memory_order_relaxed);
+    while (readIndex < next_read_ && !header_->read_index.compare_exchange_weak(readIndex, next_read_, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+bool ShmFrameRing::IsStale() const
+{
+    return header_->epoch.load(std::memory_order_relaxed) != epoch_ || header_->magic.load(std::memory_order_relaxed) != ringMagic;
+}
+
+uint32_t ShmFrameRing::GetSlotCount() const
+{
+    return slot_count_;
+}
+
+size_t ShmFrameRing::GetSlotBytes() const
+{
+    return slot_bytes_;
+}
+
+}  // End Namespace FlowCV
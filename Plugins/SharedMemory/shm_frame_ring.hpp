@@ -0,0 +1,90 @@
+//
+// Shared Memory Frame Ring
+//
+
+#ifndef FLOWCV_SHM_FRAME_RING_HPP_
+#define FLOWCV_SHM_FRAME_RING_HPP_
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace FlowCV
+{
+
+// A ring of fixed size frame slots in a named POSIX shared memory object, for passing frames from one process (the
+// producer, SHM_Send) to another on the same host (the consumer, SHM_Receive).
+//
+// The producer copies each frame into the next free slot, then publishes it by advancing the write index. The consumer
+// copies published slots out in order, then gives them back to the producer by advancing the read index. Both indices
+// are lock-free atomics in the shared memory. When every slot is still unread the ring is full, and the producer drops
+// frames rather than wait.
+//
+// There is one producer and one consumer per ring. A consumer that (re)opens a ring starts from the newest frame, so a
+// consumer that went away mid-read doesn't leave the producer stuck. As the producer may then overwrite a slot that the
+// old consumer is still copying, each slot carries the number of the frame in it, which the consumer checks before and
+// after copying. A frame that changed while being copied is torn, and dropped. A producer that creates a ring of a
+// different geometry reinitialises it, and a producer unlinks its ring when destroyed, both of which consumers see as
+// IsStale().
+class ShmFrameRing
+{
+  public:
+    enum class WriteResult
+    {
+        Written,
+        RingFull,
+        TooLarge
+    };
+
+    enum class ReadResult
+    {
+        Read,
+        NoFrame,
+        Torn
+    };
+
+    // Producer side, creates the ring or reuses an existing one of the same geometry. Returns nullptr on failure.
+    static std::shared_ptr<ShmFrameRing> Create(const std::string &channel, uint32_t slot_count, size_t slot_bytes);
+
+    // Consumer side, opens an existing ring. Returns nullptr if the ring doesn't exist (yet).
+    static std::shared_ptr<ShmFrameRing> Open(const std::string &channel);
+
+    ~ShmFrameRing();
+
+    WriteResult Write(const cv::Mat &frame);
+
+    // Copies the next frame out of its slot. With latest_only, older unread frames are skipped.
+    ReadResult Read(cv::Mat &frame, bool latest_only);
+    [[nodiscard]] bool IsStale() const;
+
+    [[nodiscard]] uint32_t GetSlotCount() const;
+    [[nodiscard]] size_t GetSlotBytes() const;
+
+  private:
+    struct Header;
+    struct Slot;
+
+    ShmFrameRing() = default;
+    static std::string ShmName_(const std::string &channel);
+    bool Map_(int fd, size_t size);
+    Slot &SlotAt_(uint64_t index) const;
+    uchar *SlotData_(uint64_t index) const;
+    void AdvanceReadIndex_();
+
+    void *map_ = nullptr;
+    size_t map_size_ = 0;
+    Header *header_ = nullptr;
+    uint32_t slot_count_ = 0;
+    size_t slot_bytes_ = 0;
+    size_t slot_stride_ = 0;
+    uint32_t epoch_ = 0;
+    std::string unlink_name_;  // producer side, the name to unlink once destroyed
+
+    // Consumer side, the next slot to read
+    std::mutex read_mutex_;
+    uint64_t next_read_ = 0;
+};
+
+}  // End Namespace FlowCV
+#endif  // FLOWCV_SHM_FRAME_RING_HPP_
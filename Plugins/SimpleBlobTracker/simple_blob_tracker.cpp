@@ -3,6 +3,7 @@
 //
 
 #include "simple_blob_tracker.hpp"
+#include "FlowCV_MatSignal.hpp"
 #include <random>
 
 using namespace DSPatch;
@@ -32,7 +33,7 @@ static cv::Vec3b GenerateRandomColor()
     return color;
 }
 
-SimpleBlobTracker::SimpleBlobTracker() : Component(ProcessOrder::OutOfOrder), p(new internal::SimpleBlobTracker())
+SimpleBlobTracker::SimpleBlobTracker() : FlowCV::JsonState(ProcessOrder::OutOfOrder), p(new internal::SimpleBlobTracker())
 {
     // Name and Category
     SetComponentName_("Simple_Blob_Tracker");
@@ -97,7 +98,7 @@ void SimpleBlobTracker::Process_(SignalBus const &inputs, SignalBus &outputs)
         if (IsEnabled()) {
             cv::Mat frame;
             // Process Image
-            in1->copyTo(frame);
+            frame = std::move(*inputs.TakeMutable<cv::Mat>(0));
 
             int refWidth = -1;
             int refHeight = -1;
@@ -256,7 +257,7 @@ void SimpleBlobTracker::UpdateGui(void *context, int interface)
     }
 }
 
-std::string SimpleBlobTracker::GetState()
+nlohmann::json SimpleBlobTracker::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -270,17 +271,13 @@ std::string SimpleBlobTracker::GetState()
     state["max_pos_var"] = max_pos_var_;
     state["max_size_var"] = max_size_var_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void SimpleBlobTracker::SetState(std::string &&json_serialized)
+void SimpleBlobTracker::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("show_tracking"))
         show_tracking_ = state["show_tracking"].get<bool>();
     if (state.contains("show_ids"))
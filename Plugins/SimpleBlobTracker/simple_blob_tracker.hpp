@@ -6,6 +6,7 @@
 #define FLOWCV_PLUGIN_SIMPLE_BLOB_TRACKER_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
@@ -27,14 +28,14 @@ struct BlobTrackingData
 class SimpleBlobTracker;
 }  // namespace internal
 
-class DLLEXPORT SimpleBlobTracker final : public Component
+class DLLEXPORT SimpleBlobTracker final : public FlowCV::JsonState
 {
   public:
     SimpleBlobTracker();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
@@ -25,7 +25,7 @@ const std::map<int, const char *> &GetPropertyList()
     return *property_list;
 }
 
-VideoCapture::VideoCapture() : Component(ProcessOrder::InOrder), p(new internal::VideoCapture())
+VideoCapture::VideoCapture() : FlowCV::JsonState(ProcessOrder::InOrder), p(new internal::VideoCapture())
 {
     // Name and Category
     SetComponentName_("Video_Capture");
@@ -137,6 +137,12 @@ void VideoCapture::Process_(SignalBus const &inputs, SignalBus &outputs)
                 outputs.SetValue(1, fps_);
             }
         }
+        // cap_.read() blocks until the camera's next frame is ready, so request the next tick straight away
+        RequestTick_();
+    }
+    else {
+        // Retry opening the source in a while
+        RequestTick_(std::chrono::steady_clock::now() + std::chrono::milliseconds(500));
     }
 }
 
@@ -240,7 +246,7 @@ void VideoCapture::UpdateGui(void *context, int interface)
     }
 }
 
-std::string VideoCapture::GetState()
+nlohmann::json VideoCapture::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -260,17 +266,13 @@ std::string VideoCapture::GetState()
     }
     state["camera_settings"] = camSettings;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void VideoCapture::SetState(std::string &&json_serialized)
+void VideoCapture::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("list_index")) {
         if (state["list_index"].is_number()) {
             list_index_ = state["list_index"].get<int>();
@@ -7,6 +7,7 @@
 
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
@@ -32,15 +33,15 @@ struct camera_property_info
     bool supported{};
 };
 
-class DLLEXPORT VideoCapture final : public Component
+class DLLEXPORT VideoCapture final : public FlowCV::JsonState
 {
   public:
     VideoCapture();
     ~VideoCapture() override;
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
@@ -3,6 +3,7 @@
 //
 
 #include "video_loader.hpp"
+#include <iostream>
 
 using namespace DSPatch;
 using namespace DSPatchables;
@@ -22,7 +23,7 @@ enum Play_Mode
     Play_Mode_Stopped
 };
 
-VideoLoader::VideoLoader() : Component(ProcessOrder::OutOfOrder), p(new internal::VideoLoader())
+VideoLoader::VideoLoader() : FlowCV::JsonState(ProcessOrder::InOrder), p(new internal::VideoLoader())
 {
     // Name and Category
     SetComponentName_("Video_Loader");
@@ -39,8 +40,7 @@ VideoLoader::VideoLoader() : Component(ProcessOrder::OutOfOrder), p(new internal
     load_new_file_ = false;
     use_fps_ = true;
     frame_count_ = 0;
-    current_time_ = std::chrono::steady_clock::now();
-    last_time_ = current_time_;
+    last_time_ = std::chrono::steady_clock::now();
     start_ = true;
 
     // 0 inputs
@@ -49,6 +49,8 @@ VideoLoader::VideoLoader() : Component(ProcessOrder::OutOfOrder), p(new internal
     // 1 outputs
     SetOutputCount_(4, {"video", "start", "frame", "fps"}, {IoType::Io_Type_CvMat, IoType::Io_Type_Bool, IoType::Io_Type_Int, IoType::Io_Type_Int});
 
+    // Played once through in batch, then ends the stream
+    SetFiniteSource_();
     SetEnabled(true);
 }
 
@@ -63,11 +65,23 @@ void VideoLoader::Process_(SignalBus const &inputs, SignalBus &outputs)
         OpenSource();
     }
 
+    // In batch, a file that can't be played ends the stream at once, rather than leave the run waiting for frames
+    if (!cap_.isOpened() && IsBatch_() && !IsEndOfStream()) {
+        SetStreamError_(video_file_.empty() ? "No video file set" : "Failed to open " + video_file_);
+        return;
+    }
+
     if (cap_.isOpened()) {
         cv::Mat frame;
         bool load_next_frame = false;
+        // In batch, play every frame once through (unpaced), then end the stream
+        bool batch = IsBatch_();
 
-        if (loop_) {
+        if (batch) {
+            if (IsEndOfStream())
+                return;
+        }
+        else if (loop_) {
             if (cur_frame_ >= frame_count_) {
                 cap_.set(cv::CAP_PROP_POS_FRAMES, 0);
                 cur_frame_ = 0;
@@ -80,35 +94,20 @@ void VideoLoader::Process_(SignalBus const &inputs, SignalBus &outputs)
                 play_mode_ = Play_Mode_Stopped;
             }
         }
-        if (use_fps_ && play_mode_ == Play_Mode_Playing) {
-            bool should_wait = true;
-            while (should_wait) {
-                current_time_ = std::chrono::steady_clock::now();
-                auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(current_time_ - last_time_).count();
-                if (delta >= (uint32_t)fps_time_)
-                    should_wait = false;
-            }
-            load_next_frame = true;
-            last_time_ = current_time_;
-        }
-        else {
-
-            bool should_wait = true;
-            while (should_wait) {
-                current_time_ = std::chrono::steady_clock::now();
-                auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(current_time_ - last_time_).count();
-                if (delta >= 16)  // limit to 60 FPS when stopped and not using video FPS
-                    should_wait = false;
-            }
-            load_next_frame = true;
-            last_time_ = current_time_;
-        }
+        // Sleep (or request a tick) until the next frame is due instead of spinning
+        if (use_fps_ && play_mode_ == Play_Mode_Playing)
+            load_next_frame = PaceTick_(last_time_, std::chrono::microseconds((int64_t)(fps_time_ * 1000.0f)));
+        else
+            load_next_frame = PaceTick_(last_time_, std::chrono::milliseconds(16));  // limit to 60 FPS when stopped and not using video FPS
         if (load_next_frame) {
-            if (cur_frame_ == 0 || cur_frame_ == 1)
+            // (Only the very first frame in batch, a writer's start input toggles recording)
+            if (batch)
+                start_ = cur_frame_ == 0;
+            else if (cur_frame_ == 0 || cur_frame_ == 1)
                 start_ = true;
             else
                 start_ = false;
-            switch (play_mode_) {
+            switch (batch ? (int)Play_Mode_Playing : play_mode_) {
                 case (int)Play_Mode_Playing:
                     cap_.read(frame);
                     cur_frame_ = (int)cap_.get(cv::CAP_PROP_POS_FRAMES);
@@ -120,7 +119,10 @@ void VideoLoader::Process_(SignalBus const &inputs, SignalBus &outputs)
                     cur_frame_ = (int)cap_.get(cv::CAP_PROP_POS_FRAMES);
                     break;
             }
-            if (!frame.empty()) {
+            if (batch && frame.empty()) {
+                SetEndOfStream_();
+            }
+            else if (!frame.empty()) {
                 outputs.SetValue(0, frame);
                 outputs.SetValue(1, start_);
                 outputs.SetValue(2, cur_frame_);
@@ -144,6 +146,7 @@ void VideoLoader::OpenSource()
     if (cap_.isOpened())
         cap_.release();
 
+    SetEndOfStream_(false);
     if (cap_.open(video_file_, cv::CAP_ANY)) {
         cur_frame_ = (int)cap_.get(cv::CAP_PROP_POS_FRAMES);
         last_frame_ = cur_frame_;
@@ -151,6 +154,9 @@ void VideoLoader::OpenSource()
         fps_ = (int)cap_.get(cv::CAP_PROP_FPS);
         fps_time_ = (1.0f / (float)fps_) * 1000.0f;
     }
+    else if (!video_file_.empty()) {
+        std::cerr << "Failed to open video file " << video_file_ << std::endl;
+    }
 }
 
 void VideoLoader::UpdateGui(void *context, int interface)
@@ -255,7 +261,7 @@ void VideoLoader::UpdateGui(void *context, int interface)
     }
 }
 
-std::string VideoLoader::GetState()
+nlohmann::json VideoLoader::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -264,17 +270,13 @@ std::string VideoLoader::GetState()
     state["movie_path"] = video_file_;
     state["looping"] = loop_;
     state["use_fps_speed"] = use_fps_;
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void VideoLoader::SetState(std::string &&json_serialized)
+void VideoLoader::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("looping"))
         loop_ = state["looping"].get<bool>();
     if (state.contains("use_fps_speed"))
@@ -6,6 +6,7 @@
 #define FLOWCV_PLUGIN_MEDIA_READER_HPP_
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
@@ -18,15 +19,15 @@ namespace internal
 class VideoLoader;
 }
 
-class DLLEXPORT VideoLoader final : public Component
+class DLLEXPORT VideoLoader final : public FlowCV::JsonState
 {
   public:
     VideoLoader();
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
     void OpenSource();
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
@@ -47,7 +48,6 @@ class DLLEXPORT VideoLoader final : public Component
     bool use_fps_;
     int fps_{};
     float fps_time_{};
-    std::chrono::steady_clock::time_point current_time_;
     std::chrono::steady_clock::time_point last_time_;
     imgui_addons::ImGuiFileBrowser file_dialog_;
 };
@@ -24,7 +24,7 @@ const std::vector<std::pair<const std::string, const std::string>> &GetCodecList
     return *codec_list;
 }
 
-VideoWriter::VideoWriter() : Component(ProcessOrder::OutOfOrder), p(new internal::VideoWriter())
+VideoWriter::VideoWriter() : FlowCV::JsonState(ProcessOrder::InOrder), p(new internal::VideoWriter())
 {
 
     // Name and Category
@@ -133,10 +133,10 @@ void VideoWriter::Process_(SignalBus const &inputs, SignalBus &outputs)
             if (fps_ != last_fps_ || codec_ != last_codec_ || save_new_file_)
                 SaveSource();
 
-            if (!video_writer_.isOpened()) {
+            if (!video_writer_.isOpened())
                 SaveSource();
-            }
-            else {
+
+            if (video_writer_.isOpened()) {
                 current_time_ = std::chrono::steady_clock::now();
                 // auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(current_time_ - last_time_).count();
                 // if ((float) delta >= fps_time_) {
@@ -148,6 +148,14 @@ void VideoWriter::Process_(SignalBus const &inputs, SignalBus &outputs)
     }
 }
 
+void VideoWriter::Flush_()
+{
+    // End of stream, finalise the file
+    if (video_writer_.isOpened())
+        video_writer_.release();
+    allow_write_ = false;
+}
+
 bool VideoWriter::HasGui(int interface)
 {
     if (interface == (int)FlowCV::GuiInterfaceType_Controls) {
@@ -232,7 +240,7 @@ void VideoWriter::UpdateGui(void *context, int interface)
     }
 }
 
-std::string VideoWriter::GetState()
+nlohmann::json VideoWriter::GetStateJson()
 {
     using namespace nlohmann;
 
@@ -245,17 +253,13 @@ std::string VideoWriter::GetState()
     state["fps_index"] = fps_index_;
     state["auto_ext"] = auto_ext_;
 
-    std::string stateSerialized = state.dump(4);
-
-    return stateSerialized;
+    return state;
 }
 
-void VideoWriter::SetState(std::string &&json_serialized)
+void VideoWriter::SetStateJson(nlohmann::json &&state)
 {
     using namespace nlohmann;
 
-    json state = json::parse(json_serialized);
-
     if (state.contains("filename"))
         out_filename_ = state["filename"].get<std::string>();
     if (state.contains("codec"))
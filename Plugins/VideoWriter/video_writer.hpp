@@ -7,6 +7,7 @@
 
 #include <DSPatch.h>
 #include "FlowCV_Types.hpp"
+#include "FlowCV_JsonState.hpp"
 #include "imgui_wrapper.hpp"
 #include "imgui_opencv.hpp"
 #include "json.hpp"
@@ -19,19 +20,20 @@ namespace internal
 class VideoWriter;
 }
 
-class DLLEXPORT VideoWriter final : public Component
+class DLLEXPORT VideoWriter final : public FlowCV::JsonState
 {
   public:
     VideoWriter();
     ~VideoWriter() override;
     void UpdateGui(void *context, int interface) override;
     bool HasGui(int interface) override;
-    std::string GetState() override;
-    void SetState(std::string &&json_serialized) override;
+    nlohmann::json GetStateJson() override;
+    void SetStateJson(nlohmann::json &&state) override;
 
   protected:
     void Process_(SignalBus const &inputs, SignalBus &outputs) override;
     void SaveSource();
+    void Flush_() override;
 
   private:
     std::unique_ptr<internal::VideoWriter> p;
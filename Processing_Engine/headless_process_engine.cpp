@@ -9,7 +9,12 @@
 #include <thread>
 #include <tclap/CmdLine.h>
 #include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <memory>
+#include <vector>
 #include <FlowCV_Manager.hpp>
+#include <Frame_Pool.hpp>
 #ifdef __linux__
 #include <climits>
 #include <unistd.h>
@@ -48,21 +53,123 @@ int Init_Signal()
     return 0;
 }
 
+struct FlowInstance
+{
+    std::string name;
+    std::string file;
+    std::unique_ptr<FlowCV::FlowCV_Manager> manager;
+};
+
+void AddFlow(std::vector<FlowInstance> &flows, const std::string &file, std::string name = "")
+{
+    if (name.empty())
+        name = std::filesystem::path(file).stem().string();
+
+    // Flow names key the metrics and trace files, so must be unique
+    std::string uniqueName = name;
+    for (int n = 2; std::any_of(flows.begin(), flows.end(), [&](const FlowInstance &flow) { return flow.name == uniqueName; }); n++)
+        uniqueName = name + "_" + std::to_string(n);
+
+    FlowInstance flow;
+    flow.name = uniqueName;
+    flow.file = file;
+    flows.emplace_back(std::move(flow));
+}
+
+// A manifest is a JSON list of flows, each either a flow file or an object of {"flow": file, "name": name}, optionally
+// wrapped in {"flows": [...]}. Relative flow files are relative to the manifest.
+bool LoadManifest(const std::string &manifest_file, std::vector<FlowInstance> &flows)
+{
+    std::ifstream i(manifest_file);
+    if (!i.is_open())
+        return false;
+
+    nlohmann::json manifest = nlohmann::json::parse(i, nullptr, false);
+    if (manifest.is_object() && manifest.contains("flows"))
+        manifest = manifest["flows"];
+    if (!manifest.is_array())
+        return false;
+
+    std::filesystem::path manifestDir = std::filesystem::path(manifest_file).parent_path();
+    for (const auto &entry : manifest) {
+        std::string file;
+        std::string name;
+        if (entry.is_string()) {
+            file = entry.get<std::string>();
+        }
+        else if (entry.is_object() && entry.contains("flow") && entry["flow"].is_string()) {
+            file = entry["flow"].get<std::string>();
+            if (entry.contains("name") && entry["name"].is_string())
+                name = entry["name"].get<std::string>();
+        }
+        else {
+            return false;
+        }
+        if (std::filesystem::path(file).is_relative())
+            file = (manifestDir / file).string();
+        AddFlow(flows, file, name);
+    }
+
+    return true;
+}
+
 int main(int argc, char *argv[])
 {
     std::string appDir;
     std::string cfgDir;
     AppSettings appSettings;
+    appSettings.flowBufferAutoTune = false;
+    appSettings.flowTargetFps = 30.0f;
     CmdLine cmd("FlowCV Processing Engine", ' ', APP_VERSION);
-    ValueArg<std::string> flow_file_arg("f", "flow", "Flow File", true, "", "string");
+    MultiArg<std::string> flow_file_arg("f", "flow", "Flow File (repeat to run several flows in one process)", false, "string");
+    ValueArg<std::string> manifest_arg("", "manifest", "JSON file listing flows to run in one process", false, "", "string");
     ValueArg<std::string> cfg_file_arg("c", "cfg", "Custom Config File", false, "", "string");
+    ValueArg<double> rate_arg("r", "rate", "Tick the flow at a fixed rate (Hz) instead of free-running", false, 0.0, "double");
+    ValueArg<float> auto_tune_arg("a", "auto-tune", "Auto-tune the buffer count to reach a target frame rate (FPS)", false, 0.0f, "float");
+    ValueArg<std::string> metrics_arg("m", "metrics", "Periodically write per-node (and per-flow) metrics as JSON to this file", false, "", "string");
+    ValueArg<std::string> trace_arg(
+        "t", "trace", "Write a Chrome Trace Event (Perfetto) timeline of the run to this file (one per flow, suffixed by flow name)", false, "", "string");
+    ValueArg<int> metrics_interval_arg("i", "metrics-interval", "Seconds between metrics updates", false, 5, "int");
+    SwitchArg source_driven_arg("s", "source-driven", "Only tick the flow when a source node has new data", false);
+    SwitchArg batch_arg("b", "batch", "Process sources to end of stream as fast as possible, then exit with a throughput report", false);
+    ValueArg<int> stall_timeout_arg("", "stall-timeout", "In batch, give up once no source has output a frame for this many seconds (0 to wait forever)", false, 30, "int");
+    ValueArg<std::string> export_cbor_arg("", "export-cbor", "Save the loaded flow to this file as binary CBOR (faster to load), then exit", false, "", "string");
     cmd.add(flow_file_arg);
+    cmd.add(manifest_arg);
     cmd.add(cfg_file_arg);
+    cmd.add(rate_arg);
+    cmd.add(source_driven_arg);
+    cmd.add(batch_arg);
+    cmd.add(stall_timeout_arg);
+    cmd.add(auto_tune_arg);
+    cmd.add(metrics_arg);
+    cmd.add(metrics_interval_arg);
+    cmd.add(trace_arg);
+    cmd.add(export_cbor_arg);
     cmd.parse(argc, argv);
 
     LOG_INFO("\nFlowCV Processing Engine - v{}\n", APP_VERSION);
 
-    FlowCV::FlowCV_Manager flowMan;
+    std::vector<FlowInstance> flows;
+    for (const auto &flowFile : flow_file_arg.getValue())
+        AddFlow(flows, flowFile);
+    if (!manifest_arg.getValue().empty() && !LoadManifest(manifest_arg.getValue(), flows)) {
+        LOG_ERROR("Error Loading Manifest: {}", manifest_arg.getValue());
+        return EXIT_FAILURE;
+    }
+    if (flows.empty()) {
+        LOG_ERROR("No Flow File Given, use -f or --manifest");
+        return EXIT_FAILURE;
+    }
+
+    // Recycle frame buffers across ticks rather than allocate every node's outputs anew
+    FlowCV::FramePool::Install();
+
+    // Every flow runs in its own circuit, but plugins are loaded once and all circuits tick on one thread pool
+    FlowCV::FlowCV_Resources resources;
+    for (auto &flow : flows)
+        flow.manager = std::make_unique<FlowCV::FlowCV_Manager>(resources);
+    FlowCV::FlowCV_Manager &flowMan = *flows.front().manager;
 
     // Load Settings
 #ifdef __linux__
@@ -135,29 +242,176 @@ int main(int argc, char *argv[])
     }
     LOG_INFO("{} Plugin(s) Loaded", flowMan.plugin_manager_->PluginCount());
 
-    LOG_INFO("Loading Flow File: {}", flow_file_arg.getValue());
-    if (!flowMan.LoadState(flow_file_arg.getValue().c_str())) {
-        LOG_ERROR("Error Loading Flow File");
-        return EXIT_FAILURE;
+    for (auto &flow : flows) {
+        LOG_INFO("Loading Flow File: {}", flow.file);
+        std::string error;
+        if (!flow.manager->LoadState(flow.file.c_str(), &error)) {
+            LOG_ERROR("Error Loading Flow File: {}", error);
+            return EXIT_FAILURE;
+        }
+        LOG_INFO("Flow State Loaded, {} Nodes Loaded and Configured", flow.manager->GetNodeCount());
+    }
+
+    if (!export_cbor_arg.getValue().empty()) {
+        if (flows.size() != 1) {
+            LOG_ERROR("Only One Flow Can Be Exported At A Time");
+            return EXIT_FAILURE;
+        }
+        if (!flowMan.SaveState(export_cbor_arg.getValue().c_str(), FlowCV::FlowFileFormat::Cbor)) {
+            LOG_ERROR("Error Exporting Flow File: {}", export_cbor_arg.getValue());
+            return EXIT_FAILURE;
+        }
+        LOG_INFO("Flow Exported To {}", export_cbor_arg.getValue());
+        return EXIT_SUCCESS;
     }
-    LOG_INFO("Flow State Loaded, {} Nodes Loaded and Configured", flowMan.GetNodeCount());
 
     // Init Signal Handling (Cntrl-C, Cntrl-X to clean exit)
     Init_Signal();
 
-    LOG_INFO("Flow Processing Started");
+    // A batch run only ends once every flow has reached end of stream, which a flow without a finite source never does
+    if (batch_arg.getValue()) {
+        for (auto &flow : flows) {
+            if (!flow.manager->CanEndStream()) {
+                LOG_ERROR("[{}] Has No Source That Ends Its Stream (E.g. a Video Loader), So Can't Run in Batch", flow.name);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (batch_arg.getValue())
+        LOG_INFO("Batch Tick Mode");
+    else if (source_driven_arg.getValue())
+        LOG_INFO("Source Driven Tick Mode");
+    else if (rate_arg.getValue() > 0.0)
+        LOG_INFO("Clocked Tick Mode, {} Hz", rate_arg.getValue());
+
+    if (!trace_arg.getValue().empty())
+        LOG_INFO("Tracing to {}", trace_arg.getValue());
+
+    for (auto &flow : flows) {
+        if (batch_arg.getValue())
+            flow.manager->SetAutoTickMode(DSPatch::Circuit::AutoTickMode::Batch);
+        else if (source_driven_arg.getValue())
+            flow.manager->SetAutoTickMode(DSPatch::Circuit::AutoTickMode::SourceDriven);
+        else if (rate_arg.getValue() > 0.0)
+            flow.manager->SetAutoTickMode(DSPatch::Circuit::AutoTickMode::Clocked, rate_arg.getValue());
+
+        if (auto_tune_arg.getValue() > 0.0f)
+            flow.manager->SetBufferAutoTune(true, auto_tune_arg.getValue());
+        else if (appSettings.flowBufferAutoTune)
+            flow.manager->SetBufferAutoTune(true, appSettings.flowTargetFps);
+
+        if (!trace_arg.getValue().empty())
+            flow.manager->StartTrace();
+    }
+
+    LOG_INFO("Flow Processing Started, {} Flow(s)", flows.size());
     // Start Multi-Threaded Flow Processing in Background
-    flowMan.StartAutoTick();
+    auto startTime = chrono::steady_clock::now();
+    for (auto &flow : flows)
+        flow.manager->StartAutoTick();
 
+    auto lastMetricsTime = chrono::steady_clock::now();
+    auto lastProgressTime = chrono::steady_clock::now();
+    int64_t lastFrameCount = 0;
+    bool stalled = false;
     while (!g_bTerminate) {
         // You Can do other things here while the Circuit Flow is running, for now we'll just sleep
-        this_thread::sleep_for(chrono::seconds(1));
+        // (In batch, poll more often so that the run ends, and is timed, close to the end of stream)
+        if (batch_arg.getValue()) {
+            this_thread::sleep_for(chrono::milliseconds(10));
+            if (std::all_of(flows.begin(), flows.end(), [](const FlowInstance &flow) { return flow.manager->IsEndOfStream(); }))
+                break;
+
+            int64_t frameCount = 0;
+            for (auto &flow : flows)
+                frameCount += flow.manager->GetStreamFrameCount();
+            if (frameCount != lastFrameCount) {
+                lastFrameCount = frameCount;
+                lastProgressTime = chrono::steady_clock::now();
+            }
+            else if (stall_timeout_arg.getValue() > 0 && chrono::steady_clock::now() - lastProgressTime >= chrono::seconds(stall_timeout_arg.getValue())) {
+                LOG_ERROR("No Frames Processed For {} s, Giving Up", stall_timeout_arg.getValue());
+                stalled = true;
+                break;
+            }
+        }
+        else {
+            this_thread::sleep_for(chrono::seconds(1));
+        }
+        for (auto &flow : flows)
+            flow.manager->UpdateBufferAutoTune();
+
+        if (!metrics_arg.getValue().empty() && chrono::steady_clock::now() - lastMetricsTime >= chrono::seconds(metrics_interval_arg.getValue())) {
+            lastMetricsTime = chrono::steady_clock::now();
+            // A single flow's metrics are written as they are, several flows' are keyed by flow name
+            nlohmann::json metrics;
+            if (flows.size() == 1) {
+                metrics = flowMan.GetMetrics();
+            }
+            else {
+                for (auto &flow : flows)
+                    metrics["flows"][flow.name] = flow.manager->GetMetrics();
+            }
+            // Write then rename, so that readers never see a partly written file
+            std::string tmpFile = metrics_arg.getValue() + ".tmp";
+            {
+                std::ofstream o(tmpFile);
+                o << metrics.dump(4) << std::endl;
+            }
+            std::error_code ec;
+            std::filesystem::rename(tmpFile, metrics_arg.getValue(), ec);
+            if (ec)
+                LOG_WARN("Failed to write metrics to {}: {}", metrics_arg.getValue(), ec.message());
+        }
+    }
+
+    // Stop Flow Before Going Out of Scope and Cleanup, then have sinks write out whatever they hold
+    for (auto &flow : flows)
+        flow.manager->StopAutoTick();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    for (auto &flow : flows)
+        flow.manager->Flush();
+
+    // A batch run fails if any flow reported an error or was stopped before its sources ran out
+    bool streamErrors = false;
+    bool incomplete = false;
+    if (batch_arg.getValue()) {
+        for (auto &flow : flows) {
+            for (const auto &error : flow.manager->GetStreamErrors()) {
+                LOG_ERROR("[{}] {}", flow.name, error);
+                streamErrors = true;
+            }
+            if (!flow.manager->IsEndOfStream()) {
+                LOG_ERROR("[{}] Did Not Reach End of Stream", flow.name);
+                incomplete = true;
+            }
+
+            // Counted from the sources' output, the circuit itself ticks a few more times than there were frames
+            nlohmann::json metrics = flow.manager->GetMetrics();
+            int64_t frames = flow.manager->GetStreamFrameCount();
+            LOG_INFO("[{}] {} Frames in {:.2f} s, {:.1f} FPS", flow.name, frames, elapsed, elapsed > 0.0 ? (double)frames / elapsed : 0.0);
+            for (const auto &node : metrics["nodes"]) {
+                const auto &process = node["process"];
+                double mean = process["mean_ms"].get<double>();
+                LOG_INFO("    {}: {} Processed, {:.1f} ms Total, {:.2f} ms Mean, {:.2f} ms Max", node["name"].get<std::string>(), process["count"].get<int64_t>(),
+                    mean * (double)process["count"].get<int64_t>(), mean, process["max_ms"].get<double>());
+            }
+        }
     }
 
-    // Stop Flow Before Going Out of Scope and Cleanup
-    flowMan.StopAutoTick();
+    if (!trace_arg.getValue().empty()) {
+        for (auto &flow : flows) {
+            flow.manager->StopTrace();
+            std::filesystem::path tracePath = trace_arg.getValue();
+            if (flows.size() > 1)
+                tracePath.replace_filename(tracePath.stem().string() + "_" + flow.name + tracePath.extension().string());
+            if (!flow.manager->SaveTrace(tracePath.string().c_str()))
+                LOG_ERROR("Failed to write trace to {}", tracePath.string());
+        }
+    }
 
     LOG_INFO("Flow Processing Stopped\nExiting");
 
-    return EXIT_SUCCESS;
+    return stalled || streamErrors || incomplete ? EXIT_FAILURE : EXIT_SUCCESS;
 }
@@ -0,0 +1,108 @@
+//
+// Subgraph Instances Must Survive Saving And Loading
+//
+
+#include <catch.hpp>
+#include "FlowCV_Manager.hpp"
+
+using namespace FlowCV;
+
+namespace
+{
+// Two thresholds wired one after the other, placed three times: the first and last instances change a node's params
+nlohmann::json MakeInstancedFlow()
+{
+    nlohmann::json subgraph;
+    for (uint64_t id : {1, 2}) {
+        nlohmann::json n;
+        n["id"] = id;
+        n["name"] = "Threshold";
+        n["params"]["thresh_amt"] = 100;
+        subgraph["nodes"].emplace_back(n);
+    }
+    nlohmann::json w;
+    w["from_id"] = 1;
+    w["from_idx"] = 0;
+    w["to_id"] = 2;
+    w["to_idx"] = 0;
+    subgraph["connections"].emplace_back(w);
+
+    nlohmann::json state;
+    state["nodes"] = nlohmann::json::array();
+    state["connections"] = nlohmann::json::array();
+    state["subgraphs"]["stream"] = subgraph;
+    for (uint64_t i = 0; i < 3; i++) {
+        nlohmann::json inst;
+        inst["subgraph"] = "stream";
+        inst["name"] = "stream " + std::to_string(i);
+        inst["ids"]["1"] = 2000 + i * 10 + 1;
+        inst["ids"]["2"] = 2000 + i * 10 + 2;
+        state["instances"].emplace_back(inst);
+    }
+    state["instances"][0]["nodes"]["1"]["params"]["thresh_amt"] = 50;
+    state["instances"][2]["nodes"]["2"]["params"]["thresh_amt"] = 200;
+
+    return state;
+}
+
+int ThreshAmt(const FlowCV_Manager &flowMan, uint64_t id)
+{
+    const NodeInfo *ni = flowMan.GetNodeInfoPtrById(id);
+    REQUIRE(ni != nullptr);
+    return FlowCV_Manager::GetNodeState(*ni->node_ptr)["thresh_amt"].get<int>();
+}
+
+void RequireInstancedFlow(FlowCV_Manager &flowMan)
+{
+    REQUIRE(flowMan.GetSubgraphInstanceCount() == 3);
+    REQUIRE(flowMan.GetNodeCount() == 6);
+
+    REQUIRE(ThreshAmt(flowMan, 2001) == 50);
+    REQUIRE(ThreshAmt(flowMan, 2002) == 100);
+    REQUIRE(ThreshAmt(flowMan, 2011) == 100);
+    REQUIRE(ThreshAmt(flowMan, 2012) == 100);
+    REQUIRE(ThreshAmt(flowMan, 2021) == 100);
+    REQUIRE(ThreshAmt(flowMan, 2022) == 200);
+
+    for (uint64_t i = 0; i < 3; i++) {
+        auto wires = flowMan.GetNodeConnectionsFromId(2000 + i * 10 + 1);
+        REQUIRE(wires.size() == 1);
+        REQUIRE(wires[0].to.id == 2000 + i * 10 + 2);
+    }
+}
+}  // namespace
+
+TEST_CASE("SubgraphInstanceRoundTripTest")
+{
+    nlohmann::json state = MakeInstancedFlow();
+    FlowCV_Manager flowMan;
+    REQUIRE(flowMan.SetState(state));
+    RequireInstancedFlow(flowMan);
+
+    nlohmann::json saved = flowMan.GetState();
+    REQUIRE(saved["instances"].size() == 3);
+    // Instance wires are saved once, with the definition
+    REQUIRE(saved["connections"].empty());
+    REQUIRE(saved["subgraphs"]["stream"]["connections"].size() == 1);
+
+    SECTION("Reloaded instances keep their own params and wires")
+    {
+        // The first instance is saved as the definition, so the others are saved as their differences to it
+        REQUIRE(saved["subgraphs"]["stream"]["nodes"][0]["params"]["thresh_amt"].get<int>() == 50);
+        REQUIRE(!saved["instances"][0].contains("nodes"));
+        REQUIRE(saved["instances"][1]["nodes"]["1"]["params"]["thresh_amt"].get<int>() == 100);
+
+        nlohmann::json reloadState = saved;
+        FlowCV_Manager reloaded;
+        REQUIRE(reloaded.SetState(reloadState));
+        RequireInstancedFlow(reloaded);
+    }
+
+    SECTION("Saving a reloaded flow saves the same flow")
+    {
+        nlohmann::json reloadState = saved;
+        FlowCV_Manager reloaded;
+        REQUIRE(reloaded.SetState(reloadState));
+        REQUIRE(reloaded.GetState() == saved);
+    }
+}
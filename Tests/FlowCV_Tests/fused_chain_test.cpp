@@ -0,0 +1,114 @@
+//
+// Fused Chains Must Output Exactly What Their Members Would
+//
+
+#include <catch.hpp>
+#include "test_components.hpp"
+#include "AbsDiff/abs_diff.hpp"
+#include "ColorReduce/color_reduce.hpp"
+#include "FusedChain/fused_chain.hpp"
+#include "ScaleAbs/scale_abs.hpp"
+#include "Threshold/threshold.hpp"
+#include <functional>
+
+using namespace DSPatch;
+using namespace DSPatch::DSPatchables;
+using namespace FlowCV::Tests;
+
+namespace
+{
+// AbsDiff -> ScaleAbs -> Threshold -> ColorReduce, each configured by setup() (member index, member)
+std::vector<std::shared_ptr<Component>> MakeMembers(const std::function<void(size_t, Component &)> &setup)
+{
+    std::vector<std::shared_ptr<Component>> members{std::make_shared<AbsDiff>(), std::make_shared<ScaleAbs>(), std::make_shared<Threshold>(),
+                                                    std::make_shared<ColorReduce>()};
+    for (size_t i = 0; i < members.size(); i++)
+        setup(i, *members[i]);
+    return members;
+}
+
+// Output of the members wired one after another, and of the same members fused into one chain
+std::pair<cv::Mat, cv::Mat> ProcessUnfusedAndFused(const cv::Mat &a, const cv::Mat &b, const std::function<void(size_t, Component &)> &setup)
+{
+    auto sourceA = std::make_shared<FrameSource>(a);
+    auto sourceB = std::make_shared<FrameSource>(b);
+
+    auto unfused = std::make_shared<Circuit>();
+    auto unfusedProbe = std::make_shared<FrameProbe>();
+    auto members = MakeMembers(setup);
+    unfused->AddComponent(sourceA);
+    unfused->AddComponent(sourceB);
+    for (const auto &member : members)
+        unfused->AddComponent(member);
+    unfused->AddComponent(unfusedProbe);
+    unfused->ConnectOutToIn(sourceA, 0, members[0], 0);
+    unfused->ConnectOutToIn(sourceB, 0, members[0], 1);
+    for (size_t i = 1; i < members.size(); i++)
+        unfused->ConnectOutToIn(members[i - 1], 0, members[i], 0);
+    unfused->ConnectOutToIn(members.back(), 0, unfusedProbe, 0);
+
+    auto fused = std::make_shared<Circuit>();
+    auto fusedProbe = std::make_shared<FrameProbe>();
+    auto chain = std::make_shared<FusedChain>(MakeMembers(setup), std::vector<int>{-1, 0, 0, 0});
+    fused->AddComponent(sourceA);
+    fused->AddComponent(sourceB);
+    fused->AddComponent(chain);
+    fused->AddComponent(fusedProbe);
+    fused->ConnectOutToIn(sourceA, 0, chain, chain->GetFusedInput(0, 0));
+    fused->ConnectOutToIn(sourceB, 0, chain, chain->GetFusedInput(0, 1));
+    fused->ConnectOutToIn(chain, 0, fusedProbe, 0);
+
+    for (int i = 0; i < 3; i++) {
+        unfused->Tick();
+        fused->Tick();
+    }
+
+    return {unfusedProbe->Frame(), fusedProbe->Frame()};
+}
+}  // namespace
+
+TEST_CASE("FusedChainEquivalenceTest")
+{
+    // Large enough to be processed in several stripes, with an odd row count to leave a short last stripe
+    auto a = RandomFrame(481, 640, CV_8UC3, 1);
+    auto b = RandomFrame(481, 640, CV_8UC3, 2);
+
+    SECTION("Default settings")
+    {
+        auto frames = ProcessUnfusedAndFused(a, b, [](size_t, Component &) {});
+        REQUIRE(!frames.first.empty());
+        REQUIRE(SameFrame(frames.first, frames.second));
+    }
+
+    SECTION("Scaled, with a color range threshold")
+    {
+        auto frames = ProcessUnfusedAndFused(a, b, [](size_t i, Component &member) {
+            if (i == 1)
+                member.SetState(R"({"alpha": 2.5, "beta": 10.0})");
+            else if (i == 2)
+                member.SetState(R"({"thresh_method": 1})");
+        });
+        REQUIRE(!frames.first.empty());
+        REQUIRE(SameFrame(frames.first, frames.second));
+    }
+
+    SECTION("A member that needs whole frames (Otsu threshold)")
+    {
+        auto frames = ProcessUnfusedAndFused(a, b, [](size_t i, Component &member) {
+            if (i == 2)
+                member.SetState(R"({"thresh_method": 3})");
+        });
+        REQUIRE(!frames.first.empty());
+        REQUIRE(SameFrame(frames.first, frames.second));
+    }
+
+    SECTION("A disabled member")
+    {
+        auto frames = ProcessUnfusedAndFused(a, b, [](size_t i, Component &member) {
+            if (i == 1)
+                member.SetEnabled(false);
+        });
+        REQUIRE(!frames.first.empty());
+        REQUIRE(SameFrame(frames.first, frames.second));
+    }
+}
@@ -0,0 +1,9 @@
+//
+// FlowCV Tests
+//
+
+#define CATCH_CONFIG_MAIN
+// Catch's signal handlers size their stack with SIGSTKSZ, which is no longer a constant on newer glibc
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
+
+#include <catch.hpp>
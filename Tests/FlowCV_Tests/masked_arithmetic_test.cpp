@@ -0,0 +1,44 @@
+//
+// Masks That Don't Fit The Frame Must Be Ignored
+//
+
+#include <catch.hpp>
+#include "test_components.hpp"
+#include "Subtract/subtract.hpp"
+
+using namespace DSPatch;
+using namespace DSPatch::DSPatchables;
+using namespace FlowCV::Tests;
+
+TEST_CASE("MismatchedMaskTest")
+{
+    // Large enough to be processed in several stripes, with a mask shorter than the frame
+    auto a = RandomFrame(481, 640, CV_8UC3, 1);
+    auto b = RandomFrame(481, 640, CV_8UC3, 2);
+    cv::Mat mask(240, 320, CV_8UC1, cv::Scalar(255));
+
+    auto sourceA = std::make_shared<FrameSource>(a);
+    auto sourceB = std::make_shared<FrameSource>(b);
+    auto sourceMask = std::make_shared<FrameSource>(mask);
+    auto subtract = std::make_shared<Subtract>();
+    auto probe = std::make_shared<FrameProbe>();
+
+    auto circuit = std::make_shared<Circuit>();
+    circuit->AddComponent(sourceA);
+    circuit->AddComponent(sourceB);
+    circuit->AddComponent(sourceMask);
+    circuit->AddComponent(subtract);
+    circuit->AddComponent(probe);
+    circuit->ConnectOutToIn(sourceA, 0, subtract, 0);
+    circuit->ConnectOutToIn(sourceB, 0, subtract, 1);
+    circuit->ConnectOutToIn(sourceMask, 0, subtract, 2);
+    circuit->ConnectOutToIn(subtract, 0, probe, 0);
+
+    for (int i = 0; i < 3; i++)
+        circuit->Tick();
+
+    // The frames are subtracted as if no mask were connected
+    cv::Mat expected;
+    cv::subtract(a, b, expected);
+    REQUIRE(SameFrame(probe->Frame(), expected));
+}
@@ -0,0 +1,107 @@
+//
+// Frames Sent Over a Shared Memory Ring Must Arrive Whole, or Not at All
+//
+
+#include <catch.hpp>
+#include "test_components.hpp"
+#include "shm_frame_ring.hpp"
+#include <unistd.h>
+
+using namespace FlowCV;
+using namespace FlowCV::Tests;
+
+namespace
+{
+// Unique per process, so that concurrent test runs don't share a ring
+std::string TestChannel(const std::string &name)
+{
+    return "test_" + name + "_" + std::to_string(getpid());
+}
+}  // namespace
+
+TEST_CASE("ShmFrameRingRoundTripTest")
+{
+    auto channel = TestChannel("round_trip");
+    auto sender = ShmFrameRing::Create(channel, 3, 1024 * 1024);
+    REQUIRE(sender != nullptr);
+    auto receiver = ShmFrameRing::Open(channel);
+    REQUIRE(receiver != nullptr);
+    REQUIRE(receiver->GetSlotCount() == 3);
+
+    std::vector<cv::Mat> sent;
+    for (int i = 0; i < 3; i++) {
+        sent.emplace_back(RandomFrame(120, 160, CV_8UC3, i));
+        REQUIRE(sender->Write(sent.back()) == ShmFrameRing::WriteResult::Written);
+    }
+
+    // Every slot is unread
+    REQUIRE(sender->Write(sent.front()) == ShmFrameRing::WriteResult::RingFull);
+    REQUIRE(sender->Write(cv::Mat(1024, 1024, CV_8UC3)) == ShmFrameRing::WriteResult::TooLarge);
+
+    for (const auto &frame : sent) {
+        cv::Mat received;
+        REQUIRE(receiver->Read(received, false) == ShmFrameRing::ReadResult::Read);
+        REQUIRE(SameFrame(received, frame));
+    }
+    cv::Mat received;
+    REQUIRE(receiver->Read(received, false) == ShmFrameRing::ReadResult::NoFrame);
+
+    SECTION("Latest Only")
+    {
+        for (int i = 3; i < 6; i++) {
+            sent.emplace_back(RandomFrame(120, 160, CV_8UC3, i));
+            REQUIRE(sender->Write(sent.back()) == ShmFrameRing::WriteResult::Written);
+        }
+        REQUIRE(receiver->Read(received, true) == ShmFrameRing::ReadResult::Read);
+        REQUIRE(SameFrame(received, sent.back()));
+        REQUIRE(receiver->Read(received, true) == ShmFrameRing::ReadResult::NoFrame);
+    }
+
+    SECTION("Sender Destroyed")
+    {
+        // The channel is unlinked, and the receiver is told to reopen it
+        sender.reset();
+        REQUIRE(receiver->IsStale());
+        REQUIRE(ShmFrameRing::Open(channel) == nullptr);
+    }
+
+    SECTION("Geometry Changed")
+    {
+        sender.reset();
+        sender = ShmFrameRing::Create(channel, 4, 1024 * 1024);
+        REQUIRE(sender != nullptr);
+        REQUIRE(receiver->IsStale());
+        receiver = ShmFrameRing::Open(channel);
+        REQUIRE(receiver != nullptr);
+        REQUIRE(receiver->GetSlotCount() == 4);
+    }
+}
+
+TEST_CASE("ShmFrameRingTornFrameTest")
+{
+    // A receiver that takes over a channel gives every slot back to the sender, including those a previous receiver
+    // has yet to copy out. Should the sender write over one of those, the previous receiver must drop it.
+    auto channel = TestChannel("torn");
+    auto sender = ShmFrameRing::Create(channel, 2, 1024 * 1024);
+    REQUIRE(sender != nullptr);
+    auto oldReceiver = ShmFrameRing::Open(channel);
+    REQUIRE(oldReceiver != nullptr);
+
+    auto first = RandomFrame(64, 64, CV_8UC1, 1);
+    REQUIRE(sender->Write(first) == ShmFrameRing::WriteResult::Written);
+    REQUIRE(sender->Write(first) == ShmFrameRing::WriteResult::Written);
+    REQUIRE(sender->Write(first) == ShmFrameRing::WriteResult::RingFull);
+
+    auto newReceiver = ShmFrameRing::Open(channel);
+    REQUIRE(newReceiver != nullptr);
+
+    auto second = RandomFrame(64, 64, CV_8UC1, 2);
+    REQUIRE(sender->Write(second) == ShmFrameRing::WriteResult::Written);
+
+    cv::Mat received;
+    REQUIRE(oldReceiver->Read(received, false) == ShmFrameRing::ReadResult::Torn);
+    REQUIRE(received.empty());
+
+    REQUIRE(newReceiver->Read(received, false) == ShmFrameRing::ReadResult::Read);
+    REQUIRE(SameFrame(received, second));
+}
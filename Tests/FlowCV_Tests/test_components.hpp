@@ -0,0 +1,101 @@
+//
+// Components For Feeding And Probing Nodes Under Test
+//
+
+#ifndef FLOWCV_TEST_COMPONENTS_HPP_
+#define FLOWCV_TEST_COMPONENTS_HPP_
+#include <DSPatch.h>
+#include <opencv2/opencv.hpp>
+#include <mutex>
+
+namespace FlowCV::Tests
+{
+
+// Components under test carry the node editor's GUI and state hooks, these need neither
+class TestComponent : public DSPatch::Component
+{
+  public:
+    explicit TestComponent(ProcessOrder processOrder = ProcessOrder::OutOfOrder) : Component(processOrder)
+    {
+    }
+    bool HasGui(int interface) override
+    {
+        return false;
+    }
+    void UpdateGui(void *context, int interface) override
+    {
+    }
+    std::string GetState() override
+    {
+        return {};
+    }
+    void SetState(std::string &&json_serialized) override
+    {
+    }
+};
+
+// Outputs the same frame every tick
+class FrameSource final : public TestComponent
+{
+  public:
+    explicit FrameSource(cv::Mat frame) : frame_(std::move(frame))
+    {
+        SetOutputCount_(1, {"out"}, {DSPatch::IoType::Io_Type_CvMat});
+    }
+
+  protected:
+    void Process_(DSPatch::SignalBus const &inputs, DSPatch::SignalBus &outputs) override
+    {
+        outputs.SetValue(0, frame_);
+    }
+
+  private:
+    cv::Mat frame_;
+};
+
+// Keeps the last frame input
+class FrameProbe final : public TestComponent
+{
+  public:
+    FrameProbe()
+    {
+        SetInputCount_(1, {"in"}, {DSPatch::IoType::Io_Type_CvMat});
+    }
+
+    cv::Mat Frame()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frame_;
+    }
+
+  protected:
+    void Process_(DSPatch::SignalBus const &inputs, DSPatch::SignalBus &outputs) override
+    {
+        auto in = inputs.GetValue<cv::Mat>(0);
+        std::lock_guard<std::mutex> lock(mutex_);
+        frame_ = in ? in->clone() : cv::Mat();
+    }
+
+  private:
+    std::mutex mutex_;
+    cv::Mat frame_;
+};
+
+// Random, but the same every run
+inline cv::Mat RandomFrame(int rows, int cols, int type, uint64_t seed)
+{
+    cv::Mat frame(rows, cols, type);
+    cv::RNG rng(seed);
+    rng.fill(frame, cv::RNG::UNIFORM, 0, 256);
+    return frame;
+}
+
+// True if both frames have the same size, type and pixels
+inline bool SameFrame(const cv::Mat &a, const cv::Mat &b)
+{
+    return a.size() == b.size() && a.type() == b.type() && (a.empty() || cv::norm(a, b, cv::NORM_INF) == 0);
+}
+
+}  // namespace FlowCV::Tests
+
+#endif  // FLOWCV_TEST_COMPONENTS_HPP_